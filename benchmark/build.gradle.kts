@@ -4,6 +4,8 @@ plugins {
     alias(libs.plugins.kotlinMultiplatform)
     alias(libs.plugins.kotlinBenchmark)
     alias(libs.plugins.kotlinAllOpen)
+    alias(libs.plugins.serialization)
+    alias(libs.plugins.ksp)
 }
 
 kotlin {
@@ -20,6 +22,14 @@ kotlin {
                 implementation(libs.kotlinx.benchmark.runtime)
             }
         }
+        jvmMain {
+            dependencies {
+                implementation(projects.quickjsConverterMoshi)
+                implementation(projects.quickjsConverterKtxserialization)
+                implementation(libs.moshi)
+                implementation(libs.kotlinx.serialization.properties)
+            }
+        }
     }
 }
 
@@ -29,6 +39,30 @@ benchmark {
         register("mingwX64")
         register("linuxX64")
     }
+
+    configurations {
+        // Run by 'scripts/checkAllocationBaseline.ts'
+        register("allocations") {
+            include("AllocationBenchmark")
+        }
+        // Engine workloads only, e.g. 'jvmEngineBenchmark'
+        register("engine") {
+            include("EngineWorkloadBenchmark")
+        }
+        // Data class converters, e.g. 'jvmConvertersBenchmark'
+        register("converters") {
+            include("ConverterBenchmark")
+        }
+        // Tail latency under GC policies, e.g. 'jvmGcLatencyBenchmark'
+        register("gcLatency") {
+            include("GcLatencyBenchmark")
+        }
+    }
+}
+
+dependencies {
+    // Moshi adapters of the converter benchmark models
+    add("kspJvm", libs.moshi.kotlin.codegen)
 }
 
 allOpen {
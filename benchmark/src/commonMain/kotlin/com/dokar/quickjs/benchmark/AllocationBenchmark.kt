@@ -0,0 +1,74 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.define
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Memory allocated per operation. When a benchmark finishes, a line like
+ * 'ALLOCATION benchmark=evaluate heapBytesPerOp=1024 mallocBytesPerOp=2048' is printed, and
+ * 'scripts/checkAllocationBaseline.ts' compares them with 'allocation-baseline.json'.
+ *
+ * Heap bytes are allocated by the JVM, they are -1 on Kotlin/Native. Malloc bytes are allocated
+ * by the JS runtime, counted by the accounting allocator of the evaluation.
+ */
+@OptIn(ExperimentalQuickJsApi::class)
+@Suppress("unused")
+@State(Scope.Benchmark)
+class AllocationBenchmark {
+    private lateinit var quickJs: QuickJs
+
+    private val counters = linkedMapOf<String, AllocationCounter>()
+
+    private val payload = List(100) { mapOf("id" to it, "name" to "item$it") }
+
+    @Setup
+    fun setup() {
+        quickJs = QuickJs.create(Dispatchers.Default, enableMemoryAccounting = true)
+        quickJs.define("host") {
+            property("payload") { getter { payload } }
+            function("add") { it[0] as Long + it[1] as Long }
+            asyncFunction("addAsync") { it[0] as Long + it[1] as Long }
+        }
+        counters.clear()
+    }
+
+    @TearDown
+    fun cleanup() {
+        for ((name, counter) in counters) {
+            println(
+                "ALLOCATION benchmark=$name " +
+                        "heapBytesPerOp=${counter.heapBytesPerOp()} " +
+                        "mallocBytesPerOp=${counter.mallocBytesPerOp()}"
+            )
+        }
+        quickJs.close()
+    }
+
+    @Benchmark
+    fun evaluate() = track("evaluate") { "1 + 1" }
+
+    @Benchmark
+    fun invokeBinding() = track("invokeBinding") { "host.add(1, 2)" }
+
+    @Benchmark
+    fun invokeAsyncBinding() = track("invokeAsyncBinding") { "await host.addAsync(1, 2)" }
+
+    @Benchmark
+    fun convertValues() = track("convertValues") { "host.payload" }
+
+    private inline fun track(name: String, code: () -> String) = runBlocking {
+        val counter = counters.getOrPut(name) { AllocationCounter() }
+        var mallocBytes = 0L
+        counter.track(mallocBytes = { mallocBytes }) {
+            mallocBytes = quickJs.evaluateWithMemoryStats<Any?>(code()).memoryStats.allocatedBytes
+        }
+    }
+}
@@ -0,0 +1,87 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.define
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Throughput of the async path: launching async binding calls, settling their promises and
+ * draining pending jobs. Each operation runs [count] calls or promise reactions, the p99
+ * latency of operations, including warmup iterations, is printed when a benchmark finishes.
+ */
+@Suppress("unused")
+@State(Scope.Benchmark)
+class AsyncBenchmark {
+    @Param("1", "100", "10000")
+    var count: Int = 0
+
+    private lateinit var quickJs: QuickJs
+
+    private val latencies = LatencyRecorder()
+
+    @Setup
+    fun setup() {
+        quickJs = QuickJs.create(Dispatchers.Default)
+        quickJs.define("host") {
+            asyncFunction("echo") { it.firstOrNull() }
+        }
+        latencies.clear()
+    }
+
+    @TearDown
+    fun cleanup() {
+        println(latencies.summary("count=$count"))
+        quickJs.close()
+    }
+
+    /**
+     * Await async binding calls one by one.
+     */
+    @Benchmark
+    fun sequentialAsyncCalls() = run(
+        """
+            for (let i = 0; i < $count; i++) {
+                await host.echo(i);
+            }
+        """.trimIndent()
+    )
+
+    /**
+     * Await concurrent async binding calls with 'Promise.all()'.
+     */
+    @Benchmark
+    fun concurrentAsyncCalls() = run(
+        """
+            const calls = [];
+            for (let i = 0; i < $count; i++) {
+                calls.push(host.echo(i));
+            }
+            await Promise.all(calls);
+        """.trimIndent()
+    )
+
+    /**
+     * A promise chain that only runs microtasks, no host calls are involved.
+     */
+    @Benchmark
+    fun microtaskChain() = run(
+        """
+            let promise = Promise.resolve(0);
+            for (let i = 0; i < $count; i++) {
+                promise = promise.then((value) => value + 1);
+            }
+            await promise;
+        """.trimIndent()
+    )
+
+    private fun run(code: String) = runBlocking {
+        latencies.measure { quickJs.evaluate<Any?>(code) }
+    }
+}
@@ -0,0 +1,46 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.benchmark.workload.Workload
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Compute-heavy JS workloads, to compare engine upgrades and build flags. Workloads are
+ * precompiled to bytecode, so the score only covers the execution.
+ */
+@Suppress("unused")
+@State(Scope.Benchmark)
+class EngineWorkloadBenchmark {
+    @Param("Richards", "DeltaBlue", "RayTrace", "NavierStokes", "Splay", "Json", "RegExp")
+    var workload: String = ""
+
+    private lateinit var quickJs: QuickJs
+
+    private lateinit var bytecode: ByteArray
+
+    @Setup
+    fun setup() {
+        val workload = Workload.valueOf(workload)
+        quickJs = QuickJs.create(Dispatchers.Default)
+        bytecode = quickJs.compile(workload.source, filename = "${workload.name}.js")
+        // Workloads throw if the results are wrong
+        runBlocking { quickJs.evaluate<Any?>(bytecode) }
+    }
+
+    @TearDown
+    fun cleanup() {
+        quickJs.close()
+    }
+
+    @Benchmark
+    fun run() = runBlocking {
+        quickJs.evaluate<Any?>(bytecode)
+    }
+}
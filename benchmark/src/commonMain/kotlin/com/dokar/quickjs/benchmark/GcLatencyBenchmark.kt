@@ -0,0 +1,126 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.runBlocking
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.nanoseconds
+import kotlin.time.TimeSource
+
+/**
+ * Tail latency of requests sent at a steady rate, each request allocates cyclic garbage that
+ * only the cycle collector can free. Latencies are measured from the scheduled start, so a
+ * request delayed by the GC of a previous one is counted. The latency percentiles and GC stats
+ * are printed when a benchmark finishes.
+ *
+ * GC policies:
+ * - 'threshold': only the automatic GCs triggered by the allocation threshold.
+ * - 'explicit': run [QuickJs.gc] after every [EXPLICIT_GC_INTERVAL] requests.
+ * - 'idle': run [QuickJs.gc] after a request if the next one is at least [IDLE_GC_BUDGET] away.
+ */
+@OptIn(ExperimentalQuickJsApi::class)
+@Suppress("unused")
+@State(Scope.Benchmark)
+class GcLatencyBenchmark {
+    @Param("threshold", "explicit", "idle")
+    var gcPolicy: String = ""
+
+    @Param("500", "2000")
+    var requestsPerSecond: Int = 0
+
+    private lateinit var quickJs: QuickJs
+
+    private val latencies = LatencyRecorder()
+
+    @Setup
+    fun setup() {
+        quickJs = QuickJs.create(Dispatchers.Default)
+        runBlocking {
+            quickJs.evaluate<Any?>(
+                """
+                    globalThis.handleRequest = function (size) {
+                        const nodes = [];
+                        for (let i = 0; i < size; i++) {
+                            const node = { id: i, name: 'node' + i, peers: [] };
+                            // Self and mutual references, not freed by ref counting
+                            node.self = node;
+                            if (i > 0) {
+                                node.peers.push(nodes[i - 1]);
+                                nodes[i - 1].peers.push(node);
+                            }
+                            nodes.push(node);
+                        }
+                        return nodes.length;
+                    };
+                """.trimIndent()
+            )
+        }
+        latencies.clear()
+    }
+
+    @TearDown
+    fun cleanup() {
+        println(latencies.summary("gcPolicy=$gcPolicy requestsPerSecond=$requestsPerSecond"))
+        val gcStats = quickJs.gcStats
+        println(
+            "GC: explicit=${gcStats.explicitCount}, threshold=${gcStats.thresholdCount}, " +
+                    "p99 pause=${gcStats.pauses.valueAtPercentile(99.0) / 1000}us, " +
+                    "max pause=${gcStats.pauses.maxNanos / 1000}us"
+        )
+        quickJs.close()
+    }
+
+    /**
+     * Send [REQUESTS_PER_OP] requests at the [requestsPerSecond] rate.
+     */
+    @Benchmark
+    fun steadyLoad() = runBlocking {
+        val intervalNanos = 1_000_000_000L / requestsPerSecond
+        val start = TimeSource.Monotonic.markNow()
+        for (i in 0 until REQUESTS_PER_OP) {
+            val scheduled = start + (intervalNanos * i).nanoseconds
+            waitUntil(scheduled)
+            quickJs.evaluate<Any?>("handleRequest($GARBAGE_NODES)")
+            latencies.record(scheduled.elapsedNow().inWholeNanoseconds)
+            when (gcPolicy) {
+                "explicit" -> if ((i + 1) % EXPLICIT_GC_INTERVAL == 0) {
+                    quickJs.gc()
+                }
+
+                "idle" -> {
+                    val next = start + (intervalNanos * (i + 1)).nanoseconds
+                    if (-next.elapsedNow() >= IDLE_GC_BUDGET) {
+                        quickJs.gc()
+                    }
+                }
+            }
+        }
+    }
+
+    private suspend fun waitUntil(mark: TimeSource.Monotonic.ValueTimeMark) {
+        val remaining = -mark.elapsedNow()
+        // Sleep for the most part and spin for the rest, delays are not precise enough
+        if (remaining > SPIN_THRESHOLD) {
+            delay(remaining - SPIN_THRESHOLD)
+        }
+        while (mark.hasNotPassedNow()) {
+            // Spin
+        }
+    }
+
+    private companion object {
+        const val REQUESTS_PER_OP = 200
+        const val GARBAGE_NODES = 200
+        const val EXPLICIT_GC_INTERVAL = 50
+        val IDLE_GC_BUDGET = 1.milliseconds
+        val SPIN_THRESHOLD = 2.milliseconds
+    }
+}
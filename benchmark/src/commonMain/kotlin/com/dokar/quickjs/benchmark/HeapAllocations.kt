@@ -0,0 +1,38 @@
+package com.dokar.quickjs.benchmark
+
+/**
+ * Bytes allocated on the managed heap by all live threads so far, or -1 if the platform can't
+ * count them.
+ */
+expect fun allocatedHeapBytes(): Long
+
+/**
+ * Sum allocations of tracked operations, to report bytes per operation.
+ */
+internal class AllocationCounter {
+    var ops = 0L
+    var heapBytes = 0L
+    var mallocBytes = 0L
+
+    /**
+     * Track one operation, [mallocBytes] are read from the runtime after running [block].
+     */
+    inline fun <T> track(mallocBytes: () -> Long, block: () -> T): T {
+        val heapBefore = allocatedHeapBytes()
+        val result = block()
+        val heapAfter = allocatedHeapBytes()
+        ops++
+        if (heapBefore >= 0) {
+            heapBytes += heapAfter - heapBefore
+        }
+        this.mallocBytes += mallocBytes()
+        return result
+    }
+
+    fun heapBytesPerOp(): Long {
+        if (allocatedHeapBytes() < 0) return -1
+        return if (ops == 0L) 0 else heapBytes / ops
+    }
+
+    fun mallocBytesPerOp(): Long = if (ops == 0L) 0 else mallocBytes / ops
+}
@@ -0,0 +1,51 @@
+package com.dokar.quickjs.benchmark
+
+import kotlin.time.TimeSource
+
+/**
+ * Record latencies of benchmark operations, to report percentiles that are not available in
+ * the throughput mode.
+ */
+class LatencyRecorder {
+    private var samples = LongArray(1024)
+    private var count = 0
+
+    inline fun <T> measure(block: () -> T): T {
+        val mark = TimeSource.Monotonic.markNow()
+        val result = block()
+        record(mark.elapsedNow().inWholeNanoseconds)
+        return result
+    }
+
+    fun record(nanos: Long) {
+        if (count == samples.size) {
+            samples = samples.copyOf(samples.size * 2)
+        }
+        samples[count++] = nanos
+    }
+
+    /**
+     * Get the latency percentile in nanoseconds, [percentile] is in the range of 0 to 100.
+     */
+    fun percentile(percentile: Double): Long {
+        if (count == 0) return 0
+        val sorted = samples.copyOf(count).apply { sort() }
+        val index = ((percentile / 100) * (count - 1)).toInt().coerceIn(0, count - 1)
+        return sorted[index]
+    }
+
+    fun clear() {
+        count = 0
+    }
+
+    /**
+     * Format the p50, p99, p99.9 and max latencies in microseconds.
+     */
+    fun summary(name: String): String {
+        return "$name: $count ops, " +
+                "p50=${percentile(50.0) / 1000}us, " +
+                "p99=${percentile(99.0) / 1000}us, " +
+                "p99.9=${percentile(99.9) / 1000}us, " +
+                "max=${percentile(100.0) / 1000}us"
+    }
+}
@@ -0,0 +1,154 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.JsObject
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.binding.toJsObject
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Value conversions between JS and Kotlin in both directions.
+ *
+ * 'toJs*' benchmarks read a Kotlin value from a binding getter, so the value is converted to JS,
+ * 'fromJs*' benchmarks return a prebuilt JS value from evaluations, so the value is converted to
+ * Kotlin. The evaluated code is tiny, most of the time is spent on conversions.
+ */
+@Suppress("unused")
+@OptIn(ExperimentalUnsignedTypes::class)
+@State(Scope.Benchmark)
+class MarshallingBenchmark {
+    @Param("1", "1000", "1000000")
+    var size: Int = 0
+
+    private lateinit var quickJs: QuickJs
+
+    private lateinit var list: List<Int>
+    private lateinit var objects: List<JsObject>
+    private lateinit var map: Map<String, Int>
+    private lateinit var set: Set<Int>
+    private lateinit var asciiString: String
+    private lateinit var nonBmpString: String
+    private lateinit var bytes: ByteArray
+    private lateinit var ubytes: UByteArray
+
+    @Setup
+    fun setup() {
+        list = List(size) { it }
+        objects = List(size) {
+            mapOf(
+                "id" to it,
+                "name" to "item$it",
+                "child" to mapOf("value" to it).toJsObject(),
+            ).toJsObject()
+        }
+        map = (0 until size).associateBy { "key$it" }
+        set = (0 until size).toSet()
+        asciiString = "a".repeat(size)
+        // Each code point is a surrogate pair
+        nonBmpString = "😀".repeat(size)
+        bytes = ByteArray(size) { it.toByte() }
+        ubytes = UByteArray(size) { it.toUByte() }
+
+        quickJs = QuickJs.create(Dispatchers.Default)
+        quickJs.define("host") {
+            property("list") { getter { list } }
+            property("objects") { getter { objects } }
+            property("map") { getter { map } }
+            property("set") { getter { set } }
+            property("asciiString") { getter { asciiString } }
+            property("nonBmpString") { getter { nonBmpString } }
+            property("bytes") { getter { bytes } }
+            property("ubytes") { getter { ubytes } }
+        }
+        runBlocking {
+            quickJs.evaluate<Any?>(
+                """
+                    const n = $size;
+                    globalThis.data = {
+                        list: Array.from({ length: n }, (_, i) => i),
+                        objects: Array.from({ length: n }, (_, i) => ({
+                            id: i,
+                            name: "item" + i,
+                            child: { value: i },
+                        })),
+                        map: new Map(Array.from({ length: n }, (_, i) => ["key" + i, i])),
+                        set: new Set(Array.from({ length: n }, (_, i) => i)),
+                        asciiString: "a".repeat(n),
+                        nonBmpString: "\u{1F600}".repeat(n),
+                        bytes: new Int8Array(n),
+                        ubytes: new Uint8Array(n),
+                    };
+                """.trimIndent()
+            )
+        }
+    }
+
+    @TearDown
+    fun cleanup() {
+        quickJs.close()
+    }
+
+    @Benchmark
+    fun toJsList() = toJs("list")
+
+    @Benchmark
+    fun fromJsList() = fromJs("list")
+
+    @Benchmark
+    fun toJsNestedObjects() = toJs("objects")
+
+    @Benchmark
+    fun fromJsNestedObjects() = fromJs("objects")
+
+    @Benchmark
+    fun toJsMap() = toJs("map")
+
+    @Benchmark
+    fun fromJsMap() = fromJs("map")
+
+    @Benchmark
+    fun toJsSet() = toJs("set")
+
+    @Benchmark
+    fun fromJsSet() = fromJs("set")
+
+    @Benchmark
+    fun toJsAsciiString() = toJs("asciiString")
+
+    @Benchmark
+    fun fromJsAsciiString() = fromJs("asciiString")
+
+    @Benchmark
+    fun toJsNonBmpString() = toJs("nonBmpString")
+
+    @Benchmark
+    fun fromJsNonBmpString() = fromJs("nonBmpString")
+
+    @Benchmark
+    fun toJsByteArray() = toJs("bytes")
+
+    @Benchmark
+    fun fromJsByteArray() = fromJs("bytes")
+
+    @Benchmark
+    fun toJsUByteArray() = toJs("ubytes")
+
+    @Benchmark
+    fun fromJsUByteArray() = fromJs("ubytes")
+
+    private fun toJs(name: String) = runBlocking {
+        // Return a short string to skip converting the value back
+        quickJs.evaluate<Any?>("typeof host.$name")
+    }
+
+    private fun fromJs(name: String) = runBlocking {
+        quickJs.evaluate<Any?>("data.$name")
+    }
+}
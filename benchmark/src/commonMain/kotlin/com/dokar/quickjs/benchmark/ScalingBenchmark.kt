@@ -0,0 +1,99 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.define
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.CloseableCoroutineDispatcher
+import kotlinx.coroutines.DelicateCoroutinesApi
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.newFixedThreadPoolContext
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Throughput of [threads] threads evaluating code at the same time. Each operation runs
+ * [EVALUATIONS_PER_THREAD] evaluations on every thread, so with no contention the score stays
+ * the same as threads increase, the scaling efficiency is the score divided by the score of
+ * 1 thread.
+ *
+ * The workload calls a binding and converts values, so contention on the process wide state of
+ * the bridges, e.g. the JNI class cache and the allocator, shows up in the efficiency.
+ */
+@Suppress("unused")
+@OptIn(DelicateCoroutinesApi::class, ExperimentalCoroutinesApi::class)
+@State(Scope.Benchmark)
+class ScalingBenchmark {
+    @Param("1", "2", "4", "8")
+    var threads: Int = 0
+
+    private lateinit var dispatcher: CloseableCoroutineDispatcher
+
+    private lateinit var instances: List<QuickJs>
+
+    private lateinit var sharedInstance: QuickJs
+
+    @Setup
+    fun setup() {
+        dispatcher = newFixedThreadPoolContext(threads, "ScalingBenchmark")
+        instances = List(threads) { createInstance() }
+        sharedInstance = createInstance()
+    }
+
+    @TearDown
+    fun cleanup() {
+        instances.forEach { it.close() }
+        sharedInstance.close()
+        dispatcher.close()
+    }
+
+    /**
+     * Every thread drives its own instance.
+     */
+    @Benchmark
+    fun instancePerThread() = runBlocking {
+        for (quickJs in instances) {
+            launch(dispatcher) { runWorkload(quickJs) }
+        }
+    }
+
+    /**
+     * All threads share one instance, evaluations are serialized by the instance.
+     */
+    @Benchmark
+    fun sharedInstance() = runBlocking {
+        repeat(threads) {
+            launch(dispatcher) { runWorkload(sharedInstance) }
+        }
+    }
+
+    private fun createInstance(): QuickJs {
+        val quickJs = QuickJs.create(dispatcher)
+        quickJs.define("host") {
+            function("tags") { args -> listOf(args[0], "tag") }
+        }
+        return quickJs
+    }
+
+    private suspend fun runWorkload(quickJs: QuickJs) {
+        repeat(EVALUATIONS_PER_THREAD) {
+            quickJs.evaluate<Any?>(
+                """
+                    const items = [];
+                    for (let i = 0; i < 20; i++) {
+                        items.push({ id: i, tags: host.tags("item" + i) });
+                    }
+                    items.map((item) => item.tags.length).reduce((a, b) => a + b, 0);
+                """.trimIndent()
+            )
+        }
+    }
+
+    private companion object {
+        const val EVALUATIONS_PER_THREAD = 20
+    }
+}
@@ -0,0 +1,144 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.define
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Cold start of instances, split into steps. Every operation creates and closes an instance,
+ * the latency of each step, including warmup iterations, and the memory per instance are
+ * printed when a benchmark finishes.
+ */
+@Suppress("unused")
+@OptIn(ExperimentalQuickJsApi::class)
+@State(Scope.Benchmark)
+class StartupBenchmark {
+    @Param("10", "100")
+    var bindingCount: Int = 0
+
+    private lateinit var preludeSource: String
+    private lateinit var preludeBytecode: ByteArray
+
+    private val steps = linkedMapOf<String, LatencyRecorder>()
+
+    private var libraryLoadNanos = 0L
+
+    @Setup
+    fun setup() {
+        preludeSource = (0 until bindingCount).joinToString("\n") {
+            "function helper$it(value) { return { index: $it, value: value }; }"
+        }
+        val quickJs = QuickJs.create(Dispatchers.Default)
+        try {
+            preludeBytecode = quickJs.compile(preludeSource, filename = "prelude.js")
+            libraryLoadNanos = quickJs.creationTimings.libraryLoadNanos
+        } finally {
+            quickJs.close()
+        }
+        steps.clear()
+    }
+
+    @TearDown
+    fun cleanup() {
+        println("Library load: ${libraryLoadNanos / 1000}us")
+        for ((name, recorder) in steps) {
+            println(recorder.summary(name))
+        }
+        printMemoryPerInstance()
+    }
+
+    /**
+     * Create and close an empty instance.
+     */
+    @Benchmark
+    fun createAndClose() {
+        val quickJs = create()
+        step("close") { quickJs.close() }
+    }
+
+    /**
+     * Define an object with [bindingCount] functions on a new instance.
+     */
+    @Benchmark
+    fun defineBindings() {
+        val quickJs = create()
+        step("define") { quickJs.defineFunctions() }
+        step("close") { quickJs.close() }
+    }
+
+    /**
+     * The first evaluation of a new instance.
+     */
+    @Benchmark
+    fun firstEvaluate() = runBlocking {
+        val quickJs = create()
+        step("firstEvaluate") { quickJs.evaluate<Any?>("1 + 1") }
+        step("close") { quickJs.close() }
+    }
+
+    /**
+     * Load a prelude of [bindingCount] functions from the source.
+     */
+    @Benchmark
+    fun sourcePrelude() = runBlocking {
+        val quickJs = create()
+        step("sourcePrelude") { quickJs.evaluate<Any?>(preludeSource, filename = "prelude.js") }
+        step("close") { quickJs.close() }
+    }
+
+    /**
+     * Load a prelude of [bindingCount] functions from the bytecode.
+     */
+    @Benchmark
+    fun bytecodePrelude() = runBlocking {
+        val quickJs = create()
+        step("bytecodePrelude") { quickJs.evaluate<Any?>(preludeBytecode) }
+        step("close") { quickJs.close() }
+    }
+
+    private fun create(): QuickJs {
+        val quickJs = step("create") { QuickJs.create(Dispatchers.Default) }
+        val timings = quickJs.creationTimings
+        recorder("create.runtime").record(timings.runtimeNanos)
+        recorder("create.context").record(timings.contextNanos)
+        recorder("create.globals").record(timings.globalsNanos)
+        return quickJs
+    }
+
+    private fun QuickJs.defineFunctions() {
+        define("host") {
+            for (i in 0 until bindingCount) {
+                function("fn$i") { i }
+            }
+        }
+    }
+
+    private fun printMemoryPerInstance() {
+        val quickJs = QuickJs.create(Dispatchers.Default)
+        try {
+            val empty = quickJs.memoryUsage.mallocSize
+            quickJs.defineFunctions()
+            val defined = quickJs.memoryUsage.mallocSize
+            runBlocking { quickJs.evaluate<Any?>(preludeBytecode) }
+            val loaded = quickJs.memoryUsage.mallocSize
+            println(
+                "Memory per instance: empty=${empty}B, " +
+                        "bindings=${defined - empty}B, prelude=${loaded - defined}B"
+            )
+        } finally {
+            quickJs.close()
+        }
+    }
+
+    private fun recorder(name: String) = steps.getOrPut(name) { LatencyRecorder() }
+
+    private inline fun <T> step(name: String, block: () -> T): T = recorder(name).measure(block)
+}
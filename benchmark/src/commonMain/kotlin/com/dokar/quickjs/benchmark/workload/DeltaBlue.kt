@@ -0,0 +1,468 @@
+package com.dokar.quickjs.benchmark.workload
+
+internal const val DELTA_BLUE = """
+// An incremental one-way constraint solver, based on the DeltaBlue benchmark.
+(function () {
+    function Strength(strengthValue, name) {
+        this.strengthValue = strengthValue;
+        this.name = name;
+    }
+
+    Strength.stronger = function (s1, s2) {
+        return s1.strengthValue < s2.strengthValue;
+    };
+
+    Strength.weaker = function (s1, s2) {
+        return s1.strengthValue > s2.strengthValue;
+    };
+
+    Strength.weakestOf = function (s1, s2) {
+        return Strength.weaker(s1, s2) ? s1 : s2;
+    };
+
+    Strength.prototype.nextWeaker = function () {
+        switch (this.strengthValue) {
+            case 0: return Strength.WEAKEST;
+            case 1: return Strength.WEAK_DEFAULT;
+            case 2: return Strength.NORMAL;
+            case 3: return Strength.STRONG_DEFAULT;
+            case 4: return Strength.PREFERRED;
+            case 5: return Strength.REQUIRED;
+        }
+    };
+
+    Strength.REQUIRED = new Strength(0, "required");
+    Strength.STRONG_PREFERRED = new Strength(1, "strongPreferred");
+    Strength.PREFERRED = new Strength(2, "preferred");
+    Strength.STRONG_DEFAULT = new Strength(3, "strongDefault");
+    Strength.NORMAL = new Strength(4, "normal");
+    Strength.WEAK_DEFAULT = new Strength(5, "weakDefault");
+    Strength.WEAKEST = new Strength(6, "weakest");
+
+    var planner = null;
+
+    function Constraint(strength) {
+        this.strength = strength;
+    }
+
+    Constraint.prototype.addConstraint = function () {
+        this.addToGraph();
+        planner.incrementalAdd(this);
+    };
+
+    Constraint.prototype.satisfy = function (mark) {
+        this.chooseMethod(mark);
+        if (!this.isSatisfied()) {
+            if (this.strength == Strength.REQUIRED) {
+                throw new Error("DeltaBlue: could not satisfy a required constraint");
+            }
+            return null;
+        }
+        this.markInputs(mark);
+        var out = this.output();
+        var overridden = out.determinedBy;
+        if (overridden != null) overridden.markUnsatisfied();
+        out.determinedBy = this;
+        if (!planner.addPropagate(this, mark)) {
+            throw new Error("DeltaBlue: cycle encountered");
+        }
+        out.mark = mark;
+        return overridden;
+    };
+
+    Constraint.prototype.destroyConstraint = function () {
+        if (this.isSatisfied()) {
+            planner.incrementalRemove(this);
+        } else {
+            this.removeFromGraph();
+        }
+    };
+
+    Constraint.prototype.isInput = function () {
+        return false;
+    };
+
+    function UnaryConstraint(v, strength) {
+        Constraint.call(this, strength);
+        this.myOutput = v;
+        this.satisfied = false;
+        this.addConstraint();
+    }
+
+    UnaryConstraint.prototype = Object.create(Constraint.prototype);
+
+    UnaryConstraint.prototype.addToGraph = function () {
+        this.myOutput.addConstraint(this);
+        this.satisfied = false;
+    };
+
+    UnaryConstraint.prototype.chooseMethod = function (mark) {
+        this.satisfied = this.myOutput.mark != mark &&
+            Strength.stronger(this.strength, this.myOutput.walkStrength);
+    };
+
+    UnaryConstraint.prototype.isSatisfied = function () {
+        return this.satisfied;
+    };
+
+    UnaryConstraint.prototype.markInputs = function (mark) {
+    };
+
+    UnaryConstraint.prototype.output = function () {
+        return this.myOutput;
+    };
+
+    UnaryConstraint.prototype.recalculate = function () {
+        this.myOutput.walkStrength = this.strength;
+        this.myOutput.stay = !this.isInput();
+        if (this.myOutput.stay) this.execute();
+    };
+
+    UnaryConstraint.prototype.markUnsatisfied = function () {
+        this.satisfied = false;
+    };
+
+    UnaryConstraint.prototype.inputsKnown = function () {
+        return true;
+    };
+
+    UnaryConstraint.prototype.removeFromGraph = function () {
+        if (this.myOutput != null) this.myOutput.removeConstraint(this);
+        this.satisfied = false;
+    };
+
+    function StayConstraint(v, strength) {
+        UnaryConstraint.call(this, v, strength);
+    }
+
+    StayConstraint.prototype = Object.create(UnaryConstraint.prototype);
+
+    StayConstraint.prototype.execute = function () {
+    };
+
+    function EditConstraint(v, strength) {
+        UnaryConstraint.call(this, v, strength);
+    }
+
+    EditConstraint.prototype = Object.create(UnaryConstraint.prototype);
+
+    EditConstraint.prototype.isInput = function () {
+        return true;
+    };
+
+    EditConstraint.prototype.execute = function () {
+    };
+
+    var NONE = 0;
+    var FORWARD = 1;
+    var BACKWARD = -1;
+
+    function BinaryConstraint(var1, var2, strength) {
+        Constraint.call(this, strength);
+        this.v1 = var1;
+        this.v2 = var2;
+        this.direction = NONE;
+        this.addConstraint();
+    }
+
+    BinaryConstraint.prototype = Object.create(Constraint.prototype);
+
+    BinaryConstraint.prototype.chooseMethod = function (mark) {
+        if (this.v1.mark == mark) {
+            this.direction = (this.v2.mark != mark &&
+                Strength.stronger(this.strength, this.v2.walkStrength)) ? FORWARD : NONE;
+        }
+        if (this.v2.mark == mark) {
+            this.direction = (this.v1.mark != mark &&
+                Strength.stronger(this.strength, this.v1.walkStrength)) ? BACKWARD : NONE;
+        }
+        if (Strength.weaker(this.v1.walkStrength, this.v2.walkStrength)) {
+            this.direction = Strength.stronger(this.strength, this.v1.walkStrength)
+                ? BACKWARD : NONE;
+        } else {
+            this.direction = Strength.stronger(this.strength, this.v2.walkStrength)
+                ? FORWARD : BACKWARD;
+        }
+    };
+
+    BinaryConstraint.prototype.addToGraph = function () {
+        this.v1.addConstraint(this);
+        this.v2.addConstraint(this);
+        this.direction = NONE;
+    };
+
+    BinaryConstraint.prototype.isSatisfied = function () {
+        return this.direction != NONE;
+    };
+
+    BinaryConstraint.prototype.markInputs = function (mark) {
+        this.input().mark = mark;
+    };
+
+    BinaryConstraint.prototype.input = function () {
+        return this.direction == FORWARD ? this.v1 : this.v2;
+    };
+
+    BinaryConstraint.prototype.output = function () {
+        return this.direction == FORWARD ? this.v2 : this.v1;
+    };
+
+    BinaryConstraint.prototype.recalculate = function () {
+        var ihn = this.input(), out = this.output();
+        out.walkStrength = Strength.weakestOf(this.strength, ihn.walkStrength);
+        out.stay = ihn.stay;
+        if (out.stay) this.execute();
+    };
+
+    BinaryConstraint.prototype.markUnsatisfied = function () {
+        this.direction = NONE;
+    };
+
+    BinaryConstraint.prototype.inputsKnown = function (mark) {
+        var i = this.input();
+        return i.mark == mark || i.stay || i.determinedBy == null;
+    };
+
+    BinaryConstraint.prototype.removeFromGraph = function () {
+        if (this.v1 != null) this.v1.removeConstraint(this);
+        if (this.v2 != null) this.v2.removeConstraint(this);
+        this.direction = NONE;
+    };
+
+    function ScaleConstraint(src, scale, offset, dest, strength) {
+        this.direction = NONE;
+        this.scale = scale;
+        this.offset = offset;
+        BinaryConstraint.call(this, src, dest, strength);
+    }
+
+    ScaleConstraint.prototype = Object.create(BinaryConstraint.prototype);
+
+    ScaleConstraint.prototype.addToGraph = function () {
+        BinaryConstraint.prototype.addToGraph.call(this);
+        this.scale.addConstraint(this);
+        this.offset.addConstraint(this);
+    };
+
+    ScaleConstraint.prototype.removeFromGraph = function () {
+        BinaryConstraint.prototype.removeFromGraph.call(this);
+        if (this.scale != null) this.scale.removeConstraint(this);
+        if (this.offset != null) this.offset.removeConstraint(this);
+    };
+
+    ScaleConstraint.prototype.markInputs = function (mark) {
+        BinaryConstraint.prototype.markInputs.call(this, mark);
+        this.scale.mark = this.offset.mark = mark;
+    };
+
+    ScaleConstraint.prototype.execute = function () {
+        if (this.direction == FORWARD) {
+            this.v2.value = this.v1.value * this.scale.value + this.offset.value;
+        } else {
+            this.v1.value = (this.v2.value - this.offset.value) / this.scale.value;
+        }
+    };
+
+    ScaleConstraint.prototype.recalculate = function () {
+        var ihn = this.input(), out = this.output();
+        out.walkStrength = Strength.weakestOf(this.strength, ihn.walkStrength);
+        out.stay = ihn.stay && this.scale.stay && this.offset.stay;
+        if (out.stay) this.execute();
+    };
+
+    function EqualityConstraint(var1, var2, strength) {
+        BinaryConstraint.call(this, var1, var2, strength);
+    }
+
+    EqualityConstraint.prototype = Object.create(BinaryConstraint.prototype);
+
+    EqualityConstraint.prototype.execute = function () {
+        this.output().value = this.input().value;
+    };
+
+    function Variable(name, initialValue) {
+        this.value = initialValue || 0;
+        this.constraints = [];
+        this.determinedBy = null;
+        this.mark = 0;
+        this.walkStrength = Strength.WEAKEST;
+        this.stay = true;
+        this.name = name;
+    }
+
+    Variable.prototype.addConstraint = function (c) {
+        this.constraints.push(c);
+    };
+
+    Variable.prototype.removeConstraint = function (c) {
+        var index = this.constraints.indexOf(c);
+        if (index >= 0) this.constraints.splice(index, 1);
+        if (this.determinedBy == c) this.determinedBy = null;
+    };
+
+    function Planner() {
+        this.currentMark = 0;
+    }
+
+    Planner.prototype.incrementalAdd = function (c) {
+        var mark = this.newMark();
+        var overridden = c.satisfy(mark);
+        while (overridden != null) overridden = overridden.satisfy(mark);
+    };
+
+    Planner.prototype.incrementalRemove = function (c) {
+        var out = c.output();
+        c.markUnsatisfied();
+        c.removeFromGraph();
+        var unsatisfied = this.removePropagateFrom(out);
+        var strength = Strength.REQUIRED;
+        do {
+            for (var i = 0; i < unsatisfied.length; i++) {
+                var u = unsatisfied[i];
+                if (u.strength == strength) this.incrementalAdd(u);
+            }
+            strength = strength.nextWeaker();
+        } while (strength != Strength.WEAKEST);
+    };
+
+    Planner.prototype.newMark = function () {
+        return ++this.currentMark;
+    };
+
+    Planner.prototype.makePlan = function (sources) {
+        var mark = this.newMark();
+        var plan = [];
+        var todo = sources;
+        while (todo.length > 0) {
+            var c = todo.shift();
+            if (c.output().mark != mark && c.inputsKnown(mark)) {
+                plan.push(c);
+                c.output().mark = mark;
+                this.addConstraintsConsumingTo(c.output(), todo);
+            }
+        }
+        return plan;
+    };
+
+    Planner.prototype.extractPlanFromConstraints = function (constraints) {
+        var sources = [];
+        for (var i = 0; i < constraints.length; i++) {
+            var c = constraints[i];
+            if (c.isInput() && c.isSatisfied()) sources.push(c);
+        }
+        return this.makePlan(sources);
+    };
+
+    Planner.prototype.addPropagate = function (c, mark) {
+        var todo = [c];
+        while (todo.length > 0) {
+            var d = todo.shift();
+            if (d.output().mark == mark) {
+                this.incrementalRemove(c);
+                return false;
+            }
+            d.recalculate();
+            this.addConstraintsConsumingTo(d.output(), todo);
+        }
+        return true;
+    };
+
+    Planner.prototype.removePropagateFrom = function (out) {
+        out.determinedBy = null;
+        out.walkStrength = Strength.WEAKEST;
+        out.stay = true;
+        var unsatisfied = [];
+        var todo = [out];
+        while (todo.length > 0) {
+            var v = todo.shift();
+            var i;
+            for (i = 0; i < v.constraints.length; i++) {
+                var c = v.constraints[i];
+                if (!c.isSatisfied()) unsatisfied.push(c);
+            }
+            var determining = v.determinedBy;
+            for (i = 0; i < v.constraints.length; i++) {
+                var next = v.constraints[i];
+                if (next != determining && next.isSatisfied()) {
+                    next.recalculate();
+                    todo.push(next.output());
+                }
+            }
+        }
+        return unsatisfied;
+    };
+
+    Planner.prototype.addConstraintsConsumingTo = function (v, coll) {
+        var determining = v.determinedBy;
+        for (var i = 0; i < v.constraints.length; i++) {
+            var c = v.constraints[i];
+            if (c != determining && c.isSatisfied()) coll.push(c);
+        }
+    };
+
+    function executePlan(plan) {
+        for (var i = 0; i < plan.length; i++) plan[i].execute();
+    }
+
+    function chainTest(n) {
+        planner = new Planner();
+        var prev = null, first = null, last = null;
+        for (var i = 0; i <= n; i++) {
+            var v = new Variable("v" + i);
+            if (prev != null) new EqualityConstraint(prev, v, Strength.REQUIRED);
+            if (i == 0) first = v;
+            if (i == n) last = v;
+            prev = v;
+        }
+        new StayConstraint(last, Strength.STRONG_DEFAULT);
+        var edit = new EditConstraint(first, Strength.PREFERRED);
+        var plan = planner.extractPlanFromConstraints([edit]);
+        for (var j = 0; j < 100; j++) {
+            first.value = j;
+            executePlan(plan);
+            if (last.value != j) throw new Error("DeltaBlue: chain test failed");
+        }
+    }
+
+    function change(v, newValue) {
+        var edit = new EditConstraint(v, Strength.PREFERRED);
+        var plan = planner.extractPlanFromConstraints([edit]);
+        for (var i = 0; i < 10; i++) {
+            v.value = newValue;
+            executePlan(plan);
+        }
+        edit.destroyConstraint();
+    }
+
+    function projectionTest(n) {
+        planner = new Planner();
+        var scale = new Variable("scale", 10);
+        var offset = new Variable("offset", 1000);
+        var src = null, dst = null;
+        var dests = [];
+        for (var i = 0; i < n; i++) {
+            src = new Variable("src" + i, i);
+            dst = new Variable("dst" + i, i);
+            dests.push(dst);
+            new StayConstraint(src, Strength.NORMAL);
+            new ScaleConstraint(src, scale, offset, dst, Strength.REQUIRED);
+        }
+        change(src, 17);
+        if (dst.value != 1170) throw new Error("DeltaBlue: projection 1 failed");
+        change(dst, 1050);
+        if (src.value != 5) throw new Error("DeltaBlue: projection 2 failed");
+        change(scale, 5);
+        for (i = 0; i < n - 1; i++) {
+            if (dests[i].value != i * 5 + 1000) throw new Error("DeltaBlue: projection 3 failed");
+        }
+        change(offset, 2000);
+        for (i = 0; i < n - 1; i++) {
+            if (dests[i].value != i * 5 + 2000) throw new Error("DeltaBlue: projection 4 failed");
+        }
+    }
+
+    chainTest(100);
+    projectionTest(100);
+    return planner.currentMark;
+})()
+"""
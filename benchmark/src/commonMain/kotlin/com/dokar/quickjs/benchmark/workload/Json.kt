@@ -0,0 +1,43 @@
+package com.dokar.quickjs.benchmark.workload
+
+internal const val JSON = """
+// Serialize and parse a document of nested records repeatedly.
+(function () {
+    var RECORDS = 200;
+    var ROUNDS = 20;
+
+    var records = [];
+    for (var i = 0; i < RECORDS; i++) {
+        records.push({
+            id: i,
+            name: "user" + i,
+            email: "user" + i + "@example.com",
+            active: i % 3 != 0,
+            score: i * 1.5,
+            tags: ["tag" + (i % 7), "tag" + (i % 11), "tag" + (i % 13)],
+            address: {
+                street: i + " Main Street",
+                city: "City " + (i % 17),
+                zip: String(10000 + i),
+            },
+            history: [
+                { type: "login", at: 1700000000 + i },
+                { type: "purchase", at: 1700000500 + i, amount: i % 100 },
+            ],
+        });
+    }
+    var document = { version: 1, records: records };
+
+    var checksum = 0;
+    for (var round = 0; round < ROUNDS; round++) {
+        var text = JSON.stringify(document);
+        var parsed = JSON.parse(text);
+        checksum += text.length + parsed.records.length;
+        // Touch the parsed records so the work can't be skipped
+        for (var j = 0; j < parsed.records.length; j++) {
+            checksum += parsed.records[j].history[1].amount;
+        }
+    }
+    return checksum;
+})()
+"""
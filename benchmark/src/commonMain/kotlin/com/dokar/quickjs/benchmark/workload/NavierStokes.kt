@@ -0,0 +1,138 @@
+package com.dokar.quickjs.benchmark.workload
+
+internal const val NAVIER_STOKES = """
+// A 2D fluid solver, based on "Real-Time Fluid Dynamics for Games" by Jos Stam.
+(function () {
+    var N = 48;
+    var SIZE = (N + 2) * (N + 2);
+    var ITERATIONS = 10;
+    var FRAMES = 10;
+    var DT = 0.1;
+
+    function IX(i, j) {
+        return i + (N + 2) * j;
+    }
+
+    function setBoundary(b, x) {
+        for (var i = 1; i <= N; i++) {
+            x[IX(0, i)] = b == 1 ? -x[IX(1, i)] : x[IX(1, i)];
+            x[IX(N + 1, i)] = b == 1 ? -x[IX(N, i)] : x[IX(N, i)];
+            x[IX(i, 0)] = b == 2 ? -x[IX(i, 1)] : x[IX(i, 1)];
+            x[IX(i, N + 1)] = b == 2 ? -x[IX(i, N)] : x[IX(i, N)];
+        }
+        x[IX(0, 0)] = 0.5 * (x[IX(1, 0)] + x[IX(0, 1)]);
+        x[IX(0, N + 1)] = 0.5 * (x[IX(1, N + 1)] + x[IX(0, N)]);
+        x[IX(N + 1, 0)] = 0.5 * (x[IX(N, 0)] + x[IX(N + 1, 1)]);
+        x[IX(N + 1, N + 1)] = 0.5 * (x[IX(N, N + 1)] + x[IX(N + 1, N)]);
+    }
+
+    function linearSolve(b, x, x0, a, c) {
+        for (var k = 0; k < ITERATIONS; k++) {
+            for (var j = 1; j <= N; j++) {
+                for (var i = 1; i <= N; i++) {
+                    x[IX(i, j)] = (x0[IX(i, j)] + a * (x[IX(i - 1, j)] + x[IX(i + 1, j)] +
+                        x[IX(i, j - 1)] + x[IX(i, j + 1)])) / c;
+                }
+            }
+            setBoundary(b, x);
+        }
+    }
+
+    function addSource(x, s) {
+        for (var i = 0; i < SIZE; i++) x[i] += DT * s[i];
+    }
+
+    function diffuse(b, x, x0, diff) {
+        var a = DT * diff * N * N;
+        linearSolve(b, x, x0, a, 1 + 4 * a);
+    }
+
+    function advect(b, d, d0, u, v) {
+        var dt0 = DT * N;
+        for (var j = 1; j <= N; j++) {
+            for (var i = 1; i <= N; i++) {
+                var x = i - dt0 * u[IX(i, j)];
+                var y = j - dt0 * v[IX(i, j)];
+                if (x < 0.5) x = 0.5;
+                if (x > N + 0.5) x = N + 0.5;
+                if (y < 0.5) y = 0.5;
+                if (y > N + 0.5) y = N + 0.5;
+                var i0 = x | 0, i1 = i0 + 1;
+                var j0 = y | 0, j1 = j0 + 1;
+                var s1 = x - i0, s0 = 1 - s1;
+                var t1 = y - j0, t0 = 1 - t1;
+                d[IX(i, j)] = s0 * (t0 * d0[IX(i0, j0)] + t1 * d0[IX(i0, j1)]) +
+                    s1 * (t0 * d0[IX(i1, j0)] + t1 * d0[IX(i1, j1)]);
+            }
+        }
+        setBoundary(b, d);
+    }
+
+    function project(u, v, p, div) {
+        var h = 1 / N;
+        for (var j = 1; j <= N; j++) {
+            for (var i = 1; i <= N; i++) {
+                div[IX(i, j)] = -0.5 * h * (u[IX(i + 1, j)] - u[IX(i - 1, j)] +
+                    v[IX(i, j + 1)] - v[IX(i, j - 1)]);
+                p[IX(i, j)] = 0;
+            }
+        }
+        setBoundary(0, div);
+        setBoundary(0, p);
+        linearSolve(0, p, div, 1, 4);
+        for (j = 1; j <= N; j++) {
+            for (i = 1; i <= N; i++) {
+                u[IX(i, j)] -= 0.5 * (p[IX(i + 1, j)] - p[IX(i - 1, j)]) / h;
+                v[IX(i, j)] -= 0.5 * (p[IX(i, j + 1)] - p[IX(i, j - 1)]) / h;
+            }
+        }
+        setBoundary(1, u);
+        setBoundary(2, v);
+    }
+
+    function densityStep(x, x0, u, v) {
+        addSource(x, x0);
+        diffuse(0, x0, x, 0);
+        advect(0, x, x0, u, v);
+    }
+
+    function velocityStep(u, v, u0, v0) {
+        addSource(u, u0);
+        addSource(v, v0);
+        diffuse(1, u0, u, 0);
+        diffuse(2, v0, v, 0);
+        project(u0, v0, u, v);
+        advect(1, u, u0, u0, v0);
+        advect(2, v, v0, u0, v0);
+        project(u, v, u0, v0);
+    }
+
+    function newField() {
+        var field = new Array(SIZE);
+        for (var i = 0; i < SIZE; i++) field[i] = 0;
+        return field;
+    }
+
+    var dens = newField(), densPrev = newField();
+    var u = newField(), v = newField(), uPrev = newField(), vPrev = newField();
+
+    for (var frame = 0; frame < FRAMES; frame++) {
+        for (var i = 0; i < SIZE; i++) {
+            uPrev[i] = vPrev[i] = densPrev[i] = 0;
+        }
+        // Inject density and an upward force at the bottom center
+        for (var k = N / 2 - 4; k <= N / 2 + 4; k++) {
+            densPrev[IX(k, N - 2)] = 100;
+            vPrev[IX(k, N - 2)] = -20;
+            uPrev[IX(k, N - 2)] = frame % 2 == 0 ? 5 : -5;
+        }
+        velocityStep(u, v, uPrev, vPrev);
+        densityStep(dens, densPrev, u, v);
+    }
+
+    var total = 0;
+    for (i = 0; i < SIZE; i++) total += dens[i];
+    if (!(total > 0)) throw new Error("NavierStokes: no density");
+    return Math.round(total);
+})()
+"""
@@ -0,0 +1,212 @@
+package com.dokar.quickjs.benchmark.workload
+
+internal const val RAY_TRACE = """
+// A ray tracer rendering spheres on a checkered plane, with shadows and reflections.
+(function () {
+    var WIDTH = 64;
+    var HEIGHT = 64;
+    var MAX_DEPTH = 3;
+
+    function Vector(x, y, z) {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+    }
+
+    Vector.prototype.add = function (v) {
+        return new Vector(this.x + v.x, this.y + v.y, this.z + v.z);
+    };
+
+    Vector.prototype.subtract = function (v) {
+        return new Vector(this.x - v.x, this.y - v.y, this.z - v.z);
+    };
+
+    Vector.prototype.scale = function (s) {
+        return new Vector(this.x * s, this.y * s, this.z * s);
+    };
+
+    Vector.prototype.dot = function (v) {
+        return this.x * v.x + this.y * v.y + this.z * v.z;
+    };
+
+    Vector.prototype.cross = function (v) {
+        return new Vector(
+            this.y * v.z - this.z * v.y,
+            this.z * v.x - this.x * v.z,
+            this.x * v.y - this.y * v.x
+        );
+    };
+
+    Vector.prototype.normalize = function () {
+        return this.scale(1 / Math.sqrt(this.dot(this)));
+    };
+
+    function Color(r, g, b) {
+        this.r = r;
+        this.g = g;
+        this.b = b;
+    }
+
+    Color.prototype.add = function (c) {
+        return new Color(this.r + c.r, this.g + c.g, this.b + c.b);
+    };
+
+    Color.prototype.multiply = function (c) {
+        return new Color(this.r * c.r, this.g * c.g, this.b * c.b);
+    };
+
+    Color.prototype.scale = function (s) {
+        return new Color(this.r * s, this.g * s, this.b * s);
+    };
+
+    Color.prototype.clamp = function () {
+        return new Color(Math.min(this.r, 1), Math.min(this.g, 1), Math.min(this.b, 1));
+    };
+
+    var BLACK = new Color(0, 0, 0);
+
+    function Ray(origin, direction) {
+        this.origin = origin;
+        this.direction = direction;
+    }
+
+    function Material(color, reflection, specular, checkered) {
+        this.color = color;
+        this.reflection = reflection;
+        this.specular = specular;
+        this.checkered = checkered;
+    }
+
+    Material.prototype.colorAt = function (point) {
+        if (!this.checkered) return this.color;
+        var odd = (Math.floor(point.x) + Math.floor(point.z)) & 1;
+        return odd ? this.color : this.color.scale(0.2);
+    };
+
+    function Sphere(center, radius, material) {
+        this.center = center;
+        this.radiusSquared = radius * radius;
+        this.material = material;
+    }
+
+    Sphere.prototype.intersect = function (ray) {
+        var oc = ray.origin.subtract(this.center);
+        var b = oc.dot(ray.direction);
+        var c = oc.dot(oc) - this.radiusSquared;
+        var d = b * b - c;
+        if (d < 0) return -1;
+        var t = -b - Math.sqrt(d);
+        return t > 1e-6 ? t : -1;
+    };
+
+    Sphere.prototype.normalAt = function (point) {
+        return point.subtract(this.center).normalize();
+    };
+
+    function Plane(normal, offset, material) {
+        this.normal = normal;
+        this.offset = offset;
+        this.material = material;
+    }
+
+    Plane.prototype.intersect = function (ray) {
+        var denominator = this.normal.dot(ray.direction);
+        if (denominator > -1e-6) return -1;
+        var t = -(this.normal.dot(ray.origin) + this.offset) / denominator;
+        return t > 1e-6 ? t : -1;
+    };
+
+    Plane.prototype.normalAt = function (point) {
+        return this.normal;
+    };
+
+    function Light(position, color) {
+        this.position = position;
+        this.color = color;
+    }
+
+    var shapes = [
+        new Plane(new Vector(0, 1, 0), 0, new Material(new Color(1, 1, 1), 0.2, 0, true)),
+        new Sphere(new Vector(-1.5, 1, 0), 1, new Material(new Color(0.9, 0.2, 0.2), 0.3, 40, false)),
+        new Sphere(new Vector(1, 0.75, -1), 0.75, new Material(new Color(0.2, 0.8, 0.3), 0.4, 60, false)),
+        new Sphere(new Vector(0.5, 0.4, 1.5), 0.4, new Material(new Color(0.3, 0.4, 0.9), 0.6, 80, false)),
+    ];
+
+    var lights = [
+        new Light(new Vector(-5, 8, 5), new Color(0.8, 0.8, 0.8)),
+        new Light(new Vector(5, 6, -3), new Color(0.4, 0.4, 0.5)),
+    ];
+
+    var ambient = new Color(0.1, 0.1, 0.1);
+
+    function closestHit(ray) {
+        var closest = null;
+        var closestT = Infinity;
+        for (var i = 0; i < shapes.length; i++) {
+            var t = shapes[i].intersect(ray);
+            if (t > 0 && t < closestT) {
+                closestT = t;
+                closest = shapes[i];
+            }
+        }
+        return closest == null ? null : { shape: closest, t: closestT };
+    }
+
+    function isShadowed(point, light) {
+        var toLight = light.position.subtract(point);
+        var distance = Math.sqrt(toLight.dot(toLight));
+        var hit = closestHit(new Ray(point, toLight.scale(1 / distance)));
+        return hit != null && hit.t < distance;
+    }
+
+    function trace(ray, depth) {
+        var hit = closestHit(ray);
+        if (hit == null) return BLACK;
+        var point = ray.origin.add(ray.direction.scale(hit.t));
+        var normal = hit.shape.normalAt(point);
+        var material = hit.shape.material;
+        var baseColor = material.colorAt(point);
+        var color = ambient.multiply(baseColor);
+        for (var i = 0; i < lights.length; i++) {
+            var light = lights[i];
+            if (isShadowed(point, light)) continue;
+            var toLight = light.position.subtract(point).normalize();
+            var diffuse = normal.dot(toLight);
+            if (diffuse > 0) {
+                color = color.add(baseColor.multiply(light.color).scale(diffuse));
+            }
+            if (material.specular > 0) {
+                var halfway = toLight.subtract(ray.direction).normalize();
+                var specular = normal.dot(halfway);
+                if (specular > 0) {
+                    color = color.add(light.color.scale(Math.pow(specular, material.specular)));
+                }
+            }
+        }
+        if (depth < MAX_DEPTH && material.reflection > 0) {
+            var reflected = ray.direction.subtract(normal.scale(2 * normal.dot(ray.direction)));
+            var reflection = trace(new Ray(point, reflected), depth + 1);
+            color = color.add(reflection.scale(material.reflection));
+        }
+        return color.clamp();
+    }
+
+    var eye = new Vector(0, 2.5, 7);
+    var forward = new Vector(0, 0.8, 0).subtract(eye).normalize();
+    var right = forward.cross(new Vector(0, 1, 0)).normalize();
+    var up = right.cross(forward);
+
+    var checksum = 0;
+    for (var y = 0; y < HEIGHT; y++) {
+        for (var x = 0; x < WIDTH; x++) {
+            var u = (x - WIDTH / 2) / WIDTH;
+            var v = (HEIGHT / 2 - y) / HEIGHT;
+            var direction = forward.add(right.scale(u)).add(up.scale(v)).normalize();
+            var color = trace(new Ray(eye, direction), 0);
+            checksum += Math.floor(color.r * 255) + Math.floor(color.g * 255) +
+                Math.floor(color.b * 255);
+        }
+    }
+    return checksum;
+})()
+"""
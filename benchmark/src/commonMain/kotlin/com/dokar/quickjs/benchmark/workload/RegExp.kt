@@ -0,0 +1,48 @@
+package com.dokar.quickjs.benchmark.workload
+
+internal const val REG_EXP = """
+// Parse, validate and rewrite log lines with regular expressions.
+(function () {
+    var LINES = 1000;
+    var ROUNDS = 5;
+
+    var methods = ["GET", "POST", "PUT", "DELETE"];
+    var paths = ["/api/users", "/api/orders/42", "/static/app.js", "/login?next=%2Fhome"];
+    var lines = [];
+    for (var i = 0; i < LINES; i++) {
+        lines.push(
+            "10.0." + (i % 256) + "." + ((i * 7) % 256) +
+            " - - [12/Mar/2024:10:" + String(i % 60).padStart(2, "0") + ":00 +0000] \"" +
+            methods[i % methods.length] + " " + paths[i % paths.length] + " HTTP/1.1\" " +
+            (i % 10 == 0 ? 500 : 200) + " " + (i * 13) % 5000 +
+            " \"Mozilla/5.0\" user=user" + i + "@example.com"
+        );
+    }
+
+    var linePattern = /^(\d+\.\d+\.\d+\.\d+) - - \[([^\]]+)\] "(\w+) ([^ ]+) HTTP\/[\d.]+" (\d{3}) (\d+)/;
+    var emailPattern = /([\w.+-]+)@([\w-]+\.)+\w+/g;
+    var queryPattern = /[?&]([^=&]+)=([^&]*)/g;
+    var digitsPattern = /\d+/g;
+
+    var checksum = 0;
+    for (var round = 0; round < ROUNDS; round++) {
+        for (var j = 0; j < lines.length; j++) {
+            var line = lines[j];
+            var match = linePattern.exec(line);
+            if (match == null) throw new Error("RegExp: no match for line " + j);
+            if (match[5] == "500") checksum++;
+            checksum += match[4].split("/").length;
+            var query;
+            queryPattern.lastIndex = 0;
+            while ((query = queryPattern.exec(match[4])) != null) {
+                checksum += decodeURIComponent(query[2]).length;
+            }
+            var masked = line.replace(emailPattern, "<email>");
+            checksum += masked.length;
+            checksum += (line.match(digitsPattern) || []).length;
+            if (/^10\.0\.\d+\.\d+/.test(line)) checksum++;
+        }
+    }
+    return checksum;
+})()
+"""
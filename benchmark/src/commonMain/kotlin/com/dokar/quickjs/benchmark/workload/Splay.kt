@@ -0,0 +1,160 @@
+package com.dokar.quickjs.benchmark.workload
+
+internal const val SPLAY = """
+// Splay tree insertions and removals with object payloads, stressing allocation and GC.
+(function () {
+    var TREE_SIZE = 4000;
+    var MODIFICATIONS = 2000;
+    var PAYLOAD_DEPTH = 3;
+
+    var seed = 49734321;
+
+    function random() {
+        // A deterministic LCG, so every run does the same work
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed / 0x7fffffff;
+    }
+
+    function Node(key, value) {
+        this.key = key;
+        this.value = value;
+        this.left = null;
+        this.right = null;
+    }
+
+    function SplayTree() {
+        this.root = null;
+        this.size = 0;
+    }
+
+    SplayTree.prototype.splay = function (key) {
+        if (this.root == null) return;
+        var dummy = new Node(null, null);
+        var left = dummy, right = dummy;
+        var current = this.root;
+        while (true) {
+            if (key < current.key) {
+                if (current.left == null) break;
+                if (key < current.left.key) {
+                    var rotateRight = current.left;
+                    current.left = rotateRight.right;
+                    rotateRight.right = current;
+                    current = rotateRight;
+                    if (current.left == null) break;
+                }
+                right.left = current;
+                right = current;
+                current = current.left;
+            } else if (key > current.key) {
+                if (current.right == null) break;
+                if (key > current.right.key) {
+                    var rotateLeft = current.right;
+                    current.right = rotateLeft.left;
+                    rotateLeft.left = current;
+                    current = rotateLeft;
+                    if (current.right == null) break;
+                }
+                left.right = current;
+                left = current;
+                current = current.right;
+            } else {
+                break;
+            }
+        }
+        left.right = current.left;
+        right.left = current.right;
+        current.left = dummy.right;
+        current.right = dummy.left;
+        this.root = current;
+    };
+
+    SplayTree.prototype.insert = function (key, value) {
+        if (this.root == null) {
+            this.root = new Node(key, value);
+            this.size++;
+            return;
+        }
+        this.splay(key);
+        if (this.root.key == key) return;
+        var node = new Node(key, value);
+        if (key > this.root.key) {
+            node.left = this.root;
+            node.right = this.root.right;
+            this.root.right = null;
+        } else {
+            node.right = this.root;
+            node.left = this.root.left;
+            this.root.left = null;
+        }
+        this.root = node;
+        this.size++;
+    };
+
+    SplayTree.prototype.remove = function (key) {
+        if (this.root == null) return null;
+        this.splay(key);
+        if (this.root.key != key) return null;
+        var removed = this.root;
+        if (this.root.left == null) {
+            this.root = this.root.right;
+        } else {
+            var right = this.root.right;
+            this.root = this.root.left;
+            this.splay(key);
+            this.root.right = right;
+        }
+        this.size--;
+        return removed;
+    };
+
+    SplayTree.prototype.findGreatestLessThan = function (key) {
+        if (this.root == null) return null;
+        this.splay(key);
+        if (this.root.key < key) return this.root;
+        if (this.root.left != null) {
+            var current = this.root.left;
+            while (current.right != null) current = current.right;
+            return current;
+        }
+        return null;
+    };
+
+    function generatePayload(depth, tag) {
+        if (depth == 0) {
+            return {
+                array: [0, 1, 2, 3, 4, 5, 6, 7, 8, 9],
+                string: "String for key " + tag + " in leaf node",
+            };
+        }
+        return {
+            left: generatePayload(depth - 1, tag),
+            right: generatePayload(depth - 1, tag),
+        };
+    }
+
+    function generateKey(tree) {
+        var key;
+        do {
+            key = random();
+        } while (tree.root != null && (tree.splay(key), tree.root.key == key));
+        return key;
+    }
+
+    var tree = new SplayTree();
+    for (var i = 0; i < TREE_SIZE; i++) {
+        var key = generateKey(tree);
+        tree.insert(key, generatePayload(PAYLOAD_DEPTH, String(key)));
+    }
+
+    for (i = 0; i < MODIFICATIONS; i++) {
+        var newKey = generateKey(tree);
+        tree.insert(newKey, generatePayload(PAYLOAD_DEPTH, String(newKey)));
+        var greatest = tree.findGreatestLessThan(newKey);
+        var removed = tree.remove(greatest == null ? newKey : greatest.key);
+        if (removed == null) throw new Error("Splay: key not found");
+    }
+
+    if (tree.size != TREE_SIZE) throw new Error("Splay: unexpected size " + tree.size);
+    return tree.size;
+})()
+"""
@@ -0,0 +1,42 @@
+package com.dokar.quickjs.benchmark.workload
+
+/**
+ * Self-contained JS workloads. Each source is an expression that runs the workload, verifies
+ * its result, and returns a checksum.
+ */
+internal enum class Workload(val source: String) {
+    /**
+     * OS kernel simulation, property accesses and method calls.
+     */
+    Richards(RICHARDS),
+
+    /**
+     * One-way constraint solver, polymorphic calls and object allocation.
+     */
+    DeltaBlue(DELTA_BLUE),
+
+    /**
+     * Ray tracer, floating point math and short-lived objects.
+     */
+    RayTrace(RAY_TRACE),
+
+    /**
+     * 2D fluid solver, numeric array loops.
+     */
+    NavierStokes(NAVIER_STOKES),
+
+    /**
+     * Splay tree with object payloads, allocation and GC.
+     */
+    Splay(SPLAY),
+
+    /**
+     * JSON.stringify() and JSON.parse() of nested records.
+     */
+    Json(JSON),
+
+    /**
+     * Log line parsing and rewriting with regular expressions.
+     */
+    RegExp(REG_EXP),
+}
@@ -0,0 +1,160 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.JsObject
+import com.dokar.quickjs.binding.function
+import com.dokar.quickjs.converter.JsObjectConverter
+import com.dokar.quickjs.conveter.JsonClassConverter
+import com.dokar.quickjs.conveter.SerializableConverter
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Param
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+import kotlin.reflect.KType
+import kotlin.reflect.typeOf
+
+/**
+ * Compare converters of data classes: 'moshi' (JsonClassConverter), 'ktxSerialization'
+ * (SerializableConverter) and 'jsObject', which maps [JsObject]s by hand.
+ *
+ * When a benchmark finishes, a line like 'CONVERTER converter=moshi size=medium
+ * benchmark=fromJs heapBytesPerOp=1024 mallocBytesPerOp=2048' is printed.
+ */
+@OptIn(ExperimentalQuickJsApi::class)
+@Suppress("unused")
+@State(Scope.Benchmark)
+class ConverterBenchmark {
+    @Param("moshi", "ktxSerialization", "jsObject")
+    var converter: String = ""
+
+    /**
+     * 'medium' for 8 fields, 'large' for 24 fields.
+     */
+    @Param("medium", "large")
+    var size: String = ""
+
+    private lateinit var quickJs: QuickJs
+
+    private lateinit var evaluateTyped: suspend (code: String) -> Any?
+
+    private val counters = linkedMapOf<String, AllocationCounter>()
+
+    private var lastMallocBytes = 0L
+
+    @Setup
+    fun setup() {
+        quickJs = QuickJs.create(Dispatchers.Default, enableMemoryAccounting = true)
+        when (size) {
+            "medium" -> setupModel(sampleProfile, Profile::toJsObject, JsObject::toProfile)
+            "large" -> setupModel(sampleOrder, Order::toJsObject, JsObject::toOrder)
+            else -> error("Unknown size: $size")
+        }
+        // The marker is converted by a trivial converter, registered after the data class ones
+        quickJs.addTypeConverters(MarkerConverter)
+        runBlocking {
+            quickJs.evaluate<Any?>("globalThis.payload = sample(); globalThis.marker = {};")
+        }
+        counters.clear()
+    }
+
+    @TearDown
+    fun cleanup() {
+        for ((name, counter) in counters) {
+            println(
+                "CONVERTER converter=$converter size=$size benchmark=$name " +
+                        "heapBytesPerOp=${counter.heapBytesPerOp()} " +
+                        "mallocBytesPerOp=${counter.mallocBytesPerOp()}"
+            )
+        }
+        quickJs.close()
+    }
+
+    /**
+     * A script returns the object, which is converted to the data class.
+     */
+    @Benchmark
+    fun fromJs() = track("fromJs") { evaluateTyped("payload") }
+
+    /**
+     * A script passes the object to a function, which accepts the data class.
+     */
+    @Benchmark
+    fun acceptArgument() = track("acceptArgument") { evaluateCounted<Any?>("accept(payload)") }
+
+    /**
+     * A function returns the data class, which is converted to a JS object.
+     */
+    @Benchmark
+    fun toJs() = track("toJs") { evaluateCounted<Any?>("produce()") }
+
+    /**
+     * The result is converted by [MarkerConverter], compare it with [lookupBaseline] to get the
+     * cost of looking up converters.
+     */
+    @Benchmark
+    fun lookup() = track("lookup") { evaluateCounted<Marker>("marker") }
+
+    /**
+     * The same evaluation as [lookup], but no converter is needed.
+     */
+    @Benchmark
+    fun lookupBaseline() = track("lookupBaseline") { evaluateCounted<JsObject>("marker") }
+
+    private inline fun <reified T : Any> setupModel(
+        sample: T,
+        crossinline toJsObject: (T) -> JsObject,
+        crossinline fromJsObject: (JsObject) -> T,
+    ) {
+        val sampleJs = toJsObject(sample)
+        quickJs.function("sample") { sampleJs }
+        when (converter) {
+            "moshi", "ktxSerialization" -> {
+                quickJs.addTypeConverters(
+                    if (converter == "moshi") {
+                        JsonClassConverter<T>()
+                    } else {
+                        SerializableConverter<T>()
+                    }
+                )
+                quickJs.function<T, Int>("accept") { it.hashCode() }
+                quickJs.function("produce") { sample }
+                evaluateTyped = { evaluateCounted<T>(it) }
+            }
+
+            "jsObject" -> {
+                quickJs.function<JsObject, Int>("accept") { fromJsObject(it).hashCode() }
+                quickJs.function("produce") { toJsObject(sample) }
+                evaluateTyped = { fromJsObject(evaluateCounted<JsObject>(it)) }
+            }
+
+            else -> error("Unknown converter: $converter")
+        }
+    }
+
+    private suspend inline fun <reified T> evaluateCounted(code: String): T {
+        val result = quickJs.evaluateWithMemoryStats<T>(code)
+        lastMallocBytes = result.memoryStats.allocatedBytes
+        return result.value
+    }
+
+    private inline fun track(name: String, crossinline block: suspend () -> Any?) = runBlocking {
+        val counter = counters.getOrPut(name) { AllocationCounter() }
+        lastMallocBytes = 0L
+        counter.track(mallocBytes = { lastMallocBytes }) {
+            block()
+        }
+    }
+
+    private object Marker
+
+    private object MarkerConverter : JsObjectConverter<Marker> {
+        override val targetType: KType = typeOf<Marker>()
+
+        override fun convertToTarget(value: JsObject): Marker = Marker
+    }
+}
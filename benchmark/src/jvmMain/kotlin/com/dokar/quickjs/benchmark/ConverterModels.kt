@@ -0,0 +1,166 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.binding.JsObject
+import com.dokar.quickjs.binding.toJsObject
+import com.squareup.moshi.JsonClass
+import kotlinx.serialization.Serializable
+
+// Flat classes of Long, Double, String and Boolean fields, which all converters can map from
+// JS values, nested objects are not supported by the properties format. Integers must fit in
+// 32 bits, larger JS numbers are doubles.
+
+@JsonClass(generateAdapter = true)
+@Serializable
+internal data class Profile(
+    val id: Long,
+    val name: String,
+    val email: String,
+    val country: String,
+    val score: Double,
+    val ratio: Double,
+    val active: Boolean,
+    val createdAt: Long,
+)
+
+@JsonClass(generateAdapter = true)
+@Serializable
+internal data class Order(
+    val id: Long,
+    val customerId: Long,
+    val customerName: String,
+    val customerEmail: String,
+    val status: String,
+    val currency: String,
+    val subtotal: Double,
+    val tax: Double,
+    val shipping: Double,
+    val discount: Double,
+    val total: Double,
+    val itemCount: Long,
+    val createdAt: Long,
+    val updatedAt: Long,
+    val paidAt: Long,
+    val shippedAt: Long,
+    val street: String,
+    val city: String,
+    val region: String,
+    val postalCode: String,
+    val country: String,
+    val note: String,
+    val giftWrap: Boolean,
+    val expedited: Boolean,
+)
+
+internal val sampleProfile = Profile(
+    id = 1024,
+    name = "Ada Lovelace",
+    email = "ada@example.com",
+    country = "GB",
+    score = 98.5,
+    ratio = 0.75,
+    active = true,
+    createdAt = 1700000000,
+)
+
+internal val sampleOrder = Order(
+    id = 90210,
+    customerId = 1024,
+    customerName = "Ada Lovelace",
+    customerEmail = "ada@example.com",
+    status = "shipped",
+    currency = "EUR",
+    subtotal = 120.5,
+    tax = 24.1,
+    shipping = 4.9,
+    discount = 10.25,
+    total = 139.25,
+    itemCount = 3,
+    createdAt = 1700000000,
+    updatedAt = 1700000360,
+    paidAt = 1700000060,
+    shippedAt = 1700086400,
+    street = "12 St James's Square",
+    city = "London",
+    region = "Greater London",
+    postalCode = "SW1Y 4JH",
+    country = "GB",
+    note = "Leave the parcel at the reception.",
+    giftWrap = false,
+    expedited = true,
+)
+
+internal fun Profile.toJsObject(): JsObject = mapOf(
+    "id" to id,
+    "name" to name,
+    "email" to email,
+    "country" to country,
+    "score" to score,
+    "ratio" to ratio,
+    "active" to active,
+    "createdAt" to createdAt,
+).toJsObject()
+
+internal fun JsObject.toProfile(): Profile = Profile(
+    id = this["id"] as Long,
+    name = this["name"] as String,
+    email = this["email"] as String,
+    country = this["country"] as String,
+    score = this["score"] as Double,
+    ratio = this["ratio"] as Double,
+    active = this["active"] as Boolean,
+    createdAt = this["createdAt"] as Long,
+)
+
+internal fun Order.toJsObject(): JsObject = mapOf(
+    "id" to id,
+    "customerId" to customerId,
+    "customerName" to customerName,
+    "customerEmail" to customerEmail,
+    "status" to status,
+    "currency" to currency,
+    "subtotal" to subtotal,
+    "tax" to tax,
+    "shipping" to shipping,
+    "discount" to discount,
+    "total" to total,
+    "itemCount" to itemCount,
+    "createdAt" to createdAt,
+    "updatedAt" to updatedAt,
+    "paidAt" to paidAt,
+    "shippedAt" to shippedAt,
+    "street" to street,
+    "city" to city,
+    "region" to region,
+    "postalCode" to postalCode,
+    "country" to country,
+    "note" to note,
+    "giftWrap" to giftWrap,
+    "expedited" to expedited,
+).toJsObject()
+
+internal fun JsObject.toOrder(): Order = Order(
+    id = this["id"] as Long,
+    customerId = this["customerId"] as Long,
+    customerName = this["customerName"] as String,
+    customerEmail = this["customerEmail"] as String,
+    status = this["status"] as String,
+    currency = this["currency"] as String,
+    subtotal = this["subtotal"] as Double,
+    tax = this["tax"] as Double,
+    shipping = this["shipping"] as Double,
+    discount = this["discount"] as Double,
+    total = this["total"] as Double,
+    itemCount = this["itemCount"] as Long,
+    createdAt = this["createdAt"] as Long,
+    updatedAt = this["updatedAt"] as Long,
+    paidAt = this["paidAt"] as Long,
+    shippedAt = this["shippedAt"] as Long,
+    street = this["street"] as String,
+    city = this["city"] as String,
+    region = this["region"] as String,
+    postalCode = this["postalCode"] as String,
+    country = this["country"] as String,
+    note = this["note"] as String,
+    giftWrap = this["giftWrap"] as Boolean,
+    expedited = this["expedited"] as Boolean,
+)
@@ -0,0 +1,12 @@
+package com.dokar.quickjs.benchmark
+
+import java.lang.management.ManagementFactory
+import com.sun.management.ThreadMXBean
+
+private val threadMXBean = ManagementFactory.getThreadMXBean() as ThreadMXBean
+
+actual fun allocatedHeapBytes(): Long {
+    // Async jobs run on other threads, so count all threads
+    val counts = threadMXBean.getThreadAllocatedBytes(threadMXBean.allThreadIds)
+    return counts.sumOf { if (it > 0) it else 0 }
+}
@@ -0,0 +1,4 @@
+package com.dokar.quickjs.benchmark
+
+// Kotlin/Native has no allocation counters
+actual fun allocatedHeapBytes(): Long = -1
@@ -0,0 +1,66 @@
+package com.dokar.quickjs.benchmark
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.define
+import kotlinx.benchmark.Benchmark
+import kotlinx.benchmark.Scope
+import kotlinx.benchmark.Setup
+import kotlinx.benchmark.State
+import kotlinx.benchmark.TearDown
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.runBlocking
+
+/**
+ * Run a mixed workload and print the executed opcodes when it's done. The report is only
+ * available if the engine is built with 'QUICKJS_OPCODE_STATS=true'.
+ */
+@Suppress("unused")
+@OptIn(ExperimentalQuickJsApi::class)
+@State(Scope.Benchmark)
+class OpcodeStatsBenchmark {
+    private lateinit var quickJs: QuickJs
+
+    @Setup
+    fun setup() {
+        quickJs = QuickJs.create(Dispatchers.Default)
+        quickJs.define("console") {
+            property("level") {
+                getter { "Debug" }
+            }
+
+            function("log") {}
+        }
+        quickJs.resetOpcodeStats()
+    }
+
+    @TearDown
+    fun cleanup() {
+        val report = quickJs.opcodeStats()?.toReport()
+            ?: "Opcode stats are not available, build with 'QUICKJS_OPCODE_STATS=true'."
+        println(report)
+        quickJs.close()
+    }
+
+    @Benchmark
+    fun mixedWorkload() = runBlocking {
+        quickJs.evaluate<Any?>(
+            """
+                const items = [];
+                for (let i = 0; i < 100; i++) {
+                    items.push({ id: i, name: "item" + i, tags: ["a", "b"] });
+                }
+                let total = 0;
+                for (const item of items) {
+                    total += item.id + item.tags.length;
+                    item.name = item.name.toUpperCase();
+                }
+                const lookup = {};
+                for (let i = 0; i < items.length; i++) {
+                    lookup[items[i].name] = items[i];
+                }
+                console.log(console.level, total, Object.keys(lookup).length);
+            """.trimIndent()
+        )
+    }
+}
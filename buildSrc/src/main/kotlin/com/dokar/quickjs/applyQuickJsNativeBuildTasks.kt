@@ -27,6 +27,8 @@ fun Project.applyQuickJsNativeBuildTasks(cmakeFile: File) {
         inputs.file(File(projectDir, "/native/CMakeLists.txt"))
 
         outputs.dir(jniLibOutDir)
+        inputs.property("opcodeStats", isOpcodeStatsEnabled())
+        inputs.property("asan", isAddressSanitizerEnabled())
 
         doLast {
             val isPublishing = gradle.startParameter.taskNames.contains("publish")
@@ -65,6 +67,8 @@ fun Project.applyQuickJsNativeBuildTasks(cmakeFile: File) {
 
         val buildPlatforms = findBuildPlatformsFromStartTaskNames()
         inputs.property("platform", buildPlatforms)
+        inputs.property("opcodeStats", isOpcodeStatsEnabled())
+        inputs.property("asan", isAddressSanitizerEnabled())
 
         doLast {
             for (platform in buildPlatforms) {
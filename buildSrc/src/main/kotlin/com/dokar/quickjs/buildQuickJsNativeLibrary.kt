@@ -25,6 +25,8 @@ internal fun Project.buildQuickJsNativeLibrary(
         "-DTARGET_PLATFORM=$platform",
         "-DBUILD_WITH_JNI=${if (withJni) "ON" else "OFF"}",
         "-DLIBRARY_TYPE=${if (sharedLib) "shared" else "static"}",
+        "-DQJS_KT_OPCODE_STATS=${if (isOpcodeStatsEnabled()) "ON" else "OFF"}",
+        "-DQJS_KT_ASAN=${if (isAddressSanitizerEnabled()) "ON" else "OFF"}",
     )
 
     // Generators
@@ -149,6 +151,24 @@ private fun Project.macosAarch64JavaHome() =
         "'JAVA_HOME_MACOS_AARCH64' is not found in env vars or local.properties"
     }
 
+/**
+ * Build the engine with opcode counting if 'QUICKJS_OPCODE_STATS' is 'true'. The instrumented
+ * engine is for local profiling only, it's never published.
+ */
+internal fun Project.isOpcodeStatsEnabled(): Boolean {
+    return envVarOrLocalPropOf("QUICKJS_OPCODE_STATS") == "true" &&
+            !gradle.startParameter.taskNames.contains("publish")
+}
+
+/**
+ * Build the engine and the native test binaries with AddressSanitizer if 'QUICKJS_ASAN' is
+ * 'true'. It's for local checks only, it's never published.
+ */
+fun Project.isAddressSanitizerEnabled(): Boolean {
+    return envVarOrLocalPropOf("QUICKJS_ASAN") == "true" &&
+            !gradle.startParameter.taskNames.contains("publish")
+}
+
 private fun Project.envVarOrLocalPropOf(key: String): String? {
     val localProperties = Properties()
     val localPropertiesFile = project.rootDir.resolve("local.properties")
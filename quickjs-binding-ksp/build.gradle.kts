@@ -0,0 +1,16 @@
+plugins {
+    alias(libs.plugins.kotlinJvm)
+    alias(libs.plugins.mavenPublish)
+}
+
+kotlin {
+    jvmToolchain {
+        languageVersion.set(JavaLanguageVersion.of(11))
+    }
+}
+
+dependencies {
+    implementation(libs.ksp.api)
+    implementation(libs.kotlinpoet)
+    implementation(libs.kotlinpoet.ksp)
+}
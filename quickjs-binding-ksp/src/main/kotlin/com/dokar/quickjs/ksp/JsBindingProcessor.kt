@@ -0,0 +1,431 @@
+package com.dokar.quickjs.ksp
+
+import com.google.devtools.ksp.getDeclaredFunctions
+import com.google.devtools.ksp.getDeclaredProperties
+import com.google.devtools.ksp.getVisibility
+import com.google.devtools.ksp.isConstructor
+import com.google.devtools.ksp.isPublic
+import com.google.devtools.ksp.processing.CodeGenerator
+import com.google.devtools.ksp.processing.Dependencies
+import com.google.devtools.ksp.processing.KSPLogger
+import com.google.devtools.ksp.processing.Resolver
+import com.google.devtools.ksp.processing.SymbolProcessor
+import com.google.devtools.ksp.symbol.ClassKind
+import com.google.devtools.ksp.symbol.KSAnnotated
+import com.google.devtools.ksp.symbol.KSClassDeclaration
+import com.google.devtools.ksp.symbol.KSFunctionDeclaration
+import com.google.devtools.ksp.symbol.KSPropertyDeclaration
+import com.google.devtools.ksp.symbol.KSType
+import com.google.devtools.ksp.symbol.KSTypeReference
+import com.google.devtools.ksp.symbol.Modifier
+import com.google.devtools.ksp.symbol.Visibility
+import com.google.devtools.ksp.validate
+import com.squareup.kotlinpoet.ANY
+import com.squareup.kotlinpoet.AnnotationSpec
+import com.squareup.kotlinpoet.ARRAY
+import com.squareup.kotlinpoet.BOOLEAN
+import com.squareup.kotlinpoet.BYTE_ARRAY
+import com.squareup.kotlinpoet.ClassName
+import com.squareup.kotlinpoet.CodeBlock
+import com.squareup.kotlinpoet.DOUBLE
+import com.squareup.kotlinpoet.FileSpec
+import com.squareup.kotlinpoet.FunSpec
+import com.squareup.kotlinpoet.KModifier
+import com.squareup.kotlinpoet.LIST
+import com.squareup.kotlinpoet.LONG
+import com.squareup.kotlinpoet.MemberName
+import com.squareup.kotlinpoet.ParameterSpec
+import com.squareup.kotlinpoet.ParameterizedTypeName.Companion.parameterizedBy
+import com.squareup.kotlinpoet.PropertySpec
+import com.squareup.kotlinpoet.STRING
+import com.squareup.kotlinpoet.TypeName
+import com.squareup.kotlinpoet.TypeSpec
+import com.squareup.kotlinpoet.UNIT
+import com.squareup.kotlinpoet.ksp.toClassName
+import com.squareup.kotlinpoet.ksp.toTypeName
+import com.squareup.kotlinpoet.ksp.writeTo
+
+/**
+ * Generate an 'ObjectBinding' and a 'QuickJs.defineXxx()' extension for each class annotated
+ * with '@JsBinding'. Members are dispatched by 'when' branches on their names. Arguments of
+ * bridge types are cast directly, others are decoded with types resolved once per binding class.
+ */
+class JsBindingProcessor(
+    private val codeGenerator: CodeGenerator,
+    private val logger: KSPLogger,
+) : SymbolProcessor {
+    override fun process(resolver: Resolver): List<KSAnnotated> {
+        val symbols = resolver.getSymbolsWithAnnotation(JS_BINDING)
+        val deferred = symbols.filterNot { it.validate() }.toList()
+        symbols
+            .filter { it.validate() }
+            .forEach { symbol ->
+                if (symbol !is KSClassDeclaration || symbol.classKind != ClassKind.CLASS) {
+                    logger.error("@JsBinding can only be applied to classes.", symbol)
+                    return@forEach
+                }
+                generate(symbol)
+            }
+        return deferred
+    }
+
+    private fun generate(cls: KSClassDeclaration) {
+        if (cls.typeParameters.isNotEmpty()) {
+            logger.error("@JsBinding classes can't have type parameters.", cls)
+            return
+        }
+        val visibility = cls.getVisibility()
+        if (visibility != Visibility.PUBLIC && visibility != Visibility.INTERNAL) {
+            logger.error("@JsBinding classes must be public or internal.", cls)
+            return
+        }
+        val properties = cls.getDeclaredProperties()
+            .filter { it.isPublic() && it.extensionReceiver == null && !it.isIgnored() }
+            .toList()
+        val functions = cls.getDeclaredFunctions()
+            .filter {
+                it.isPublic() && !it.isConstructor() && it.extensionReceiver == null &&
+                        !it.isIgnored()
+            }
+            .toList()
+        if (!checkMembers(cls, properties, functions)) {
+            return
+        }
+
+        val className = cls.toClassName()
+        val bindingName = className.simpleNames.joinToString(separator = "") + "Binding"
+        val bindingClassName = ClassName(className.packageName, bindingName)
+        val types = TypeConstants()
+
+        val bindingClass = TypeSpec.classBuilder(bindingClassName)
+            .addModifiers(visibilityOf(cls))
+            .addAnnotation(optInAnnotation())
+            .superclass(GENERATED_OBJECT_BINDING)
+            .addSuperclassConstructorParameter("quickJs, name, sharedPrototype")
+            .primaryConstructor(
+                FunSpec.constructorBuilder()
+                    .addParameter("quickJs", QUICK_JS)
+                    .addParameter("name", STRING)
+                    .addParameter("instance", className)
+                    .addParameter(sharedPrototypeParameter())
+                    .build()
+            )
+            .addProperty(
+                PropertySpec.builder("instance", className, KModifier.PRIVATE)
+                    .initializer("instance")
+                    .build()
+            )
+            .addProperty(jsPropertiesSpec(properties))
+            .addProperty(jsFunctionsSpec(functions))
+            .addFunction(getterSpec(properties))
+            .addFunction(setterSpec(properties, types))
+            .addFunction(invokeSpec(functions, types))
+            .apply {
+                if (types.isNotEmpty()) {
+                    addType(types.toCompanionSpec())
+                }
+            }
+            .build()
+
+        val defineFunction = FunSpec.builder("define${className.simpleNames.joinToString("")}")
+            .addKdoc("Define the [%T] binding of [instance].", className)
+            .addModifiers(visibilityOf(cls))
+            .receiver(QUICK_JS)
+            .addParameter("name", STRING)
+            .addParameter("instance", className)
+            .addParameter(
+                ParameterSpec.builder("parent", JS_OBJECT_HANDLE)
+                    .defaultValue("%T.globalThis", JS_OBJECT_HANDLE)
+                    .build()
+            )
+            .addParameter(sharedPrototypeParameter())
+            .returns(JS_OBJECT_HANDLE)
+            .addStatement(
+                "return defineBinding(name = name, " +
+                        "binding = %T(this, name, instance, sharedPrototype), parent = parent)",
+                bindingClassName,
+            )
+            .build()
+
+        FileSpec.builder(bindingClassName)
+            .addFileComment("Generated by quickjs-kt-binding-ksp, do not edit.")
+            .addType(bindingClass)
+            .addFunction(defineFunction)
+            .build()
+            .writeTo(codeGenerator, Dependencies(aggregating = false, cls.containingFile!!))
+    }
+
+    private fun checkMembers(
+        cls: KSClassDeclaration,
+        properties: List<KSPropertyDeclaration>,
+        functions: List<KSFunctionDeclaration>,
+    ): Boolean {
+        var valid = true
+        val names = mutableSetOf<String>()
+        for (property in properties) {
+            names.add(property.simpleName.asString())
+        }
+        for (function in functions) {
+            val name = function.simpleName.asString()
+            if (!names.add(name)) {
+                logger.error("Overloaded or duplicate member '$name' is not supported.", function)
+                valid = false
+            }
+            if (function.typeParameters.isNotEmpty()) {
+                logger.error("Function '$name' can't have type parameters.", function)
+                valid = false
+            }
+            if (function.parameters.any { it.isVararg }) {
+                logger.error("Function '$name' can't have vararg parameters.", function)
+                valid = false
+            }
+        }
+        if (!valid) {
+            logger.error("Failed to generate the binding of ${cls.qualifiedName?.asString()}.")
+        }
+        return valid
+    }
+
+    private fun jsPropertiesSpec(properties: List<KSPropertyDeclaration>): PropertySpec {
+        val initializer = CodeBlock.builder().add("listOf(\n").indent()
+        for (property in properties) {
+            initializer.add(
+                "%T(name = %S, configurable = true, writable = %L, enumerable = true),\n",
+                JS_PROPERTY,
+                property.simpleName.asString(),
+                property.isWritable(),
+            )
+        }
+        initializer.unindent().add(")")
+        return PropertySpec.builder("properties", LIST.parameterizedBy(JS_PROPERTY))
+            .addModifiers(KModifier.OVERRIDE)
+            .initializer(initializer.build())
+            .build()
+    }
+
+    private fun jsFunctionsSpec(functions: List<KSFunctionDeclaration>): PropertySpec {
+        val initializer = CodeBlock.builder().add("listOf(\n").indent()
+        for (function in functions) {
+            initializer.add(
+                "%T(name = %S, isAsync = %L),\n",
+                JS_FUNCTION,
+                function.simpleName.asString(),
+                Modifier.SUSPEND in function.modifiers,
+            )
+        }
+        initializer.unindent().add(")")
+        return PropertySpec.builder("functions", LIST.parameterizedBy(JS_FUNCTION))
+            .addModifiers(KModifier.OVERRIDE)
+            .initializer(initializer.build())
+            .build()
+    }
+
+    private fun getterSpec(properties: List<KSPropertyDeclaration>): FunSpec {
+        val body = CodeBlock.builder().beginControlFlow("return when (name)")
+        for (property in properties) {
+            val name = property.simpleName.asString()
+            val value = CodeBlock.of("instance.%N", name)
+            body.addStatement("%S -> %L", name, resultOf(property.type.resolve(), value))
+        }
+        body.addStatement("else -> propertyNotFound(name)")
+        body.endControlFlow()
+        return FunSpec.builder("getter")
+            .addModifiers(KModifier.OVERRIDE)
+            .addParameter("name", STRING)
+            .returns(ANY.copy(nullable = true))
+            .addCode(body.build())
+            .build()
+    }
+
+    private fun setterSpec(properties: List<KSPropertyDeclaration>, types: TypeConstants): FunSpec {
+        val body = CodeBlock.builder().beginControlFlow("when (name)")
+        for (property in properties.filter { it.isWritable() }) {
+            val name = property.simpleName.asString()
+            val arg = argOf(property.type, CodeBlock.of("value"), types)
+            body.addStatement("%S -> instance.%N = %L", name, name, arg)
+        }
+        body.addStatement("else -> propertyNotWritable(name)")
+        body.endControlFlow()
+        return FunSpec.builder("setter")
+            .addModifiers(KModifier.OVERRIDE)
+            .addParameter("name", STRING)
+            .addParameter("value", ANY.copy(nullable = true))
+            .addCode(body.build())
+            .build()
+    }
+
+    private fun invokeSpec(functions: List<KSFunctionDeclaration>, types: TypeConstants): FunSpec {
+        val body = CodeBlock.builder().beginControlFlow("return when (name)")
+        for (function in functions) {
+            val name = function.simpleName.asString()
+            val isAsync = Modifier.SUSPEND in function.modifiers
+            // Arguments of async functions are decoded in the launched job, without the
+            // promise handles
+            val argsName = if (isAsync) "jsArgs" else "args"
+            val call = CodeBlock.builder().add("instance.%N(", name)
+            function.parameters.forEachIndexed { index, parameter ->
+                if (index > 0) call.add(", ")
+                val value = CodeBlock.of("%N[%L]", argsName, index)
+                call.add("%L", argOf(parameter.type, value, types))
+            }
+            call.add(")")
+            val returnType = function.returnType?.resolve()
+            val result = resultOf(returnType, call.build())
+            if (isAsync) {
+                body.beginControlFlow("%S -> launchAsync(args) { %N ->", name, argsName)
+            } else {
+                body.beginControlFlow("%S ->", name)
+            }
+            body.addStatement("checkArgCount(name, %N, %L)", argsName, function.parameters.size)
+            body.addStatement("%L", result)
+            body.endControlFlow()
+        }
+        body.addStatement("else -> functionNotFound(name)")
+        body.endControlFlow()
+        return FunSpec.builder("invoke")
+            .addModifiers(KModifier.OVERRIDE)
+            .addParameter("name", STRING)
+            .addParameter("args", ARRAY.parameterizedBy(ANY.copy(nullable = true)))
+            .returns(ANY.copy(nullable = true))
+            .addCode(body.build())
+            .build()
+    }
+
+    /**
+     * Values that the bridge passes for the type are cast directly, e.g. 'Long' for 'Int',
+     * other values are decoded by 'arg()' which also reports null values of non-null types.
+     */
+    private fun argOf(
+        typeRef: KSTypeReference,
+        value: CodeBlock,
+        types: TypeConstants,
+    ): CodeBlock {
+        val typeName = typeRef.toTypeName()
+        val type = types.constantOf(typeName)
+        val fallback = CodeBlock.of("arg<%T>(name, it, %N)", typeName, type)
+        val qualifiedName = typeRef.resolve().declaration.qualifiedName?.asString()
+        val (bridgeType, cast) = BRIDGE_ARG_CASTS[qualifiedName]
+            ?: return CodeBlock.of("arg(name, %L, %N)", value, type)
+        return CodeBlock.of(
+            "%L.let { if (it is %T) %L else %L }",
+            value,
+            bridgeType,
+            cast,
+            fallback,
+        )
+    }
+
+    /**
+     * Values of types that the bridge supports are returned as is, others are converted by type
+     * converters at runtime.
+     */
+    private fun resultOf(type: KSType?, expression: CodeBlock): CodeBlock {
+        val qualifiedName = type?.declaration?.qualifiedName?.asString()
+        return if (qualifiedName in BRIDGE_TYPES) {
+            CodeBlock.of("%L", expression)
+        } else {
+            CodeBlock.of("result(%L)", expression)
+        }
+    }
+
+    private fun KSPropertyDeclaration.isWritable(): Boolean {
+        return isMutable && setter?.modifiers?.contains(Modifier.PRIVATE) != true &&
+                setter?.modifiers?.contains(Modifier.PROTECTED) != true
+    }
+
+    private fun KSAnnotated.isIgnored(): Boolean {
+        return annotations.any {
+            it.shortName.asString() == "JsIgnore" &&
+                    it.annotationType.resolve().declaration.qualifiedName?.asString() == JS_IGNORE
+        }
+    }
+
+    private fun visibilityOf(cls: KSClassDeclaration): KModifier {
+        return if (cls.getVisibility() == Visibility.INTERNAL) {
+            KModifier.INTERNAL
+        } else {
+            KModifier.PUBLIC
+        }
+    }
+
+    private fun sharedPrototypeParameter(): ParameterSpec {
+        return ParameterSpec.builder("sharedPrototype", BOOLEAN)
+            .defaultValue("false")
+            .build()
+    }
+
+    private fun optInAnnotation(): AnnotationSpec {
+        return AnnotationSpec.builder(OPT_IN)
+            .addMember("%T::class", EXPERIMENTAL_QUICK_JS_API)
+            .build()
+    }
+
+    /**
+     * Types used to decode values, each one is created once in the companion object.
+     */
+    private class TypeConstants {
+        private val constants = linkedMapOf<TypeName, String>()
+
+        fun isNotEmpty(): Boolean = constants.isNotEmpty()
+
+        fun constantOf(type: TypeName): String {
+            return constants.getOrPut(type) { "TYPE_${constants.size}" }
+        }
+
+        fun toCompanionSpec(): TypeSpec {
+            val builder = TypeSpec.companionObjectBuilder().addModifiers(KModifier.PRIVATE)
+            for ((type, name) in constants) {
+                builder.addProperty(
+                    PropertySpec.builder(name, K_TYPE)
+                        .initializer("%M<%T>()", TYPE_OF, type)
+                        .build()
+                )
+            }
+            return builder.build()
+        }
+    }
+
+    private companion object {
+        const val JS_BINDING = "com.dokar.quickjs.binding.JsBinding"
+        const val JS_IGNORE = "com.dokar.quickjs.binding.JsIgnore"
+
+        val QUICK_JS = ClassName("com.dokar.quickjs", "QuickJs")
+        val EXPERIMENTAL_QUICK_JS_API = ClassName("com.dokar.quickjs", "ExperimentalQuickJsApi")
+        val GENERATED_OBJECT_BINDING =
+            ClassName("com.dokar.quickjs.binding", "GeneratedObjectBinding")
+        val JS_OBJECT_HANDLE = ClassName("com.dokar.quickjs.binding", "JsObjectHandle")
+        val JS_PROPERTY = ClassName("com.dokar.quickjs.binding", "JsProperty")
+        val JS_FUNCTION = ClassName("com.dokar.quickjs.binding", "JsFunction")
+        val OPT_IN = ClassName("kotlin", "OptIn")
+        val K_TYPE = ClassName("kotlin.reflect", "KType")
+        val TYPE_OF = MemberName("kotlin.reflect", "typeOf")
+
+        // Keep in sync with 'canConvertReturnInternally()'
+        val BRIDGE_TYPES = setOf(
+            UNIT.canonicalName,
+            "kotlin.Byte",
+            "kotlin.Short",
+            "kotlin.Int",
+            "kotlin.Long",
+            "kotlin.Float",
+            "kotlin.Double",
+            "kotlin.Boolean",
+            "kotlin.String",
+            "kotlin.ByteArray",
+            "kotlin.UByteArray",
+        )
+
+        // Parameter type -> (the type passed by the bridge, the cast of 'it')
+        val BRIDGE_ARG_CASTS = mapOf(
+            "kotlin.Boolean" to (BOOLEAN to CodeBlock.of("it")),
+            "kotlin.String" to (STRING to CodeBlock.of("it")),
+            "kotlin.ByteArray" to (BYTE_ARRAY to CodeBlock.of("it")),
+            "kotlin.Long" to (LONG to CodeBlock.of("it")),
+            "kotlin.Int" to (LONG to CodeBlock.of("intArg(it)")),
+            "kotlin.Short" to (LONG to CodeBlock.of("shortArg(it)")),
+            "kotlin.Byte" to (LONG to CodeBlock.of("byteArg(it)")),
+            "kotlin.Double" to (DOUBLE to CodeBlock.of("it")),
+            "kotlin.Float" to (DOUBLE to CodeBlock.of("floatArg(it)")),
+        )
+    }
+}
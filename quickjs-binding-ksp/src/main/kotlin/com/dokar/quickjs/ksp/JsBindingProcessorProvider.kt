@@ -0,0 +1,14 @@
+package com.dokar.quickjs.ksp
+
+import com.google.devtools.ksp.processing.SymbolProcessor
+import com.google.devtools.ksp.processing.SymbolProcessorEnvironment
+import com.google.devtools.ksp.processing.SymbolProcessorProvider
+
+class JsBindingProcessorProvider : SymbolProcessorProvider {
+    override fun create(environment: SymbolProcessorEnvironment): SymbolProcessor {
+        return JsBindingProcessor(
+            codeGenerator = environment.codeGenerator,
+            logger = environment.logger,
+        )
+    }
+}
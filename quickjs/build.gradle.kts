@@ -1,12 +1,15 @@
 /// Based on https://github.com/cashapp/zipline/blob/trunk/zipline/build.gradle.kts
 import com.dokar.quickjs.applyQuickJsNativeBuildTasks
 import com.dokar.quickjs.disableUnsupportedPlatformTasks
+import com.dokar.quickjs.isAddressSanitizerEnabled
 import org.jetbrains.kotlin.gradle.plugin.mpp.KotlinNativeTarget
+import org.jetbrains.kotlin.gradle.plugin.mpp.TestExecutable
 
 plugins {
     alias(libs.plugins.kotlinMultiplatform)
     alias(libs.plugins.androidLibrary)
     alias(libs.plugins.mavenPublish)
+    alias(libs.plugins.ksp)
 }
 
 kotlin {
@@ -53,6 +56,12 @@ kotlin {
         val jvmTest by getting {
             dependsOn(commonTest.get())
             kotlin.srcDir("src/jniTest/kotlin/")
+            kotlin.srcDir("src/kspTest/kotlin/")
+        }
+
+        // Tests of generated bindings, on the targets that run the processor
+        val linuxX64Test by getting {
+            kotlin.srcDir("src/kspTest/kotlin/")
         }
 
         val androidMain by getting {
@@ -60,6 +69,14 @@ kotlin {
         }
 
         targets.withType<KotlinNativeTarget> {
+            if (isAddressSanitizerEnabled()) {
+                binaries.all {
+                    if (this is TestExecutable) {
+                        binaryOption("sanitizer", "address")
+                    }
+                }
+            }
+
             val main by compilations.getting
 
             main.cinterops {
@@ -67,6 +84,16 @@ kotlin {
                     headers(
                         file("native/quickjs/quickjs.h"),
                         file("native/common/quickjs_version.h"),
+                        file("native/common/memory_accounting.h"),
+                        file("native/common/clock_util.h"),
+                        file("native/common/binding_stats.h"),
+                        file("native/common/sampling_profiler.h"),
+                        file("native/common/latency_histogram.h"),
+                        file("native/common/gc_stats.h"),
+                        file("native/common/atom_hook.h"),
+                        file("native/common/runtime_hooks.h"),
+                        file("native/common/timed_eval.h"),
+                        file("native/common/opcode_stats.h"),
                     )
                     packageName("quickjs")
                 }
@@ -140,6 +167,12 @@ android {
     }
 }
 
+dependencies {
+    // Generated bindings are tested on the JVM and Kotlin/Native
+    add("kspJvmTest", projects.quickjsBindingKsp)
+    add("kspLinuxX64Test", projects.quickjsBindingKsp)
+}
+
 applyQuickJsNativeBuildTasks(cmakeFile)
 
 disableUnsupportedPlatformTasks()
@@ -0,0 +1,38 @@
+package com.dokar.quickjs;
+
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * The call host of the bridge benchmark, it replaces the library class so upcalls only cost
+ * a map lookup. Keep the upcall signatures in sync with 'generateJniGlobalsCFiles.mjs'.
+ */
+public final class QuickJs {
+    /**
+     * Values returned by getters, keyed by the property name.
+     */
+    public final Map<String, Object> getterResults = new HashMap<>();
+
+    public Object onCallGetter(long handle, String name) {
+        return getterResults.get(name);
+    }
+
+    public void onCallSetter(long handle, String name, Object value) {
+    }
+
+    public Object onCallFunction(long handle, String name, Object[] args) {
+        return null;
+    }
+
+    public void setEvalException(Throwable throwable) {
+    }
+
+    public void setUnhandledPromiseRejection(Object reason) {
+    }
+
+    public void onBindingFinalized(long handle) {
+    }
+
+    public void onThresholdGc(boolean isEnd) {
+    }
+}
@@ -0,0 +1,7 @@
+package com.dokar.quickjs;
+
+public final class QuickJsException extends RuntimeException {
+    public QuickJsException(String message) {
+        super(message);
+    }
+}
@@ -0,0 +1,11 @@
+package com.dokar.quickjs.binding;
+
+public final class JsFunction {
+    public final String name;
+    public final boolean isAsync;
+
+    public JsFunction(String name, boolean isAsync) {
+        this.name = name;
+        this.isAsync = isAsync;
+    }
+}
@@ -0,0 +1,10 @@
+package com.dokar.quickjs.binding;
+
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+public final class JsObject extends LinkedHashMap<String, Object> {
+    public JsObject(Map<String, Object> map) {
+        super(map);
+    }
+}
@@ -0,0 +1,19 @@
+package com.dokar.quickjs.binding;
+
+public final class JsProperty {
+    public final String name;
+    public final boolean configurable;
+    public final boolean writable;
+    public final boolean enumerable;
+    public final boolean isConstant;
+    public final Object value;
+
+    public JsProperty(String name, boolean configurable, boolean writable, boolean enumerable) {
+        this.name = name;
+        this.configurable = configurable;
+        this.writable = writable;
+        this.enumerable = enumerable;
+        this.isConstant = false;
+        this.value = null;
+    }
+}
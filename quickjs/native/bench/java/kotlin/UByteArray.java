@@ -0,0 +1,12 @@
+package kotlin;
+
+/**
+ * Same layout as the inline class of the Kotlin stdlib, so the stdlib is not needed.
+ */
+public final class UByteArray {
+    private final byte[] storage;
+
+    public UByteArray(byte[] storage) {
+        this.storage = storage;
+    }
+}
@@ -0,0 +1,531 @@
+/**
+ * Microbenchmark of the JNI bridge, it times the C conversions and the getter dispatch on an
+ * embedded JVM, without the Kotlin side of the library.
+ *
+ * Upcalls go to the stub classes in 'java/', so the host cost of a getter is a map lookup.
+ *
+ * Usage: jni_bridge_bench [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jni.h"
+#include "quickjs.h"
+#include "clock_util.h"
+#include "js_value_to_jobject.h"
+#include "jobject_to_js_value.h"
+
+#ifndef QJS_KT_JNI_BENCH_CLASSPATH
+#error "QJS_KT_JNI_BENCH_CLASSPATH is not defined."
+#endif
+
+#define DEFAULT_ITERATIONS 100000
+#define BINDING_PROPERTY_COUNT 10
+#define BINDING_FUNCTION_COUNT 5
+#define TREE_OBJECT_COUNT 80
+
+// JNI entry points of the bridge, called directly like the JVM does
+JNIEXPORT jlong JNICALL Java_com_dokar_quickjs_QuickJs_newRuntime(JNIEnv *env, jobject this,
+                                                                  jboolean accounted);
+
+JNIEXPORT jlong JNICALL
+Java_com_dokar_quickjs_QuickJs_newContext(JNIEnv *env, jobject this, jlong runtime_ptr);
+
+JNIEXPORT jlong JNICALL
+Java_com_dokar_quickjs_QuickJs_initGlobals(JNIEnv *env, jobject this, jlong runtime_ptr);
+
+JNIEXPORT jlong JNICALL
+Java_com_dokar_quickjs_QuickJs_defineObject(JNIEnv *env, jobject this,
+                                            jlong globals_ptr,
+                                            jlong context_ptr,
+                                            jlong parent,
+                                            jstring name,
+                                            jobjectArray properties,
+                                            jobjectArray function_names,
+                                            jstring prototype_key);
+
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_defineObjectTree(JNIEnv *env, jobject this,
+                                                jlong globals_ptr,
+                                                jlong context_ptr,
+                                                jlong parent,
+                                                jbyteArray tree,
+                                                jobjectArray values,
+                                                jlongArray handles);
+
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_releaseGlobals(JNIEnv *env, jobject this, jlong context_ptr,
+                                              jlong globals_ptr);
+
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_releaseContext(JNIEnv *env, jobject this, jlong context_ptr);
+
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_releaseRuntime(JNIEnv *env, jobject this, jlong runtime_ptr);
+
+/**
+ * Fixed payloads, each one is converted in both directions and returned by a getter.
+ */
+typedef struct {
+    const char *name;
+    const char *source;
+} Payload;
+
+static const Payload payloads[] = {
+        {"int",         "42"},
+        {"double",      "3.14159"},
+        {"boolean",     "true"},
+        {"asciiString", "'quickjs-kt'"},
+        {"longString",  "'abcdefghijklmnopqrstuvwxyz'.repeat(40)"},
+        {"bmpString",   "'\\u4f60\\u597d\\u4e16\\u754c'.repeat(64)"},
+        {"intArray",    "Array.from({ length: 100 }, (_, i) => i)"},
+        {"flatObject",  "Object.fromEntries(Array.from({ length: 10 }, (_, i) => ['k' + i, i]))"},
+        {"nestedObject",
+                        "({ id: 1, name: 'item', tags: ['a', 'b', 'c'], "
+                        "meta: { created: 1700000000, scores: [1.5, 2.5, 3.5] } })"},
+        {"uint8Array",  "new Uint8Array(4096).fill(7)"},
+};
+
+#define PAYLOAD_COUNT (sizeof(payloads) / sizeof(payloads[0]))
+
+typedef struct {
+    JNIEnv *env;
+    jobject host;
+    jlong runtime;
+    jlong context;
+    jlong globals;
+    int iterations;
+} Bench;
+
+static void check_java_exception(JNIEnv *env, const char *operation) {
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionDescribe(env);
+        fprintf(stderr, "Java exception thrown by '%s'.\n", operation);
+        exit(1);
+    }
+}
+
+static void check_js_exception(JSContext *context, JSValue value, const char *operation) {
+    if (!JS_IsException(value)) {
+        return;
+    }
+    JSValue exception = JS_GetException(context);
+    const char *message = JS_ToCString(context, exception);
+    fprintf(stderr, "JS exception thrown by '%s': %s\n", operation, message);
+    JS_FreeCString(context, message);
+    JS_FreeValue(context, exception);
+    exit(1);
+}
+
+static void print_result(const char *group, const char *name, int64_t elapsed_ns, int64_t ops) {
+    char label[128];
+    snprintf(label, sizeof(label), "%s.%s", group, name);
+    printf("%-40s %12.1f ns/op\n", label, (double) elapsed_ns / (double) ops);
+}
+
+static JSValue eval_payload(JSContext *context, const Payload *payload) {
+    JSValue value = JS_Eval(context, payload->source, strlen(payload->source), "<payload>",
+                            JS_EVAL_TYPE_GLOBAL);
+    check_js_exception(context, value, payload->name);
+    return value;
+}
+
+static void bench_js_value_to_jobject(Bench *bench) {
+    JNIEnv *env = bench->env;
+    JSContext *context = (JSContext *) bench->context;
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        JSValue value = eval_payload(context, &payloads[i]);
+        int64_t start = 0;
+        // The first half warms up
+        for (int n = 0; n < bench->iterations * 2; n++) {
+            if (n == bench->iterations) {
+                start = qjs_now_ns();
+            }
+            jobject result = js_value_to_jobject(env, context, value);
+            check_java_exception(env, "js_value_to_jobject");
+            (*env)->DeleteLocalRef(env, result);
+        }
+        print_result("js_value_to_jobject", payloads[i].name, qjs_now_ns() - start,
+                     bench->iterations);
+        JS_FreeValue(context, value);
+    }
+}
+
+static void bench_jobject_to_js_value(Bench *bench) {
+    JNIEnv *env = bench->env;
+    JSContext *context = (JSContext *) bench->context;
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        JSValue value = eval_payload(context, &payloads[i]);
+        jobject payload = js_value_to_jobject(env, context, value);
+        check_java_exception(env, "js_value_to_jobject");
+        JS_FreeValue(context, value);
+        int64_t start = 0;
+        for (int n = 0; n < bench->iterations * 2; n++) {
+            if (n == bench->iterations) {
+                start = qjs_now_ns();
+            }
+            JSValue result = jobject_to_js_value(env, context, NULL, payload);
+            check_js_exception(context, result, "jobject_to_js_value");
+            JS_FreeValue(context, result);
+        }
+        print_result("jobject_to_js_value", payloads[i].name, qjs_now_ns() - start,
+                     bench->iterations);
+        (*env)->DeleteLocalRef(env, payload);
+    }
+}
+
+static jobjectArray new_properties(JNIEnv *env, int count) {
+    jclass cls = (*env)->FindClass(env, "com/dokar/quickjs/binding/JsProperty");
+    jmethodID init = (*env)->GetMethodID(env, cls, "<init>", "(Ljava/lang/String;ZZZ)V");
+    jobjectArray array = (*env)->NewObjectArray(env, count, cls, NULL);
+    for (int i = 0; i < count; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "prop%d", i);
+        jstring j_name = (*env)->NewStringUTF(env, name);
+        jobject property = (*env)->NewObject(env, cls, init, j_name, JNI_TRUE, i % 2 == 0,
+                                             JNI_TRUE);
+        (*env)->SetObjectArrayElement(env, array, i, property);
+        (*env)->DeleteLocalRef(env, property);
+        (*env)->DeleteLocalRef(env, j_name);
+    }
+    (*env)->DeleteLocalRef(env, cls);
+    check_java_exception(env, "new_properties");
+    return array;
+}
+
+static jobjectArray new_functions(JNIEnv *env, int count) {
+    jclass cls = (*env)->FindClass(env, "com/dokar/quickjs/binding/JsFunction");
+    jmethodID init = (*env)->GetMethodID(env, cls, "<init>", "(Ljava/lang/String;Z)V");
+    jobjectArray array = (*env)->NewObjectArray(env, count, cls, NULL);
+    for (int i = 0; i < count; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "func%d", i);
+        jstring j_name = (*env)->NewStringUTF(env, name);
+        jobject function = (*env)->NewObject(env, cls, init, j_name, JNI_FALSE);
+        (*env)->SetObjectArrayElement(env, array, i, function);
+        (*env)->DeleteLocalRef(env, function);
+        (*env)->DeleteLocalRef(env, j_name);
+    }
+    (*env)->DeleteLocalRef(env, cls);
+    check_java_exception(env, "new_functions");
+    return array;
+}
+
+static void bench_define_js_object(Bench *bench) {
+    JNIEnv *env = bench->env;
+    // Defined objects are kept until releasing globals, so use fewer iterations
+    int iterations = bench->iterations / 10 > 0 ? bench->iterations / 10 : 1;
+    jobjectArray empty_properties = new_properties(env, 0);
+    jobjectArray empty_functions = new_functions(env, 0);
+    jobjectArray properties = new_properties(env, BINDING_PROPERTY_COUNT);
+    jobjectArray functions = new_functions(env, BINDING_FUNCTION_COUNT);
+    jstring name = (*env)->NewStringUTF(env, "definedObject");
+    jstring prototype_key = (*env)->NewStringUTF(env, "DefinedObject");
+
+    struct {
+        const char *name;
+        jobjectArray properties;
+        jobjectArray functions;
+        jstring prototype_key;
+    } cases[] = {
+            {"empty",                        empty_properties, empty_functions, NULL},
+            {"10Properties5Functions",       properties,       functions,       NULL},
+            {"10Properties5FunctionsShared", properties,       functions,       prototype_key},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        int64_t start = 0;
+        for (int n = 0; n < iterations * 2; n++) {
+            if (n == iterations) {
+                start = qjs_now_ns();
+            }
+            Java_com_dokar_quickjs_QuickJs_defineObject(env, bench->host, bench->globals,
+                                                        bench->context, -1, name,
+                                                        cases[i].properties,
+                                                        cases[i].functions,
+                                                        cases[i].prototype_key);
+            check_java_exception(env, "define_js_object");
+        }
+        print_result("define_js_object", cases[i].name, qjs_now_ns() - start, iterations);
+    }
+
+    (*env)->DeleteLocalRef(env, prototype_key);
+    (*env)->DeleteLocalRef(env, name);
+    (*env)->DeleteLocalRef(env, functions);
+    (*env)->DeleteLocalRef(env, properties);
+    (*env)->DeleteLocalRef(env, empty_functions);
+    (*env)->DeleteLocalRef(env, empty_properties);
+}
+
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+} TreeBuffer;
+
+static void tree_write(TreeBuffer *buffer, const void *bytes, size_t len) {
+    if (buffer->length + len > buffer->capacity) {
+        buffer->capacity = (buffer->length + len) * 2;
+        buffer->data = realloc(buffer->data, buffer->capacity);
+    }
+    memcpy(buffer->data + buffer->length, bytes, len);
+    buffer->length += len;
+}
+
+static void tree_write_u32(TreeBuffer *buffer, uint32_t value) {
+    uint8_t bytes[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF,
+                        (value >> 24) & 0xFF};
+    tree_write(buffer, bytes, sizeof(bytes));
+}
+
+static void tree_write_str(TreeBuffer *buffer, const char *str) {
+    size_t len = strlen(str);
+    tree_write_u32(buffer, (uint32_t) len);
+    tree_write(buffer, str, len + 1);
+}
+
+/**
+ * Encode a tree of nested objects with the members of bench_define_js_object(), like the
+ * Kotlin side does for DSL scopes. The parent of object 'i' is object '(i - 1) / 4'.
+ */
+static jbyteArray new_object_tree(JNIEnv *env) {
+    TreeBuffer buffer = {0};
+    char name[32];
+    tree_write_u32(&buffer, TREE_OBJECT_COUNT);
+    for (int i = 0; i < TREE_OBJECT_COUNT; i++) {
+        tree_write_u32(&buffer, i == 0 ? (uint32_t) -1 : (uint32_t) (i - 1) / 4);
+        snprintf(name, sizeof(name), "object%d", i);
+        tree_write_str(&buffer, name);
+        // No prototype key
+        uint8_t no_key = 0;
+        tree_write(&buffer, &no_key, 1);
+        tree_write_u32(&buffer, BINDING_PROPERTY_COUNT);
+        for (int n = 0; n < BINDING_PROPERTY_COUNT; n++) {
+            snprintf(name, sizeof(name), "prop%d", n);
+            tree_write_str(&buffer, name);
+            // Configurable, enumerable, and writable for even ones
+            uint8_t flags = 1 | 4 | (n % 2 == 0 ? 2 : 0);
+            tree_write(&buffer, &flags, 1);
+        }
+        tree_write_u32(&buffer, BINDING_FUNCTION_COUNT);
+        for (int n = 0; n < BINDING_FUNCTION_COUNT; n++) {
+            snprintf(name, sizeof(name), "func%d", n);
+            tree_write_str(&buffer, name);
+            uint8_t flags = 0;
+            tree_write(&buffer, &flags, 1);
+        }
+    }
+    jbyteArray tree = (*env)->NewByteArray(env, (jsize) buffer.length);
+    (*env)->SetByteArrayRegion(env, tree, 0, (jsize) buffer.length, (const jbyte *) buffer.data);
+    free(buffer.data);
+    check_java_exception(env, "new_object_tree");
+    return tree;
+}
+
+/**
+ * Define the same nested objects with one call per object, and with one tree call.
+ */
+static void bench_define_js_object_tree(Bench *bench) {
+    JNIEnv *env = bench->env;
+    // Defined objects are kept until releasing globals, so use fewer iterations
+    int iterations = bench->iterations / 100 > 0 ? bench->iterations / 100 : 1;
+    jobjectArray properties = new_properties(env, BINDING_PROPERTY_COUNT);
+    jobjectArray functions = new_functions(env, BINDING_FUNCTION_COUNT);
+    jbyteArray tree = new_object_tree(env);
+    jlongArray handles = (*env)->NewLongArray(env, TREE_OBJECT_COUNT);
+    jstring names[TREE_OBJECT_COUNT];
+    for (int i = 0; i < TREE_OBJECT_COUNT; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "object%d", i);
+        names[i] = (*env)->NewStringUTF(env, name);
+    }
+
+    int64_t start = 0;
+    jlong object_handles[TREE_OBJECT_COUNT];
+    for (int n = 0; n < iterations * 2; n++) {
+        if (n == iterations) {
+            start = qjs_now_ns();
+        }
+        for (int i = 0; i < TREE_OBJECT_COUNT; i++) {
+            jlong parent = i == 0 ? -1 : object_handles[(i - 1) / 4];
+            object_handles[i] = Java_com_dokar_quickjs_QuickJs_defineObject(
+                    env, bench->host, bench->globals, bench->context, parent, names[i],
+                    properties, functions, NULL);
+            check_java_exception(env, "define_js_object");
+        }
+    }
+    print_result("define_js_object_tree", "80ObjectsPerCall", qjs_now_ns() - start, iterations);
+
+    for (int n = 0; n < iterations * 2; n++) {
+        if (n == iterations) {
+            start = qjs_now_ns();
+        }
+        Java_com_dokar_quickjs_QuickJs_defineObjectTree(env, bench->host, bench->globals,
+                                                        bench->context, -1, tree, NULL,
+                                                        handles);
+        check_java_exception(env, "define_js_object_tree");
+    }
+    print_result("define_js_object_tree", "80ObjectsTree", qjs_now_ns() - start, iterations);
+
+    for (int i = 0; i < TREE_OBJECT_COUNT; i++) {
+        (*env)->DeleteLocalRef(env, names[i]);
+    }
+    (*env)->DeleteLocalRef(env, handles);
+    (*env)->DeleteLocalRef(env, tree);
+    (*env)->DeleteLocalRef(env, functions);
+    (*env)->DeleteLocalRef(env, properties);
+}
+
+/**
+ * Time a JS loop that reads the property of 'target', the cost of the loop itself is timed
+ * with a plain data property and subtracted.
+ */
+static int64_t time_property_reads(JSContext *context, JSValue target, const char *property,
+                                   int iterations) {
+    char source[256];
+    snprintf(source, sizeof(source),
+             "(function (o, n) { let r; for (let i = 0; i < n; i++) r = o.%s; return r; })",
+             property);
+    JSValue loop = JS_Eval(context, source, strlen(source), "<loop>", JS_EVAL_TYPE_GLOBAL);
+    check_js_exception(context, loop, "getter loop");
+    JSValue args[2] = {target, JS_NewInt32(context, iterations)};
+    // Warm up
+    JSValue result = JS_Call(context, loop, JS_UNDEFINED, 2, args);
+    check_js_exception(context, result, property);
+    JS_FreeValue(context, result);
+    int64_t start = qjs_now_ns();
+    result = JS_Call(context, loop, JS_UNDEFINED, 2, args);
+    int64_t elapsed = qjs_now_ns() - start;
+    check_js_exception(context, result, property);
+    JS_FreeValue(context, result);
+    JS_FreeValue(context, loop);
+    return elapsed;
+}
+
+static void bench_property_getter(Bench *bench) {
+    JNIEnv *env = bench->env;
+    JSContext *context = (JSContext *) bench->context;
+
+    // Getter results of the host, converted from the JS payloads
+    jclass host_cls = (*env)->GetObjectClass(env, bench->host);
+    jfieldID field_results = (*env)->GetFieldID(env, host_cls, "getterResults", "Ljava/util/Map;");
+    jobject results = (*env)->GetObjectField(env, bench->host, field_results);
+    jclass map_cls = (*env)->FindClass(env, "java/util/Map");
+    jmethodID map_put = (*env)->GetMethodID(env, map_cls, "put",
+                                            "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+
+    jclass property_cls = (*env)->FindClass(env, "com/dokar/quickjs/binding/JsProperty");
+    jmethodID property_init = (*env)->GetMethodID(env, property_cls, "<init>",
+                                                  "(Ljava/lang/String;ZZZ)V");
+    jobjectArray properties = (*env)->NewObjectArray(env, PAYLOAD_COUNT, property_cls, NULL);
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        JSValue value = eval_payload(context, &payloads[i]);
+        jobject payload = js_value_to_jobject(env, context, value);
+        JS_FreeValue(context, value);
+        jstring j_name = (*env)->NewStringUTF(env, payloads[i].name);
+        jobject previous = (*env)->CallObjectMethod(env, results, map_put, j_name, payload);
+        jobject property = (*env)->NewObject(env, property_cls, property_init, j_name,
+                                             JNI_TRUE, JNI_FALSE, JNI_TRUE);
+        (*env)->SetObjectArrayElement(env, properties, (jsize) i, property);
+        (*env)->DeleteLocalRef(env, property);
+        (*env)->DeleteLocalRef(env, previous);
+        (*env)->DeleteLocalRef(env, j_name);
+        (*env)->DeleteLocalRef(env, payload);
+    }
+    check_java_exception(env, "getter results");
+
+    jobjectArray functions = new_functions(env, 0);
+    jstring name = (*env)->NewStringUTF(env, "host");
+    Java_com_dokar_quickjs_QuickJs_defineObject(env, bench->host, bench->globals,
+                                                bench->context, -1, name, properties, functions,
+                                                NULL);
+    check_java_exception(env, "define_js_object");
+
+    JSValue global_this = JS_GetGlobalObject(context);
+    JSValue host_object = JS_GetPropertyStr(context, global_this, "host");
+    JSValue plain_object = JS_NewObject(context);
+    JS_SetPropertyStr(context, plain_object, "value", JS_NewInt32(context, 42));
+
+    int64_t loop_ns = time_property_reads(context, plain_object, "value", bench->iterations);
+    print_result("property_getter", "(loop)", loop_ns, bench->iterations);
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        int64_t elapsed = time_property_reads(context, host_object, payloads[i].name,
+                                              bench->iterations);
+        print_result("property_getter", payloads[i].name, elapsed - loop_ns, bench->iterations);
+    }
+
+    JS_FreeValue(context, plain_object);
+    JS_FreeValue(context, host_object);
+    JS_FreeValue(context, global_this);
+
+    (*env)->DeleteLocalRef(env, name);
+    (*env)->DeleteLocalRef(env, functions);
+    (*env)->DeleteLocalRef(env, properties);
+    (*env)->DeleteLocalRef(env, property_cls);
+    (*env)->DeleteLocalRef(env, map_cls);
+    (*env)->DeleteLocalRef(env, results);
+    (*env)->DeleteLocalRef(env, host_cls);
+}
+
+static JavaVM *create_java_vm(JNIEnv **env) {
+    JavaVMOption options[1];
+    options[0].optionString = "-Djava.class.path=" QJS_KT_JNI_BENCH_CLASSPATH;
+    JavaVMInitArgs args;
+    args.version = JNI_VERSION_1_8;
+    args.nOptions = 1;
+    args.options = options;
+    args.ignoreUnrecognized = JNI_FALSE;
+    JavaVM *vm = NULL;
+    if (JNI_CreateJavaVM(&vm, (void **) env, &args) != JNI_OK) {
+        return NULL;
+    }
+    return vm;
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    JNIEnv *env = NULL;
+    JavaVM *vm = create_java_vm(&env);
+    if (vm == NULL) {
+        fprintf(stderr, "Failed to create the JVM.\n");
+        return 1;
+    }
+
+    jclass host_cls = (*env)->FindClass(env, "com/dokar/quickjs/QuickJs");
+    check_java_exception(env, "FindClass");
+    jmethodID host_init = (*env)->GetMethodID(env, host_cls, "<init>", "()V");
+    jobject host = (*env)->NewObject(env, host_cls, host_init);
+    check_java_exception(env, "NewObject");
+
+    // Same setup as the library does
+    Bench bench = {
+            .env = env,
+            .host = host,
+            .iterations = iterations,
+    };
+    bench.runtime = Java_com_dokar_quickjs_QuickJs_newRuntime(env, host, JNI_FALSE);
+    bench.context = Java_com_dokar_quickjs_QuickJs_newContext(env, host, bench.runtime);
+    bench.globals = Java_com_dokar_quickjs_QuickJs_initGlobals(env, host, bench.runtime);
+    check_java_exception(env, "initGlobals");
+
+    printf("iterations: %d\n", iterations);
+    bench_js_value_to_jobject(&bench);
+    bench_jobject_to_js_value(&bench);
+    bench_define_js_object(&bench);
+    bench_define_js_object_tree(&bench);
+    bench_property_getter(&bench);
+
+    Java_com_dokar_quickjs_QuickJs_releaseGlobals(env, host, bench.context, bench.globals);
+    Java_com_dokar_quickjs_QuickJs_releaseContext(env, host, bench.context);
+    Java_com_dokar_quickjs_QuickJs_releaseRuntime(env, host, bench.runtime);
+
+    (*env)->DeleteLocalRef(env, host);
+    (*env)->DeleteLocalRef(env, host_cls);
+    (*vm)->DestroyJavaVM(vm);
+    return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef QJS_KT_ATOM_HOOK_H
+#define QJS_KT_ATOM_HOOK_H
+
+#include "quickjs.h"
+
+/**
+ * Grow the atom hash of the runtime so that count more atoms can be created without resizing
+ * it. Returns 0 on success, -1 if the allocation failed, the hash is unchanged in that case.
+ *
+ * Appended to quickjs.c by CMakeLists.txt, see atom_hook.c.in.
+ */
+int JS_ReserveAtoms(JSRuntime *rt, int count);
+
+#endif //QJS_KT_ATOM_HOOK_H
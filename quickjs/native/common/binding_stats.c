@@ -0,0 +1,294 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "binding_stats.h"
+
+#define CHUNK_SIZE 256
+
+#define MAX_CHUNKS 64
+
+#define INITIAL_INDEX_CAPACITY 64
+
+typedef struct {
+    LatencyHistogram arg_conversion;
+    LatencyHistogram host_execution;
+    LatencyHistogram result_conversion;
+} SlotHistograms;
+
+typedef struct {
+    char *name;
+    int call_type;
+    int64_t call_count;
+    int64_t error_count;
+    /**
+     * Allocated on the first recorded call.
+     */
+    SlotHistograms *histograms;
+    /**
+     * Counters of the evaluation, they are stale if the generation is not the current one.
+     */
+    int64_t eval_generation;
+    int64_t eval_call_count;
+    int64_t eval_total_ns;
+} Slot;
+
+struct BindingStats {
+    int enabled;
+    int eval_tracking;
+    /**
+     * Increased when an evaluation begins, so counters are reset lazily.
+     */
+    int64_t eval_generation;
+    int32_t slot_count;
+    /**
+     * Chunks never move, so slots can be accessed without locks.
+     */
+    Slot *chunks[MAX_CHUNKS];
+    /**
+     * Open addressing index of slots by name and call type, -1 for empty entries. Accessed only
+     * while registering.
+     */
+    int32_t *index;
+    int32_t index_capacity;
+    /**
+     * Protect registration.
+     */
+    pthread_mutex_t mutex;
+};
+
+static inline Slot *slot_at(BindingStats *stats, int32_t slot) {
+    return &stats->chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE];
+}
+
+BindingStats *binding_stats_new() {
+    BindingStats *stats = calloc(1, sizeof(BindingStats));
+    if (stats == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&stats->mutex, NULL);
+    return stats;
+}
+
+void binding_stats_free(BindingStats *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    for (int32_t i = 0; i < stats->slot_count; i++) {
+        Slot *slot = slot_at(stats, i);
+        free(slot->name);
+        free(slot->histograms);
+    }
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        free(stats->chunks[i]);
+    }
+    free(stats->index);
+    pthread_mutex_destroy(&stats->mutex);
+    free(stats);
+}
+
+void binding_stats_set_enabled(BindingStats *stats, int enabled) {
+    __atomic_store_n(&stats->enabled, enabled, __ATOMIC_RELAXED);
+}
+
+int binding_stats_is_enabled(BindingStats *stats) {
+    return stats != NULL && __atomic_load_n(&stats->enabled, __ATOMIC_RELAXED);
+}
+
+void binding_stats_set_eval_tracking(BindingStats *stats, int enabled) {
+    __atomic_store_n(&stats->eval_tracking, enabled, __ATOMIC_RELAXED);
+}
+
+int binding_stats_is_timing(BindingStats *stats) {
+    return stats != NULL && (__atomic_load_n(&stats->enabled, __ATOMIC_RELAXED) ||
+                             __atomic_load_n(&stats->eval_tracking, __ATOMIC_RELAXED));
+}
+
+void binding_stats_begin_eval(BindingStats *stats) {
+    stats->eval_generation++;
+}
+
+static uint32_t slot_hash(const char *name, int call_type) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const char *c = name; *c != '\0'; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619u;
+    }
+    return (hash ^ (uint32_t) call_type) * 16777619u;
+}
+
+/**
+ * Find the index entry of the name, which is either the slot or an empty entry.
+ */
+static int32_t *find_index_entry(BindingStats *stats, const char *name, int call_type) {
+    uint32_t mask = (uint32_t) stats->index_capacity - 1;
+    uint32_t i = slot_hash(name, call_type) & mask;
+    while (1) {
+        int32_t *entry = &stats->index[i];
+        if (*entry < 0) {
+            return entry;
+        }
+        Slot *slot = slot_at(stats, *entry);
+        if (slot->call_type == call_type && strcmp(slot->name, name) == 0) {
+            return entry;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/**
+ * Make sure the index has room for one more slot.
+ */
+static int reserve_index(BindingStats *stats) {
+    if (stats->index != NULL && (stats->slot_count + 1) * 2 <= stats->index_capacity) {
+        return 0;
+    }
+    int32_t capacity = stats->index != NULL ? stats->index_capacity * 2 : INITIAL_INDEX_CAPACITY;
+    int32_t *index = malloc(sizeof(int32_t) * capacity);
+    if (index == NULL) {
+        return -1;
+    }
+    memset(index, 0xFF, sizeof(int32_t) * capacity);
+    int32_t *old_index = stats->index;
+    stats->index = index;
+    stats->index_capacity = capacity;
+    for (int32_t i = 0; i < stats->slot_count; i++) {
+        Slot *slot = slot_at(stats, i);
+        *find_index_entry(stats, slot->name, slot->call_type) = i;
+    }
+    free(old_index);
+    return 0;
+}
+
+int32_t binding_stats_register(BindingStats *stats, const char *name, int call_type) {
+    pthread_mutex_lock(&stats->mutex);
+    if (reserve_index(stats) != 0) {
+        pthread_mutex_unlock(&stats->mutex);
+        return -1;
+    }
+    int32_t *entry = find_index_entry(stats, name, call_type);
+    if (*entry >= 0) {
+        // Defined again, e.g. by another binding of the same name
+        int32_t found = *entry;
+        pthread_mutex_unlock(&stats->mutex);
+        return found;
+    }
+    int32_t index = stats->slot_count;
+    int chunk = index / CHUNK_SIZE;
+    if (chunk >= MAX_CHUNKS) {
+        pthread_mutex_unlock(&stats->mutex);
+        return -1;
+    }
+    if (stats->chunks[chunk] == NULL) {
+        stats->chunks[chunk] = calloc(CHUNK_SIZE, sizeof(Slot));
+        if (stats->chunks[chunk] == NULL) {
+            pthread_mutex_unlock(&stats->mutex);
+            return -1;
+        }
+    }
+    Slot *slot = slot_at(stats, index);
+    slot->name = malloc(strlen(name) + 1);
+    if (slot->name == NULL) {
+        pthread_mutex_unlock(&stats->mutex);
+        return -1;
+    }
+    strcpy(slot->name, name);
+    slot->call_type = call_type;
+    *entry = index;
+    // Publish the slot after it's initialized
+    __atomic_store_n(&stats->slot_count, index + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&stats->mutex);
+    return index;
+}
+
+void binding_stats_record(BindingStats *stats, int32_t slot_index,
+                          int64_t arg_ns, int64_t host_ns, int64_t result_ns,
+                          int is_error) {
+    if (slot_index < 0 || slot_index >= __atomic_load_n(&stats->slot_count, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+    Slot *slot = slot_at(stats, slot_index);
+    if (__atomic_load_n(&stats->eval_tracking, __ATOMIC_RELAXED)) {
+        if (slot->eval_generation != stats->eval_generation) {
+            slot->eval_generation = stats->eval_generation;
+            slot->eval_call_count = 0;
+            slot->eval_total_ns = 0;
+        }
+        slot->eval_call_count++;
+        slot->eval_total_ns += arg_ns + host_ns + result_ns;
+    }
+    if (!__atomic_load_n(&stats->enabled, __ATOMIC_RELAXED)) {
+        return;
+    }
+    SlotHistograms *histograms = __atomic_load_n(&slot->histograms, __ATOMIC_ACQUIRE);
+    if (histograms == NULL) {
+        SlotHistograms *new_histograms = calloc(1, sizeof(SlotHistograms));
+        if (new_histograms == NULL) {
+            return;
+        }
+        SlotHistograms *expected = NULL;
+        if (__atomic_compare_exchange_n(&slot->histograms, &expected, new_histograms, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            histograms = new_histograms;
+        } else {
+            // Allocated by another thread
+            free(new_histograms);
+            histograms = expected;
+        }
+    }
+    __atomic_fetch_add(&slot->call_count, 1, __ATOMIC_RELAXED);
+    if (is_error) {
+        __atomic_fetch_add(&slot->error_count, 1, __ATOMIC_RELAXED);
+    }
+    latency_histogram_record(&histograms->arg_conversion, arg_ns);
+    latency_histogram_record(&histograms->host_execution, host_ns);
+    latency_histogram_record(&histograms->result_conversion, result_ns);
+}
+
+int32_t binding_stats_slot_count(BindingStats *stats) {
+    return __atomic_load_n(&stats->slot_count, __ATOMIC_ACQUIRE);
+}
+
+const char *binding_stats_slot_name(BindingStats *stats, int32_t slot) {
+    if (slot < 0 || slot >= binding_stats_slot_count(stats)) {
+        return NULL;
+    }
+    return slot_at(stats, slot)->name;
+}
+
+int32_t binding_stats_snapshot(BindingStats *stats, int64_t *buffer, int32_t slot_count) {
+    int32_t count = binding_stats_slot_count(stats);
+    if (slot_count < count) {
+        count = slot_count;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        Slot *slot = slot_at(stats, i);
+        int64_t *out = buffer + (size_t) i * BINDING_STATS_SLOT_SIZE;
+        out[0] = slot->call_type;
+        out[1] = __atomic_load_n(&slot->call_count, __ATOMIC_RELAXED);
+        out[2] = __atomic_load_n(&slot->error_count, __ATOMIC_RELAXED);
+        SlotHistograms *histograms = __atomic_load_n(&slot->histograms, __ATOMIC_ACQUIRE);
+        latency_histogram_copy(histograms != NULL ? &histograms->arg_conversion : NULL, out + 3);
+        latency_histogram_copy(histograms != NULL ? &histograms->host_execution : NULL,
+                               out + 3 + LATENCY_HISTOGRAM_SIZE);
+        latency_histogram_copy(histograms != NULL ? &histograms->result_conversion : NULL,
+                               out + 3 + 2 * LATENCY_HISTOGRAM_SIZE);
+    }
+    return count;
+}
+
+int32_t binding_stats_eval_snapshot(BindingStats *stats, int64_t *buffer, int32_t max_slots) {
+    int32_t slot_count = binding_stats_slot_count(stats);
+    int32_t count = 0;
+    for (int32_t i = 0; i < slot_count && count < max_slots; i++) {
+        Slot *slot = slot_at(stats, i);
+        if (slot->eval_generation != stats->eval_generation || slot->eval_call_count == 0) {
+            continue;
+        }
+        int64_t *out = buffer + (size_t) count * BINDING_STATS_EVAL_ENTRY_SIZE;
+        out[0] = i;
+        out[1] = slot->eval_call_count;
+        out[2] = slot->eval_total_ns;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,105 @@
+#ifndef QJS_KT_BINDING_STATS_H
+#define QJS_KT_BINDING_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "latency_histogram.h"
+
+/**
+ * Longs of a slot in snapshots: [call type, call count, error count,
+ * arg conversion histogram, host execution histogram, result conversion histogram]
+ */
+#define BINDING_STATS_SLOT_SIZE (3 + 3 * LATENCY_HISTOGRAM_SIZE)
+
+/**
+ * Longs of a slot in evaluation snapshots: [slot, call count, total ns]
+ */
+#define BINDING_STATS_EVAL_ENTRY_SIZE 3
+
+/**
+ * Call types, must match the kotlin BindingCallType enum.
+ */
+typedef enum {
+    BINDING_CALL_GETTER = 0,
+    BINDING_CALL_SETTER = 1,
+    BINDING_CALL_FUNCTION = 2,
+    BINDING_CALL_ASYNC_FUNCTION = 3,
+} BindingCallType;
+
+typedef struct BindingStats BindingStats;
+
+/**
+ * Create binding stats, which is disabled by default.
+ */
+BindingStats *binding_stats_new();
+
+void binding_stats_free(BindingStats *stats);
+
+void binding_stats_set_enabled(BindingStats *stats, int enabled);
+
+int binding_stats_is_enabled(BindingStats *stats);
+
+/**
+ * Enable or disable counting calls of the current evaluation, see binding_stats_begin_eval().
+ */
+void binding_stats_set_eval_tracking(BindingStats *stats, int enabled);
+
+/**
+ * Whether calls need to be timed, either for the stats or for the evaluation tracking.
+ */
+int binding_stats_is_timing(BindingStats *stats);
+
+/**
+ * Start a new evaluation, calls recorded before are not counted to it.
+ */
+void binding_stats_begin_eval(BindingStats *stats);
+
+/**
+ * Copy slots called in the current evaluation to the buffer, the buffer needs
+ * max_slots * BINDING_STATS_EVAL_ENTRY_SIZE longs. Calls must be recorded on the JS thread
+ * while the evaluation tracking is enabled.
+ *
+ * @return The count of copied slots.
+ */
+int32_t binding_stats_eval_snapshot(BindingStats *stats, int64_t *buffer, int32_t max_slots);
+
+/**
+ * Register a binding member, the returned slot is used to record calls. Slots are interned by
+ * the name and the call type, so members defined again share the slot of the first define.
+ *
+ * @param call_type One of BindingCallType.
+ *
+ * @return The slot, or -1 if there are too many slots or out of memory.
+ */
+int32_t binding_stats_register(BindingStats *stats, const char *name, int call_type);
+
+/**
+ * Record a call, this is lock-free and can be called from any thread.
+ *
+ * @param arg_ns Time of converting arguments.
+ * @param host_ns Time of executing the host binding.
+ * @param result_ns Time of converting the result.
+ * @param is_error Whether the call failed.
+ */
+void binding_stats_record(BindingStats *stats, int32_t slot,
+                          int64_t arg_ns, int64_t host_ns, int64_t result_ns,
+                          int is_error);
+
+/**
+ * Get the count of registered slots.
+ */
+int32_t binding_stats_slot_count(BindingStats *stats);
+
+/**
+ * Get the name of a slot.
+ */
+const char *binding_stats_slot_name(BindingStats *stats, int32_t slot);
+
+/**
+ * Copy stats of slots to the buffer, the buffer needs slot_count * BINDING_STATS_SLOT_SIZE longs.
+ *
+ * @return The count of copied slots.
+ */
+int32_t binding_stats_snapshot(BindingStats *stats, int64_t *buffer, int32_t slot_count);
+
+#endif //QJS_KT_BINDING_STATS_H
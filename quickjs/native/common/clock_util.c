@@ -0,0 +1,30 @@
+#include "clock_util.h"
+
+#if defined(_WIN32)
+
+#include <windows.h>
+
+int64_t qjs_now_ns() {
+    static LARGE_INTEGER frequency = {0};
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    // Split to avoid overflows
+    int64_t seconds = counter.QuadPart / frequency.QuadPart;
+    int64_t remainder = counter.QuadPart % frequency.QuadPart;
+    return seconds * 1000000000LL + remainder * 1000000000LL / frequency.QuadPart;
+}
+
+#else
+
+#include <time.h>
+
+int64_t qjs_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef QJS_KT_CLOCK_UTIL_H
+#define QJS_KT_CLOCK_UTIL_H
+
+#include <stdint.h>
+
+/**
+ * Get the time of a monotonic clock in nanoseconds.
+ */
+int64_t qjs_now_ns();
+
+#endif //QJS_KT_CLOCK_UTIL_H
@@ -0,0 +1,26 @@
+#ifndef QJS_KT_GC_HOOK_H
+#define QJS_KT_GC_HOOK_H
+
+#include "quickjs.h"
+
+/**
+ * Called before and after a GC triggered by the allocation threshold of the engine, with is_end
+ * set to 0 and 1. It runs inside an allocation, so it must not use the runtime.
+ */
+typedef void JSGCHook(JSRuntime *rt, void *opaque, int is_end);
+
+/**
+ * Set the hook of the runtime, pass NULL to remove it.
+ *
+ * Appended to quickjs.c by CMakeLists.txt, see gc_hook.c.in.
+ */
+void JS_SetGCHook(JSRuntime *rt, JSGCHook *hook, void *opaque);
+
+/**
+ * Get the allocation counters of the runtime, they are kept by the engine for any allocator.
+ *
+ * Appended to quickjs.c by CMakeLists.txt, see gc_hook.c.in.
+ */
+const JSMallocState *JS_GetMallocState(JSRuntime *rt);
+
+#endif //QJS_KT_GC_HOOK_H
@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include "gc_stats.h"
+#include "gc_hook.h"
+#include "clock_util.h"
+
+struct GcStats {
+    JSRuntime *runtime;
+    GcListener *listener;
+    void *listener_opaque;
+    int64_t explicit_count;
+    int64_t threshold_count;
+    int64_t freed_allocations;
+    int64_t reclaimed_bytes;
+    LatencyHistogram pauses;
+    /**
+     * State of the running GC.
+     */
+    size_t live_before;
+    size_t count_before;
+    int64_t start_ns;
+};
+
+static void begin_gc(GcStats *stats) {
+    const JSMallocState *malloc_state = JS_GetMallocState(stats->runtime);
+    stats->live_before = malloc_state->malloc_size;
+    stats->count_before = malloc_state->malloc_count;
+    stats->start_ns = qjs_now_ns();
+}
+
+static void end_gc(GcStats *stats, int trigger) {
+    const JSMallocState *malloc_state = JS_GetMallocState(stats->runtime);
+    int64_t pause = qjs_now_ns() - stats->start_ns;
+    size_t live_after = malloc_state->malloc_size;
+    if (trigger == GC_TRIGGER_THRESHOLD) {
+        stats->threshold_count++;
+    } else {
+        stats->explicit_count++;
+    }
+    // The GC only frees, so the count drop is the count of freed allocations
+    if (stats->count_before > malloc_state->malloc_count) {
+        stats->freed_allocations += (int64_t) (stats->count_before - malloc_state->malloc_count);
+    }
+    if (stats->live_before > live_after) {
+        stats->reclaimed_bytes += (int64_t) (stats->live_before - live_after);
+    }
+    latency_histogram_record(&stats->pauses, pause);
+}
+
+static void on_engine_gc(JSRuntime *runtime, void *opaque, int is_end) {
+    GcStats *stats = opaque;
+    if (!is_end) {
+        if (stats->listener != NULL) {
+            stats->listener(stats->listener_opaque, 0);
+        }
+        begin_gc(stats);
+    } else {
+        end_gc(stats, GC_TRIGGER_THRESHOLD);
+        if (stats->listener != NULL) {
+            stats->listener(stats->listener_opaque, 1);
+        }
+    }
+}
+
+GcStats *gc_stats_new(JSRuntime *runtime) {
+    GcStats *stats = calloc(1, sizeof(GcStats));
+    if (stats == NULL) {
+        return NULL;
+    }
+    stats->runtime = runtime;
+    JS_SetGCHook(runtime, on_engine_gc, stats);
+    return stats;
+}
+
+void gc_stats_free(GcStats *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    JS_SetGCHook(stats->runtime, NULL, NULL);
+    free(stats);
+}
+
+void gc_stats_set_listener(GcStats *stats, GcListener *listener, void *opaque) {
+    stats->listener = listener;
+    stats->listener_opaque = opaque;
+}
+
+void gc_stats_run(GcStats *stats) {
+    begin_gc(stats);
+    JS_RunGC(stats->runtime);
+    end_gc(stats, GC_TRIGGER_EXPLICIT);
+}
+
+void gc_stats_snapshot(GcStats *stats, int64_t *buffer) {
+    buffer[0] = stats->explicit_count;
+    buffer[1] = stats->threshold_count;
+    buffer[2] = stats->freed_allocations;
+    buffer[3] = stats->reclaimed_bytes;
+    latency_histogram_copy(&stats->pauses, buffer + 4);
+}
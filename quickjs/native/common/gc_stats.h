@@ -0,0 +1,57 @@
+#ifndef QJS_KT_GC_STATS_H
+#define QJS_KT_GC_STATS_H
+
+#include <stdint.h>
+#include "quickjs.h"
+#include "latency_histogram.h"
+
+#define GC_TRIGGER_EXPLICIT 0
+#define GC_TRIGGER_THRESHOLD 1
+
+/**
+ * Longs of a snapshot: [explicit count, threshold count, freed allocations, reclaimed bytes,
+ * pause histogram...]
+ */
+#define GC_STATS_SIZE (4 + LATENCY_HISTOGRAM_SIZE)
+
+/**
+ * Called before and after a threshold GC, with is_end set to 0 and 1. It runs inside an
+ * allocation of the engine, so it must not use the runtime.
+ */
+typedef void GcListener(void *opaque, int is_end);
+
+/**
+ * Pause and reclaim stats of the GC runs of a runtime.
+ *
+ * GCs triggered by the engine are timed by the GC hook of the patched engine, see gc_hook.h, so
+ * the engine keeps its own GC timing.
+ */
+typedef struct GcStats GcStats;
+
+/**
+ * Create stats for the runtime and set the GC hook of the runtime. Reclaimed bytes are read from
+ * the allocation counters of the engine, so it works with any allocator.
+ */
+GcStats *gc_stats_new(JSRuntime *runtime);
+
+/**
+ * Remove the GC hook and free the stats.
+ */
+void gc_stats_free(GcStats *stats);
+
+/**
+ * Set the listener of threshold GCs, pass NULL to remove it.
+ */
+void gc_stats_set_listener(GcStats *stats, GcListener *listener, void *opaque);
+
+/**
+ * Run an explicit GC and record it.
+ */
+void gc_stats_run(GcStats *stats);
+
+/**
+ * Copy the stats to GC_STATS_SIZE longs.
+ */
+void gc_stats_snapshot(GcStats *stats, int64_t *buffer);
+
+#endif //QJS_KT_GC_STATS_H
@@ -0,0 +1,76 @@
+#ifndef QJS_KT_LATENCY_HISTOGRAM_H
+#define QJS_KT_LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Bits of sub-buckets in each power of 2 range, the relative error of recorded values is 1/4.
+ */
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 2
+
+/**
+ * Values larger than 2^40 ns (~18 minutes) are recorded to the last bucket.
+ */
+#define LATENCY_HISTOGRAM_MAX_VALUE_BITS 40
+
+#define LATENCY_HISTOGRAM_BUCKET_COUNT \
+    ((LATENCY_HISTOGRAM_MAX_VALUE_BITS - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 2) \
+        << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+
+/**
+ * Longs of a histogram in snapshots: [total ns, max ns, bucket counts...]
+ */
+#define LATENCY_HISTOGRAM_SIZE (2 + LATENCY_HISTOGRAM_BUCKET_COUNT)
+
+/**
+ * A log-linear latency histogram, updates are lock-free.
+ */
+typedef struct {
+    int64_t total_ns;
+    int64_t max_ns;
+    int64_t counts[LATENCY_HISTOGRAM_BUCKET_COUNT];
+} LatencyHistogram;
+
+static inline int latency_histogram_bucket_index(int64_t value) {
+    const int sub_bucket_count = 1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    if (value < sub_bucket_count) {
+        return value < 0 ? 0 : (int) value;
+    }
+    uint64_t v = (uint64_t) value;
+    int msb = 63 - __builtin_clzll(v);
+    if (msb >= LATENCY_HISTOGRAM_MAX_VALUE_BITS) {
+        return LATENCY_HISTOGRAM_BUCKET_COUNT - 1;
+    }
+    int shift = msb - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    int sub_bucket = (int) ((v >> shift) & (sub_bucket_count - 1));
+    return ((shift + 1) << LATENCY_HISTOGRAM_SUB_BUCKET_BITS) + sub_bucket;
+}
+
+static inline void latency_histogram_record(LatencyHistogram *histogram, int64_t value) {
+    __atomic_fetch_add(&histogram->counts[latency_histogram_bucket_index(value)], 1,
+                       __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->total_ns, value, __ATOMIC_RELAXED);
+    int64_t max = __atomic_load_n(&histogram->max_ns, __ATOMIC_RELAXED);
+    while (value > max &&
+           !__atomic_compare_exchange_n(&histogram->max_ns, &max, value, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+/**
+ * Copy the histogram to LATENCY_HISTOGRAM_SIZE longs, a NULL histogram is copied as zeros.
+ */
+static inline void latency_histogram_copy(LatencyHistogram *histogram, int64_t *buffer) {
+    if (histogram == NULL) {
+        memset(buffer, 0, sizeof(int64_t) * LATENCY_HISTOGRAM_SIZE);
+        return;
+    }
+    buffer[0] = __atomic_load_n(&histogram->total_ns, __ATOMIC_RELAXED);
+    buffer[1] = __atomic_load_n(&histogram->max_ns, __ATOMIC_RELAXED);
+    for (int i = 0; i < LATENCY_HISTOGRAM_BUCKET_COUNT; i++) {
+        buffer[2 + i] = __atomic_load_n(&histogram->counts[i], __ATOMIC_RELAXED);
+    }
+}
+
+#endif //QJS_KT_LATENCY_HISTOGRAM_H
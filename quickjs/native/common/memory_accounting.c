@@ -0,0 +1,155 @@
+#include <stdlib.h>
+#include "memory_accounting.h"
+
+// Keep the returned pointers aligned as malloc() does
+#define HEADER_SIZE 16
+
+static inline size_t header_size_of(void *ptr) {
+    return *(size_t *) ((char *) ptr - HEADER_SIZE);
+}
+
+/**
+ * Check the limits of evaluations in progress before growing the live bytes.
+ */
+static inline int can_grow(MemoryAccounting *accounting, size_t size) {
+    size_t live = accounting->live_bytes + size;
+    for (EvalAccounting *eval = accounting->evals; eval != NULL; eval = eval->next) {
+        if (eval->limit != 0 && live > eval->base_bytes &&
+            live - eval->base_bytes > eval->limit) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static inline void on_grow(MemoryAccounting *accounting, size_t size) {
+    accounting->live_bytes += size;
+    for (EvalAccounting *eval = accounting->evals; eval != NULL; eval = eval->next) {
+        eval->allocated_bytes += size;
+        if (accounting->live_bytes > eval->base_bytes) {
+            size_t growth = accounting->live_bytes - eval->base_bytes;
+            if (growth > eval->peak_bytes) {
+                eval->peak_bytes = growth;
+            }
+        }
+    }
+}
+
+static inline void on_shrink(MemoryAccounting *accounting, size_t size) {
+    accounting->live_bytes -= size;
+}
+
+static void *accounting_malloc(JSMallocState *s, size_t size) {
+    MemoryAccounting *accounting = s->opaque;
+    if (s->malloc_size + size > s->malloc_limit || !can_grow(accounting, size)) {
+        return NULL;
+    }
+    char *base = malloc(size + HEADER_SIZE);
+    if (base == NULL) {
+        return NULL;
+    }
+    *(size_t *) base = size;
+    s->malloc_count++;
+    s->malloc_size += size + HEADER_SIZE;
+    on_grow(accounting, size);
+    return base + HEADER_SIZE;
+}
+
+static void accounting_free_ptr(JSMallocState *s, void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    size_t size = header_size_of(ptr);
+    s->malloc_count--;
+    s->malloc_size -= size + HEADER_SIZE;
+    on_shrink(s->opaque, size);
+    free((char *) ptr - HEADER_SIZE);
+}
+
+static void *accounting_realloc(JSMallocState *s, void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return size == 0 ? NULL : accounting_malloc(s, size);
+    }
+    if (size == 0) {
+        accounting_free_ptr(s, ptr);
+        return NULL;
+    }
+    MemoryAccounting *accounting = s->opaque;
+    size_t old_size = header_size_of(ptr);
+    if (size > old_size) {
+        size_t growth = size - old_size;
+        if (s->malloc_size + growth > s->malloc_limit || !can_grow(accounting, growth)) {
+            return NULL;
+        }
+    }
+    char *base = realloc((char *) ptr - HEADER_SIZE, size + HEADER_SIZE);
+    if (base == NULL) {
+        return NULL;
+    }
+    *(size_t *) base = size;
+    s->malloc_size = s->malloc_size - old_size + size;
+    if (size > old_size) {
+        on_grow(accounting, size - old_size);
+    } else {
+        on_shrink(accounting, old_size - size);
+    }
+    return base + HEADER_SIZE;
+}
+
+static size_t accounting_malloc_usable_size(const void *ptr) {
+    if (ptr == NULL) {
+        return 0;
+    }
+    return header_size_of((void *) ptr);
+}
+
+static const JSMallocFunctions accounting_malloc_functions = {
+        accounting_malloc,
+        accounting_free_ptr,
+        accounting_realloc,
+        accounting_malloc_usable_size,
+};
+
+JSRuntime *accounting_new_runtime(MemoryAccounting **accounting) {
+    MemoryAccounting *new_accounting = calloc(1, sizeof(MemoryAccounting));
+    if (new_accounting == NULL) {
+        return NULL;
+    }
+    JSRuntime *runtime = JS_NewRuntime2(&accounting_malloc_functions, new_accounting);
+    if (runtime == NULL) {
+        free(new_accounting);
+        return NULL;
+    }
+    *accounting = new_accounting;
+    return runtime;
+}
+
+void accounting_free(MemoryAccounting *accounting) {
+    free(accounting);
+}
+
+void accounting_begin_eval(MemoryAccounting *accounting, EvalAccounting *eval, int64_t limit) {
+    eval->base_bytes = accounting->live_bytes;
+    eval->allocated_bytes = 0;
+    eval->peak_bytes = 0;
+    eval->limit = limit > 0 ? (size_t) limit : 0;
+    eval->prev = NULL;
+    eval->next = accounting->evals;
+    if (accounting->evals != NULL) {
+        accounting->evals->prev = eval;
+    }
+    accounting->evals = eval;
+}
+
+void accounting_end_eval(MemoryAccounting *accounting, EvalAccounting *eval) {
+    if (eval->prev != NULL) {
+        eval->prev->next = eval->next;
+    } else {
+        accounting->evals = eval->next;
+    }
+    if (eval->next != NULL) {
+        eval->next->prev = eval->prev;
+    }
+    eval->prev = NULL;
+    eval->next = NULL;
+}
@@ -0,0 +1,76 @@
+#ifndef QJS_KT_MEMORY_ACCOUNTING_H
+#define QJS_KT_MEMORY_ACCOUNTING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "quickjs.h"
+
+/**
+ * Allocation accounting of an evaluation, owned by the caller of accounting_begin_eval().
+ */
+typedef struct EvalAccounting {
+    /**
+     * Live bytes when the evaluation began.
+     */
+    size_t base_bytes;
+    /**
+     * Bytes allocated since the evaluation began, including freed allocations.
+     */
+    size_t allocated_bytes;
+    /**
+     * The peak of live bytes growth since the evaluation began.
+     */
+    size_t peak_bytes;
+    /**
+     * The limit of live bytes growth during the evaluation, 0 for no limit.
+     */
+    size_t limit;
+    struct EvalAccounting *prev;
+    struct EvalAccounting *next;
+} EvalAccounting;
+
+/**
+ * Allocation accounting of a runtime. All allocations of the runtime go through the accounting
+ * allocator, which tracks live bytes and the bytes allocated during evaluations.
+ */
+typedef struct {
+    /**
+     * Bytes currently allocated by the runtime.
+     */
+    size_t live_bytes;
+    /**
+     * Evaluations in progress. Evaluations can overlap when they await async jobs, each of them
+     * records the allocations made while it's in progress.
+     */
+    EvalAccounting *evals;
+} MemoryAccounting;
+
+/**
+ * Create a runtime whose allocations are recorded to a new accounting.
+ * Free the accounting with accounting_free() after freeing the runtime.
+ *
+ * Each allocation carries a 16 bytes size header, so only create it when accounting is requested,
+ * other runtimes use JS_NewRuntime().
+ */
+JSRuntime *accounting_new_runtime(MemoryAccounting **accounting);
+
+/**
+ * Free the accounting.
+ */
+void accounting_free(MemoryAccounting *accounting);
+
+/**
+ * Start recording an evaluation to the eval accounting, it must be kept alive until
+ * accounting_end_eval().
+ *
+ * @param limit The limit of live bytes growth, allocations that exceed it fail with an out of
+ * memory error. Non-positive values mean no limit.
+ */
+void accounting_begin_eval(MemoryAccounting *accounting, EvalAccounting *eval, int64_t limit);
+
+/**
+ * Stop recording the evaluation, the stats are kept in the eval accounting.
+ */
+void accounting_end_eval(MemoryAccounting *accounting, EvalAccounting *eval);
+
+#endif //QJS_KT_MEMORY_ACCOUNTING_H
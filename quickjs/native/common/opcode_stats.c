@@ -0,0 +1,66 @@
+#include <string.h>
+#include "opcode_stats.h"
+
+// Same as quickjs.c, short opcodes are part of the opcode table
+#define SHORT_OPCODES 1
+
+static const char *opcode_names[] = {
+#define FMT(f)
+#define DEF(id, size, n_pop, n_push, f) #id,
+#define def(id, size, n_pop, n_push, f)
+#include "quickjs-opcode.h"
+#undef def
+#undef DEF
+#undef FMT
+};
+
+#define OPCODE_COUNT ((int) (sizeof(opcode_names) / sizeof(opcode_names[0])))
+
+#ifdef QJS_KT_OPCODE_STATS
+// Size of the counters added to JSRuntime, keep in sync with CMakeLists.txt
+#define OPCODE_COUNTER_SIZE 256
+
+// Appended to the instrumented quickjs.c
+uint64_t *JS_GetOpcodeCounts(JSRuntime *rt);
+#endif
+
+int opcode_stats_available(void) {
+#ifdef QJS_KT_OPCODE_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int opcode_stats_opcode_count(void) {
+    return OPCODE_COUNT;
+}
+
+const char *opcode_stats_opcode_name(int opcode) {
+    if (opcode < 0 || opcode >= OPCODE_COUNT) {
+        return NULL;
+    }
+    return opcode_names[opcode];
+}
+
+int opcode_stats_snapshot(JSRuntime *runtime, int64_t *buffer) {
+#ifdef QJS_KT_OPCODE_STATS
+    uint64_t *counts = JS_GetOpcodeCounts(runtime);
+    for (int i = 0; i < OPCODE_COUNT; i++) {
+        buffer[i] = (int64_t) counts[i];
+    }
+    return 0;
+#else
+    (void) runtime;
+    (void) buffer;
+    return -1;
+#endif
+}
+
+void opcode_stats_reset(JSRuntime *runtime) {
+#ifdef QJS_KT_OPCODE_STATS
+    memset(JS_GetOpcodeCounts(runtime), 0, OPCODE_COUNTER_SIZE * sizeof(uint64_t));
+#else
+    (void) runtime;
+#endif
+}
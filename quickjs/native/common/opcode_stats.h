@@ -0,0 +1,42 @@
+#ifndef QJS_KT_OPCODE_STATS_H
+#define QJS_KT_OPCODE_STATS_H
+
+#include <stdint.h>
+#include "quickjs.h"
+
+/**
+ * Counts of executed opcodes, only available when the engine is built with the
+ * QJS_KT_OPCODE_STATS option, which instruments the interpreter loop.
+ *
+ * Counters are kept per runtime and are not thread safe, read them while holding the lock of
+ * the runtime.
+ */
+
+/**
+ * Returns 1 if the engine is instrumented, 0 otherwise.
+ */
+int opcode_stats_available(void);
+
+/**
+ * The count of defined opcodes, including short opcodes.
+ */
+int opcode_stats_opcode_count(void);
+
+/**
+ * The name of the opcode, or NULL if the opcode is out of range.
+ */
+const char *opcode_stats_opcode_name(int opcode);
+
+/**
+ * Copy the counts to opcode_stats_opcode_count() longs.
+ *
+ * @return 0 on success, -1 if the engine is not instrumented.
+ */
+int opcode_stats_snapshot(JSRuntime *runtime, int64_t *buffer);
+
+/**
+ * Reset the counts, does nothing if the engine is not instrumented.
+ */
+void opcode_stats_reset(JSRuntime *runtime);
+
+#endif //QJS_KT_OPCODE_STATS_H
@@ -0,0 +1,17 @@
+#include "runtime_hooks.h"
+
+static int interrupt_handler(JSRuntime *runtime, void *opaque) {
+    RuntimeHooks *hooks = opaque;
+    if (hooks->profiler != NULL) {
+        profiler_on_interrupt(hooks->profiler);
+    }
+    return 0;
+}
+
+void runtime_hooks_install(JSRuntime *runtime, RuntimeHooks *hooks) {
+    JS_SetInterruptHandler(runtime, interrupt_handler, hooks);
+}
+
+void runtime_hooks_uninstall(JSRuntime *runtime) {
+    JS_SetInterruptHandler(runtime, NULL, NULL);
+}
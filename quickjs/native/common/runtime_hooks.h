@@ -0,0 +1,21 @@
+#ifndef QJS_KT_RUNTIME_HOOKS_H
+#define QJS_KT_RUNTIME_HOOKS_H
+
+#include "quickjs.h"
+#include "sampling_profiler.h"
+
+/**
+ * Components that share the interrupt handler of a runtime.
+ */
+typedef struct {
+    SamplingProfiler *profiler;
+} RuntimeHooks;
+
+/**
+ * Install the interrupt handler, the hooks must outlive the runtime or be uninstalled first.
+ */
+void runtime_hooks_install(JSRuntime *runtime, RuntimeHooks *hooks);
+
+void runtime_hooks_uninstall(JSRuntime *runtime);
+
+#endif //QJS_KT_RUNTIME_HOOKS_H
@@ -0,0 +1,311 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "sampling_profiler.h"
+#include "stack_frames.h"
+#include "clock_util.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define INITIAL_TABLE_CAPACITY 64
+
+#define MAX_SAMPLE_FRAMES 256
+
+typedef struct {
+    char *stack;
+    uint64_t hash;
+    int64_t count;
+} StackEntry;
+
+struct SamplingProfiler {
+    JSContext *context;
+    int64_t interval_ns;
+    /**
+     * Written by the timer thread, 0 if no sample is requested.
+     */
+    int64_t sample_requested_at;
+    int running;
+    pthread_t timer_thread;
+    /**
+     * Frames of the sample being captured, only used on the JS thread.
+     */
+    JSStackFrameInfo *frames;
+    /**
+     * Aggregated stacks, protect by the mutex.
+     */
+    StackEntry *entries;
+    size_t capacity;
+    size_t size;
+    pthread_mutex_t mutex;
+};
+
+static void sleep_ns(int64_t ns) {
+#if defined(_WIN32)
+    DWORD ms = (DWORD) (ns / 1000000);
+    Sleep(ms > 0 ? ms : 1);
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t) (ns / 1000000000LL);
+    ts.tv_nsec = (long) (ns % 1000000000LL);
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static void *timer_loop(void *arg) {
+    SamplingProfiler *profiler = arg;
+    while (__atomic_load_n(&profiler->running, __ATOMIC_ACQUIRE)) {
+        sleep_ns(profiler->interval_ns);
+        int64_t expected = 0;
+        // Keep the pending request if the previous one is not taken yet
+        __atomic_compare_exchange_n(&profiler->sample_requested_at, &expected, qjs_now_ns(),
+                                    0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+static uint64_t hash_string(const char *str, size_t len) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char) str[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void clear_entries(SamplingProfiler *profiler) {
+    for (size_t i = 0; i < profiler->capacity; i++) {
+        free(profiler->entries[i].stack);
+    }
+    free(profiler->entries);
+    profiler->entries = NULL;
+    profiler->capacity = 0;
+    profiler->size = 0;
+}
+
+static int grow_entries(SamplingProfiler *profiler) {
+    size_t capacity = profiler->capacity == 0 ? INITIAL_TABLE_CAPACITY : profiler->capacity * 2;
+    StackEntry *entries = calloc(capacity, sizeof(StackEntry));
+    if (entries == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < profiler->capacity; i++) {
+        StackEntry *entry = &profiler->entries[i];
+        if (entry->stack == NULL) {
+            continue;
+        }
+        size_t index = entry->hash & (capacity - 1);
+        while (entries[index].stack != NULL) {
+            index = (index + 1) & (capacity - 1);
+        }
+        entries[index] = *entry;
+    }
+    free(profiler->entries);
+    profiler->entries = entries;
+    profiler->capacity = capacity;
+    return 0;
+}
+
+/**
+ * Add a sample of the collapsed stack, the stack is owned by the table after adding.
+ */
+static void add_sample(SamplingProfiler *profiler, char *stack, size_t len) {
+    uint64_t hash = hash_string(stack, len);
+    pthread_mutex_lock(&profiler->mutex);
+    if ((profiler->size + 1) * 10 > profiler->capacity * 7 && grow_entries(profiler) != 0) {
+        pthread_mutex_unlock(&profiler->mutex);
+        free(stack);
+        return;
+    }
+    size_t index = hash & (profiler->capacity - 1);
+    while (profiler->entries[index].stack != NULL) {
+        StackEntry *entry = &profiler->entries[index];
+        if (entry->hash == hash && strcmp(entry->stack, stack) == 0) {
+            entry->count++;
+            pthread_mutex_unlock(&profiler->mutex);
+            free(stack);
+            return;
+        }
+        index = (index + 1) & (profiler->capacity - 1);
+    }
+    profiler->entries[index].stack = stack;
+    profiler->entries[index].hash = hash;
+    profiler->entries[index].count = 1;
+    profiler->size++;
+    pthread_mutex_unlock(&profiler->mutex);
+}
+
+/**
+ * Append a frame as 'name (file:line)', ';' separates frames in the collapsed format so it's
+ * replaced in names.
+ */
+static size_t format_frame(char *out, size_t size, const JSStackFrameInfo *frame) {
+    const char *name = frame->func_name[0] != '\0' ? frame->func_name : "<anonymous>";
+    int len;
+    if (frame->is_native) {
+        len = snprintf(out, size, "%s (native)", name);
+    } else if (frame->filename[0] == '\0') {
+        len = snprintf(out, size, "%s", name);
+    } else if (frame->line_num < 0) {
+        len = snprintf(out, size, "%s (%s)", name, frame->filename);
+    } else {
+        len = snprintf(out, size, "%s (%s:%d)", name, frame->filename, frame->line_num);
+    }
+    if (len < 0) {
+        return 0;
+    }
+    size_t written = (size_t) len < size ? (size_t) len : size - 1;
+    for (size_t i = 0; i < written; i++) {
+        if (out[i] == ';') {
+            out[i] = ',';
+        }
+    }
+    return written;
+}
+
+/**
+ * Convert frames (innermost first) to a collapsed stack (root first). Stacks deeper than
+ * MAX_SAMPLE_FRAMES start with a '...' frame.
+ */
+static char *collapse_frames(const JSStackFrameInfo *frames, int frame_count, int truncated,
+                             size_t *out_len) {
+    // Name, file, line and separators of each frame
+    size_t frame_size = STACK_FRAME_NAME_SIZE + STACK_FRAME_FILENAME_SIZE + 32;
+    size_t size = (size_t) frame_count * frame_size + 5;
+    char *stack = malloc(size);
+    if (stack == NULL) {
+        return NULL;
+    }
+    char *out = stack;
+    if (truncated) {
+        memcpy(out, "...;", 4);
+        out += 4;
+    }
+    for (int i = frame_count; i > 0; i--) {
+        out += format_frame(out, frame_size, &frames[i - 1]);
+        if (i > 1) {
+            *out++ = ';';
+        }
+    }
+    *out = '\0';
+    *out_len = (size_t) (out - stack);
+    return stack;
+}
+
+static void capture_sample(SamplingProfiler *profiler) {
+    if (profiler->frames == NULL) {
+        return;
+    }
+    // Capture one more frame to tell if the stack is truncated
+    int count = JS_GetStackFrames(profiler->context, profiler->frames, MAX_SAMPLE_FRAMES + 1);
+    if (count == 0) {
+        return;
+    }
+    int truncated = count > MAX_SAMPLE_FRAMES;
+    if (truncated) {
+        count = MAX_SAMPLE_FRAMES;
+    }
+    size_t len = 0;
+    char *collapsed = collapse_frames(profiler->frames, count, truncated, &len);
+    if (collapsed != NULL) {
+        add_sample(profiler, collapsed, len);
+    }
+}
+
+void profiler_on_interrupt(SamplingProfiler *profiler) {
+    int64_t requested_at = __atomic_load_n(&profiler->sample_requested_at, __ATOMIC_ACQUIRE);
+    if (requested_at == 0) {
+        return;
+    }
+    __atomic_store_n(&profiler->sample_requested_at, 0, __ATOMIC_RELAXED);
+    // Requests made while JS is idle are stale, don't attribute them to the current stack
+    if (qjs_now_ns() - requested_at <= 2 * profiler->interval_ns) {
+        capture_sample(profiler);
+    }
+}
+
+SamplingProfiler *profiler_new() {
+    SamplingProfiler *profiler = calloc(1, sizeof(SamplingProfiler));
+    if (profiler == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&profiler->mutex, NULL);
+    return profiler;
+}
+
+void profiler_free(SamplingProfiler *profiler) {
+    if (profiler == NULL) {
+        return;
+    }
+    profiler_stop(profiler);
+    clear_entries(profiler);
+    free(profiler->frames);
+    pthread_mutex_destroy(&profiler->mutex);
+    free(profiler);
+}
+
+int profiler_start(SamplingProfiler *profiler, JSContext *context, int64_t interval_us) {
+    profiler_stop(profiler);
+    pthread_mutex_lock(&profiler->mutex);
+    clear_entries(profiler);
+    pthread_mutex_unlock(&profiler->mutex);
+    if (profiler->frames == NULL) {
+        profiler->frames = malloc(sizeof(JSStackFrameInfo) * (MAX_SAMPLE_FRAMES + 1));
+        if (profiler->frames == NULL) {
+            return -1;
+        }
+    }
+    profiler->context = context;
+    profiler->interval_ns = (interval_us > 0 ? interval_us : 1) * 1000;
+    profiler->sample_requested_at = 0;
+    __atomic_store_n(&profiler->running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&profiler->timer_thread, NULL, timer_loop, profiler) != 0) {
+        __atomic_store_n(&profiler->running, 0, __ATOMIC_RELEASE);
+        return -1;
+    }
+    return 0;
+}
+
+void profiler_stop(SamplingProfiler *profiler) {
+    if (!__atomic_load_n(&profiler->running, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+    __atomic_store_n(&profiler->running, 0, __ATOMIC_RELEASE);
+    pthread_join(profiler->timer_thread, NULL);
+    profiler->sample_requested_at = 0;
+}
+
+int profiler_is_running(SamplingProfiler *profiler) {
+    return __atomic_load_n(&profiler->running, __ATOMIC_ACQUIRE);
+}
+
+char *profiler_collapsed_stacks(SamplingProfiler *profiler) {
+    pthread_mutex_lock(&profiler->mutex);
+    size_t len = 1;
+    for (size_t i = 0; i < profiler->capacity; i++) {
+        if (profiler->entries[i].stack != NULL) {
+            // Stack, space, count and new line
+            len += strlen(profiler->entries[i].stack) + 22;
+        }
+    }
+    char *result = malloc(len);
+    if (result == NULL) {
+        pthread_mutex_unlock(&profiler->mutex);
+        return NULL;
+    }
+    char *out = result;
+    for (size_t i = 0; i < profiler->capacity; i++) {
+        StackEntry *entry = &profiler->entries[i];
+        if (entry->stack != NULL) {
+            out += sprintf(out, "%s %lld\n", entry->stack, (long long) entry->count);
+        }
+    }
+    *out = '\0';
+    pthread_mutex_unlock(&profiler->mutex);
+    return result;
+}
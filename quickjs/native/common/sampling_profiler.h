@@ -0,0 +1,49 @@
+#ifndef QJS_KT_SAMPLING_PROFILER_H
+#define QJS_KT_SAMPLING_PROFILER_H
+
+#include <stdint.h>
+#include "quickjs.h"
+
+/**
+ * A sampling CPU profiler for JS code. A timer thread requests samples at a fixed interval,
+ * the JS call stack is walked by profiler_on_interrupt() and aggregated by stacks, so the
+ * overhead is one stack walk per sample. Walking frames doesn't allocate on the JS heap.
+ */
+typedef struct SamplingProfiler SamplingProfiler;
+
+SamplingProfiler *profiler_new();
+
+/**
+ * Stop the profiler and free it.
+ */
+void profiler_free(SamplingProfiler *profiler);
+
+/**
+ * Start sampling the context, samples of the previous session are discarded.
+ *
+ * @param interval_us The sampling interval in microseconds.
+ * @return 0 on success, -1 if the timer thread cannot be started or out of memory.
+ */
+int profiler_start(SamplingProfiler *profiler, JSContext *context, int64_t interval_us);
+
+/**
+ * Stop sampling, the samples are kept until the next start.
+ */
+void profiler_stop(SamplingProfiler *profiler);
+
+int profiler_is_running(SamplingProfiler *profiler);
+
+/**
+ * Capture a sample if one is requested, called by the interrupt handler of the runtime.
+ */
+void profiler_on_interrupt(SamplingProfiler *profiler);
+
+/**
+ * Export samples in the collapsed stack format, one 'root;...;leaf count' line per stack.
+ * Frames are formatted as 'name (file:line)'.
+ *
+ * @return A string that needs to be freed by the caller, or NULL if out of memory.
+ */
+char *profiler_collapsed_stacks(SamplingProfiler *profiler);
+
+#endif //QJS_KT_SAMPLING_PROFILER_H
@@ -0,0 +1,42 @@
+#ifndef QJS_KT_STACK_FRAMES_H
+#define QJS_KT_STACK_FRAMES_H
+
+#include "quickjs.h"
+
+#define STACK_FRAME_NAME_SIZE 64
+
+#define STACK_FRAME_FILENAME_SIZE 192
+
+/**
+ * A frame of the JS call stack.
+ */
+typedef struct {
+    /**
+     * UTF-8 function name, empty for anonymous functions.
+     */
+    char func_name[STACK_FRAME_NAME_SIZE];
+    /**
+     * UTF-8 file name, empty for native functions or functions without debug info.
+     */
+    char filename[STACK_FRAME_FILENAME_SIZE];
+    /**
+     * The current line, resolved from the pc2line table, or -1 if unknown.
+     */
+    int line_num;
+    /**
+     * 1 if the function is a native function.
+     */
+    int is_native;
+} JSStackFrameInfo;
+
+/**
+ * Copy frames of the current call stack, innermost first. It doesn't allocate on the JS heap or
+ * run JS code, so it's safe to call from the interrupt handler.
+ *
+ * Appended to quickjs.c by CMakeLists.txt, see stack_frames_hook.c.in.
+ *
+ * @return The count of copied frames, at most max_frames.
+ */
+int JS_GetStackFrames(JSContext *ctx, JSStackFrameInfo *frames, int max_frames);
+
+#endif //QJS_KT_STACK_FRAMES_H
@@ -0,0 +1,18 @@
+#include "timed_eval.h"
+#include "clock_util.h"
+
+JSValue timed_eval(JSContext *context, const char *code, size_t len, const char *filename,
+                   int eval_flags, int64_t *compile_ns) {
+    if (compile_ns == NULL || (eval_flags & JS_EVAL_FLAG_COMPILE_ONLY) != 0) {
+        return JS_Eval(context, code, len, filename, eval_flags);
+    }
+    int64_t start = qjs_now_ns();
+    JSValue compiled = JS_Eval(context, code, len, filename,
+                               eval_flags | JS_EVAL_FLAG_COMPILE_ONLY);
+    *compile_ns = qjs_now_ns() - start;
+    if (JS_IsException(compiled)) {
+        return compiled;
+    }
+    // Same as the second step of JS_Eval(), the function is freed by it
+    return JS_EvalFunction(context, compiled);
+}
@@ -0,0 +1,17 @@
+#ifndef QJS_KT_TIMED_EVAL_H
+#define QJS_KT_TIMED_EVAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "quickjs.h"
+
+/**
+ * Evaluate code like JS_Eval(), but compile and run it in two steps to time the compilation.
+ *
+ * @param compile_ns Receives the compile time. If it's NULL, the code is evaluated by JS_Eval()
+ * directly.
+ */
+JSValue timed_eval(JSContext *context, const char *code, size_t len, const char *filename,
+                   int eval_flags, int64_t *compile_ns);
+
+#endif //QJS_KT_TIMED_EVAL_H
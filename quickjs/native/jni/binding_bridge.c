@@ -1,3 +1,6 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "binding_bridge.h"
 #include "exception_util.h"
 #include "jni_globals.h"
@@ -7,28 +10,526 @@
 #include "jobject_to_js_value.h"
 #include "js_value_util.h"
 #include "jni_types_util.h"
+#include "handle_tracker.h"
+#include "binding_stats.h"
+#include "clock_util.h"
 
-#define COMMON_FUNC_DATA_LEN 2
+#define FUNC_DATA_LEN 3
+
+#define CLASS_FUNC_DATA_LEN 4
+
+#define SHARED_FUNC_DATA_LEN 4
+
+/**
+ * The magic of members defined on shared prototypes, they resolve the binding from 'this'.
+ */
+#define SHARED_MEMBER_MAGIC 1
 
 #define GLOBAL_THIS_HANDLE -1
 
+// Flags of encoded binding trees, they match the encoder on the Kotlin side
+#define TREE_PROPERTY_CONFIGURABLE 1
+#define TREE_PROPERTY_WRITABLE 2
+#define TREE_PROPERTY_ENUMERABLE 4
+#define TREE_PROPERTY_CONSTANT 8
+#define TREE_FUNCTION_ASYNC 1
+
+// Members to define when walking an encoded object
+#define TREE_DEFINE_ACCESSORS 1
+#define TREE_DEFINE_FUNCTIONS 2
+#define TREE_DEFINE_CONSTANTS 4
+
+/**
+ * Durations of a binding call, only measured when binding stats are enabled.
+ */
+typedef struct {
+    int64_t arg_ns;
+    int64_t host_ns;
+    int64_t result_ns;
+} CallTiming;
+
+static inline int64_t timing_now(CallTiming *timing) {
+    return timing != NULL ? qjs_now_ns() : 0;
+}
+
+static JSClassID js_binding_class_id = 0;
+
+/**
+ * The class of host instances, each defined class has its own prototype.
+ */
+static JSClassID js_host_instance_class_id = 0;
+
+static pthread_once_t binding_class_id_once = PTHREAD_ONCE_INIT;
+
+static void new_binding_class_ids() {
+    JS_NewClassID(&js_binding_class_id);
+    JS_NewClassID(&js_host_instance_class_id);
+}
+
+static void remove_binding_host(Globals *globals, BindingHost *binding) {
+    size_t size = cvector_size(globals->binding_hosts);
+    size_t index = binding->host_index;
+    if (index >= size || globals->binding_hosts[index] != binding) {
+        return;
+    }
+    // Swap with the last one
+    BindingHost *last = globals->binding_hosts[size - 1];
+    globals->binding_hosts[index] = last;
+    last->host_index = index;
+    cvector_pop_back(globals->binding_hosts);
+}
+
+static inline uint32_t object_handle_index(int64_t handle) {
+    return (uint32_t) (handle & 0xFFFFFFFF);
+}
+
+static inline uint32_t object_handle_generation(int64_t handle) {
+    return (uint32_t) (handle >> 32);
+}
+
+int64_t acquire_object_handle(Globals *globals) {
+    uint32_t index;
+    size_t free_count = cvector_size(globals->free_object_slots);
+    if (free_count > 0) {
+        index = globals->free_object_slots[free_count - 1];
+        cvector_pop_back(globals->free_object_slots);
+    } else {
+        index = (uint32_t) cvector_size(globals->defined_js_objects);
+        DefinedObject slot = {.value = JS_UNDEFINED, .generation = 0};
+        cvector_push_back(globals->defined_js_objects, slot);
+    }
+    uint32_t generation = globals->defined_js_objects[index].generation;
+    return ((int64_t) generation << 32) | index;
+}
+
+static DefinedObject *defined_object_slot(Globals *globals, int64_t handle) {
+    if (handle < 0) {
+        return NULL;
+    }
+    uint32_t index = object_handle_index(handle);
+    if (index >= cvector_size(globals->defined_js_objects)) {
+        return NULL;
+    }
+    DefinedObject *slot = &globals->defined_js_objects[index];
+    if (slot->generation != object_handle_generation(handle)) {
+        return NULL;
+    }
+    return slot;
+}
+
+JSValue *defined_object_of_handle(Globals *globals, int64_t handle) {
+    DefinedObject *slot = defined_object_slot(globals, handle);
+    if (slot == NULL || JS_IsUndefined(slot->value)) {
+        return NULL;
+    }
+    return &slot->value;
+}
+
+void set_defined_object(Globals *globals, int64_t handle, JSValue object) {
+    DefinedObject *slot = defined_object_slot(globals, handle);
+    if (slot != NULL) {
+        slot->value = object;
+    }
+}
+
+void release_object_handle(Globals *globals, int64_t handle) {
+    DefinedObject *slot = defined_object_slot(globals, handle);
+    if (slot == NULL) {
+        return;
+    }
+    slot->value = JS_UNDEFINED;
+    // Keep handles non-negative
+    slot->generation = (slot->generation + 1) & 0x7FFFFFFF;
+    cvector_push_back(globals->free_object_slots, object_handle_index(handle));
+}
+
+static void notify_binding_finalized(JNIEnv *env, jobject host, int64_t handle) {
+    if (handle == GLOBAL_THIS_HANDLE) {
+        return;
+    }
+    // Finalizers may run while a java exception is pending, stash it
+    jthrowable pending = (*env)->ExceptionOccurred(env);
+    if (pending != NULL) {
+        (*env)->ExceptionClear(env);
+    }
+    (*env)->CallVoidMethod(env, host, method_quick_js_on_binding_finalized(env), handle);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
+    }
+    if (pending != NULL) {
+        (*env)->Throw(env, pending);
+        (*env)->DeleteLocalRef(env, pending);
+    }
+}
+
+void release_stale_bindings(JNIEnv *env, Globals *globals) {
+    cvector_vector_type(jobject)stale_host_refs = globals->stale_host_refs;
+    if (stale_host_refs != NULL) {
+        size_t size = cvector_size(stale_host_refs);
+        for (size_t i = 0; i < size; i++) {
+            (*env)->DeleteGlobalRef(env, stale_host_refs[i]);
+        }
+        cvector_free(stale_host_refs);
+        globals->stale_host_refs = NULL;
+    }
+
+    cvector_vector_type(StaleBinding)stale_bindings = globals->stale_bindings;
+    if (stale_bindings == NULL) {
+        return;
+    }
+    size_t size = cvector_size(stale_bindings);
+    for (size_t i = 0; i < size; i++) {
+        notify_binding_finalized(env, stale_bindings[i].host, stale_bindings[i].handle);
+        (*env)->DeleteGlobalRef(env, stale_bindings[i].host);
+    }
+    cvector_free(stale_bindings);
+    globals->stale_bindings = NULL;
+}
+
+static void binding_finalizer(JSRuntime *runtime, JSValue value) {
+    BindingHost *binding = JS_GetOpaque(value, js_binding_class_id);
+    if (binding == NULL) {
+        return;
+    }
+    Globals *globals = binding->globals;
+    if (globals != NULL) {
+        remove_binding_host(globals, binding);
+        untrack_handle(globals, binding);
+        int64_t handle = binding->handle;
+        // The object is gone, the handle can no longer be used as a parent
+        release_object_handle(globals, handle);
+        JNIEnv *env = get_jni_env();
+        if (env != NULL) {
+            notify_binding_finalized(env, binding->host, handle);
+            (*env)->DeleteGlobalRef(env, binding->host);
+        } else {
+            // Keep the ref until a thread with a JNI env can release it
+            StaleBinding stale = {.host = binding->host, .handle = handle};
+            cvector_push_back(globals->stale_bindings, stale);
+        }
+    }
+    free(binding);
+}
+
+static void unlink_host_instance(Globals *globals, HostInstance *host) {
+    if (host->prev != NULL) {
+        host->prev->next = host->next;
+    } else {
+        globals->host_instances = host->next;
+    }
+    if (host->next != NULL) {
+        host->next->prev = host->prev;
+    }
+    host->prev = NULL;
+    host->next = NULL;
+}
+
+static void host_instance_finalizer(JSRuntime *runtime, JSValue value) {
+    HostInstance *host = JS_GetOpaque(value, js_host_instance_class_id);
+    if (host == NULL) {
+        return;
+    }
+    if (host->globals != NULL) {
+        unlink_host_instance(host->globals, host);
+        JNIEnv *env = get_jni_env();
+        if (env != NULL) {
+            (*env)->DeleteGlobalRef(env, host->instance);
+        } else {
+            // Keep the ref until a thread with a JNI env can release it
+            cvector_push_back(host->globals->stale_host_refs, host->instance);
+        }
+    }
+    free(host);
+}
+
+void register_binding_class(JSRuntime *runtime, JSContext *context) {
+    pthread_once(&binding_class_id_once, new_binding_class_ids);
+    JSClassDef class_def = {
+            .class_name = "QuickJsBinding",
+            .finalizer = binding_finalizer,
+    };
+    JS_NewClass(runtime, js_binding_class_id, &class_def);
+    // Keep Object.prototype for binding objects
+    JS_SetClassProto(context, js_binding_class_id, JS_NewObject(context));
+
+    // Host instances are created with the prototypes of their classes
+    JSClassDef host_class_def = {
+            .class_name = "QuickJsHostInstance",
+            .finalizer = host_instance_finalizer,
+    };
+    JS_NewClass(runtime, js_host_instance_class_id, &host_class_def);
+}
+
+void release_binding_hosts(JNIEnv *env, Globals *globals) {
+    cvector_vector_type(BindingHost *)binding_hosts = globals->binding_hosts;
+    if (binding_hosts == NULL) {
+        return;
+    }
+    size_t size = cvector_size(binding_hosts);
+    for (size_t i = 0; i < size; i++) {
+        BindingHost *binding = binding_hosts[i];
+        (*env)->DeleteGlobalRef(env, binding->host);
+        binding->host = NULL;
+        binding->globals = NULL;
+    }
+    cvector_free(binding_hosts);
+    globals->binding_hosts = NULL;
+}
+
+static void clear_host_class_cache(JNIEnv *env, Globals *globals) {
+    cvector_vector_type(HostClassCacheEntry)cache = globals->host_class_cache;
+    if (cache == NULL) {
+        return;
+    }
+    size_t size = cvector_size(cache);
+    for (size_t i = 0; i < size; i++) {
+        (*env)->DeleteGlobalRef(env, cache[i].cls);
+    }
+    cvector_free(cache);
+    globals->host_class_cache = NULL;
+}
+
+/**
+ * Find the host class of the exact class of the object, it's resolved with IsInstanceOf()
+ * once per class and cached. Returns -1 if the object is not a host object.
+ */
+static int32_t host_class_index_of(JNIEnv *env, Globals *globals, jobject value) {
+    jclass cls = (*env)->GetObjectClass(env, value);
+    jint hash = (*env)->CallStaticIntMethod(env, cls_system(env),
+                                            method_system_identity_hash_code(env), cls);
+    cvector_vector_type(HostClassCacheEntry)cache = globals->host_class_cache;
+    size_t cache_size = cvector_size(cache);
+    for (size_t i = 0; i < cache_size; i++) {
+        if (cache[i].hash == hash && (*env)->IsSameObject(env, cache[i].cls, cls)) {
+            (*env)->DeleteLocalRef(env, cls);
+            return cache[i].class_index;
+        }
+    }
+
+    int32_t class_index = -1;
+    size_t size = cvector_size(globals->host_classes);
+    for (size_t i = 0; i < size; i++) {
+        if ((*env)->IsInstanceOf(env, value, globals->host_classes[i].cls)) {
+            class_index = (int32_t) i;
+            break;
+        }
+    }
+    HostClassCacheEntry entry = {
+            .hash = hash,
+            .cls = (*env)->NewGlobalRef(env, cls),
+            .class_index = class_index,
+    };
+    cvector_push_back(globals->host_class_cache, entry);
+    (*env)->DeleteLocalRef(env, cls);
+    return class_index;
+}
+
+void release_host_classes(JNIEnv *env, JSContext *context, Globals *globals) {
+    HostInstance *host = globals->host_instances;
+    while (host != NULL) {
+        HostInstance *next = host->next;
+        (*env)->DeleteGlobalRef(env, host->instance);
+        host->instance = NULL;
+        host->globals = NULL;
+        host->prev = NULL;
+        host->next = NULL;
+        host = next;
+    }
+    globals->host_instances = NULL;
+
+    clear_host_class_cache(env, globals);
+
+    cvector_vector_type(HostClass)host_classes = globals->host_classes;
+    if (host_classes == NULL) {
+        return;
+    }
+    size_t size = cvector_size(host_classes);
+    for (size_t i = 0; i < size; i++) {
+        (*env)->DeleteGlobalRef(env, host_classes[i].cls);
+        JS_FreeValue(context, host_classes[i].proto);
+    }
+    cvector_free(host_classes);
+    globals->host_classes = NULL;
+}
+
+JSValue new_host_instance(JNIEnv *env, JSContext *context, jobject value) {
+    Globals *globals = JS_GetContextOpaque(context);
+    if (globals == NULL) {
+        return JS_UNDEFINED;
+    }
+    if (cvector_size(globals->host_classes) == 0) {
+        return JS_UNDEFINED;
+    }
+    int32_t class_index = host_class_index_of(env, globals, value);
+    if (class_index < 0) {
+        return JS_UNDEFINED;
+    }
+    JSValue object = JS_NewObjectProtoClass(context, globals->host_classes[class_index].proto,
+                                            js_host_instance_class_id);
+    if (JS_IsException(object)) {
+        return object;
+    }
+    HostInstance *host = malloc(sizeof(HostInstance));
+    if (host == NULL) {
+        JS_FreeValue(context, object);
+        return JS_ThrowOutOfMemory(context);
+    }
+    host->instance = (*env)->NewGlobalRef(env, value);
+    host->class_index = class_index;
+    host->globals = globals;
+    // Link to the head
+    host->prev = NULL;
+    host->next = globals->host_instances;
+    if (host->next != NULL) {
+        host->next->prev = host;
+    }
+    globals->host_instances = host;
+    JS_SetOpaque(object, host);
+    return object;
+}
+
+jobject host_instance_to_jobject(JNIEnv *env, JSValue value) {
+    HostInstance *host = JS_GetOpaque(value, js_host_instance_class_id);
+    if (host == NULL || host->instance == NULL) {
+        return NULL;
+    }
+    return (*env)->NewLocalRef(env, host->instance);
+}
+
+/**
+ * Create a binding object, which owns a global ref of the host. The object is created with the
+ * shared prototype if the prototype index is not -1.
+ */
+static JSValue new_binding_object(JNIEnv *env, JSContext *context, Globals *globals,
+                                  jobject host, int64_t handle, int32_t prototype_index,
+                                  const char *call_type, const char *name) {
+    JSValue object;
+    if (prototype_index < 0) {
+        object = JS_NewObjectClass(context, (int) js_binding_class_id);
+    } else {
+        object = JS_NewObjectProtoClass(context, globals->shared_prototypes[prototype_index].proto,
+                                        js_binding_class_id);
+    }
+    if (JS_IsException(object)) {
+        return object;
+    }
+    BindingHost *binding = malloc(sizeof(BindingHost));
+    binding->host = (*env)->NewGlobalRef(env, host);
+    binding->handle = handle;
+    binding->prototype_index = prototype_index;
+    binding->globals = globals;
+    binding->host_index = cvector_size(globals->binding_hosts);
+    cvector_push_back(globals->binding_hosts, binding);
+    if (handle != GLOBAL_THIS_HANDLE) {
+        // Hidden holders are not reported, see handle_counts_to_java()
+        track_handle(globals, HANDLE_KIND_BINDING_OBJECT, call_type, name, binding);
+    }
+    JS_SetOpaque(object, binding);
+    return object;
+}
+
+static BindingHost *binding_host_from_func_data(JSValue *func_data) {
+    return JS_GetOpaque(func_data[0], js_binding_class_id);
+}
+
+/**
+ * Get the binding of a member call. Members of shared prototypes resolve it from 'this', the
+ * prototype index is stored in the function data. NULL is returned with a pending JS exception
+ * if the binding is not found or released.
+ */
+static BindingHost *binding_host_of_call(JSContext *context, JSValueConst this_val, int magic,
+                                         JSValue *func_data) {
+    BindingHost *binding;
+    if (magic == SHARED_MEMBER_MAGIC) {
+        binding = JS_GetOpaque(this_val, js_binding_class_id);
+        if (binding == NULL || binding->prototype_index != JS_VALUE_GET_INT(func_data[3])) {
+            JS_ThrowTypeError(context, "Illegal invocation");
+            return NULL;
+        }
+    } else {
+        binding = binding_host_from_func_data(func_data);
+    }
+    if (binding == NULL || binding->host == NULL) {
+        JS_ThrowInternalError(context, "Binding is already released.");
+        return NULL;
+    }
+    return binding;
+}
+
+/**
+ * Get the stats slot from the function data, NULL timing is returned if stats are disabled.
+ */
+static CallTiming *call_timing_from_func_data(BindingHost *binding, JSValue *func_data,
+                                              CallTiming *timing, int32_t *slot) {
+    Globals *globals = binding->globals;
+    if (globals == NULL || !binding_stats_is_timing(globals->binding_stats)) {
+        return NULL;
+    }
+    *slot = JS_VALUE_GET_INT(func_data[2]);
+    timing->arg_ns = 0;
+    timing->host_ns = 0;
+    timing->result_ns = 0;
+    return timing;
+}
+
+static void record_call_timing(BindingHost *binding, CallTiming *timing, int32_t slot,
+                               JSValue result) {
+    if (timing == NULL || binding->globals == NULL) {
+        return;
+    }
+    binding_stats_record(binding->globals->binding_stats, slot,
+                         timing->arg_ns, timing->host_ns, timing->result_ns,
+                         JS_IsException(result));
+}
+
 void set_eval_exception_to_caller(JNIEnv *env, jobject call_host, jthrowable exception) {
     jmethodID set_exception_method = method_quick_js_set_eval_exception(env);
     (*env)->CallVoidMethod(env, call_host, set_exception_method, exception);
 }
 
+/**
+ * Get the host instance of 'this', the class index is stored in the function data. NULL is
+ * returned with a pending JS exception if it's not an instance of the class.
+ */
+static HostInstance *host_instance_from_this(JSContext *context, JSValueConst this_val,
+                                             JSValue *func_data) {
+    HostInstance *host = JS_GetOpaque(this_val, js_host_instance_class_id);
+    if (host == NULL || host->class_index != JS_VALUE_GET_INT(func_data[3])) {
+        JS_ThrowTypeError(context, "Illegal invocation");
+        return NULL;
+    }
+    if (host->instance == NULL) {
+        JS_ThrowInternalError(context, "Binding is already released.");
+        return NULL;
+    }
+    return host;
+}
+
+/**
+ * Call the getter, it's a class member if the host instance is not NULL.
+ */
 JSValue jni_invoke_getter(JSContext *context, jobject call_host, int64_t object_handle,
-                          const char *property_name) {
+                          HostInstance *host, const char *property_name, CallTiming *timing) {
     JNIEnv *env = get_jni_env();
     if (env == NULL) {
         return JS_EXCEPTION;
     }
+    int64_t start = timing_now(timing);
     // Don't release
     jstring java_name = (*env)->NewStringUTF(env, property_name);
-    jobject result = (*env)->CallObjectMethod(env, call_host,
-                                              method_quick_js_on_call_getter(env),
-                                              object_handle, java_name);
+    jobject result;
+    if (host == NULL) {
+        result = (*env)->CallObjectMethod(env, call_host, method_quick_js_on_call_getter(env),
+                                          object_handle, java_name);
+    } else {
+        result = (*env)->CallObjectMethod(env, call_host,
+                                          method_quick_js_on_call_class_getter(env),
+                                          host->class_index, host->instance, java_name);
+    }
     (*env)->DeleteLocalRef(env, java_name);
+    if (timing != NULL) {
+        timing->host_ns = qjs_now_ns() - start;
+    }
     // Check java exceptions
     jthrowable exception = try_catch_java_exceptions(env);
     if (exception != NULL) {
@@ -39,11 +540,20 @@ JSValue jni_invoke_getter(JSContext *context, jobject call_host, int64_t object_
     if (result == NULL) {
         return JS_NULL;
     }
-    return jobject_to_js_value(env, context, NULL, result);
+    start = timing_now(timing);
+    JSValue value = jobject_to_js_value(env, context, NULL, result);
+    if (timing != NULL) {
+        timing->result_ns = qjs_now_ns() - start;
+    }
+    return value;
 }
 
+/**
+ * Call the setter, it's a class member if the host instance is not NULL.
+ */
 JSValue jni_invoke_setter(JSContext *context, jobject call_host, int64_t object_handle,
-                          const char *property_name, int argc, JSValueConst *argv) {
+                          HostInstance *host, const char *property_name,
+                          int argc, JSValueConst *argv, CallTiming *timing) {
     JNIEnv *env = get_jni_env();
     if (env == NULL) {
         return JS_EXCEPTION;
@@ -51,7 +561,11 @@ JSValue jni_invoke_setter(JSContext *context, jobject call_host, int64_t object_
     if (argc < 1) {
         return JS_EXCEPTION;
     }
+    int64_t start = timing_now(timing);
     jobject value = js_value_to_jobject(env, context, argv[0]);
+    if (timing != NULL) {
+        timing->arg_ns = qjs_now_ns() - start;
+    }
     // Check mapping exceptions
     jthrowable mapping_exception = try_catch_java_exceptions(env);
     if (mapping_exception != NULL) {
@@ -60,11 +574,20 @@ JSValue jni_invoke_setter(JSContext *context, jobject call_host, int64_t object_
         (*env)->DeleteLocalRef(env, mapping_exception);
         return JS_EXCEPTION;
     }
+    start = timing_now(timing);
     // Don't release
     jstring java_name = (*env)->NewStringUTF(env, property_name);
-    (*env)->CallVoidMethod(env, call_host, method_quick_js_on_call_setter(env),
-                           object_handle, java_name, value);
+    if (host == NULL) {
+        (*env)->CallVoidMethod(env, call_host, method_quick_js_on_call_setter(env),
+                               object_handle, java_name, value);
+    } else {
+        (*env)->CallVoidMethod(env, call_host, method_quick_js_on_call_class_setter(env),
+                               host->class_index, host->instance, java_name, value);
+    }
     (*env)->DeleteLocalRef(env, java_name);
+    if (timing != NULL) {
+        timing->host_ns = qjs_now_ns() - start;
+    }
     // Check java exceptions
     jthrowable exception = try_catch_java_exceptions(env);
     if (exception != NULL) {
@@ -75,12 +598,17 @@ JSValue jni_invoke_setter(JSContext *context, jobject call_host, int64_t object_
     return JS_UNDEFINED;
 }
 
+/**
+ * Call the function, it's a class member if the host instance is not NULL.
+ */
 JSValue jni_invoke_function(JSContext *context, jobject call_host, int64_t object_handle,
-                            const char *function_name, int argc, JSValueConst *argv) {
+                            HostInstance *host, const char *function_name,
+                            int argc, JSValueConst *argv, CallTiming *timing) {
     JNIEnv *env = get_jni_env();
     if (env == NULL) {
         return JS_EXCEPTION;
     }
+    int64_t start = timing_now(timing);
     jobjectArray args = (*env)->NewObjectArray(env, argc, cls_object(env), NULL);
     for (uint32_t i = 0; i < argc; i++) {
         jobject arg = js_value_to_jobject(env, context, argv[i]);
@@ -95,14 +623,26 @@ JSValue jni_invoke_function(JSContext *context, jobject call_host, int64_t objec
         (*env)->SetObjectArrayElement(env, args, i, arg);
         (*env)->DeleteLocalRef(env, arg);
     }
+    if (timing != NULL) {
+        int64_t now = qjs_now_ns();
+        timing->arg_ns = now - start;
+        start = now;
+    }
     // Don't release
     jstring java_name = (*env)->NewStringUTF(env, function_name);
-    jobject result = (*env)->CallObjectMethod(env, call_host,
-                                              method_quick_js_on_call_function(env),
-                                              object_handle,
-                                              java_name,
-                                              args);
+    jobject result;
+    if (host == NULL) {
+        result = (*env)->CallObjectMethod(env, call_host, method_quick_js_on_call_function(env),
+                                          object_handle, java_name, args);
+    } else {
+        result = (*env)->CallObjectMethod(env, call_host,
+                                          method_quick_js_on_call_class_function(env),
+                                          host->class_index, host->instance, java_name, args);
+    }
     (*env)->DeleteLocalRef(env, java_name);
+    if (timing != NULL) {
+        timing->host_ns = qjs_now_ns() - start;
+    }
     // Check java exceptions
     jthrowable exception = try_catch_java_exceptions(env);
     if (exception != NULL) {
@@ -110,7 +650,12 @@ JSValue jni_invoke_function(JSContext *context, jobject call_host, int64_t objec
         (*env)->DeleteLocalRef(env, exception);
         return JS_EXCEPTION;
     }
-    return jobject_to_js_value(env, context, NULL, result);
+    start = timing_now(timing);
+    JSValue value = jobject_to_js_value(env, context, NULL, result);
+    if (timing != NULL) {
+        timing->result_ns = qjs_now_ns() - start;
+    }
+    return value;
 }
 
 JSValue jni_invoke_async_function(JSContext *context, jobject call_host,
@@ -118,11 +663,13 @@ JSValue jni_invoke_async_function(JSContext *context, jobject call_host,
                                   const char *function_name,
                                   uint64_t resolve_handle,
                                   uint64_t reject_handle,
-                                  int argc, JSValueConst *argv) {
+                                  int argc, JSValueConst *argv,
+                                  CallTiming *timing) {
     JNIEnv *env = get_jni_env();
     if (env == NULL) {
         return JS_EXCEPTION;
     }
+    int64_t start = timing_now(timing);
     int args_len = argc + 2;
     jobjectArray args = (*env)->NewObjectArray(env, args_len, cls_object(env), NULL);
     // Set promise handles
@@ -142,14 +689,23 @@ JSValue jni_invoke_async_function(JSContext *context, jobject call_host,
         (*env)->SetObjectArrayElement(env, args, i + (args_len - argc), arg);
         (*env)->DeleteLocalRef(env, arg);
     }
+    if (timing != NULL) {
+        int64_t now = qjs_now_ns();
+        timing->arg_ns = now - start;
+        start = now;
+    }
     // Don't release
     jstring java_name = (*env)->NewStringUTF(env, function_name);
+    // The host launches the call and returns, the execution time doesn't include the async work
     (*env)->CallObjectMethod(env, call_host,
                              method_quick_js_on_call_function(env),
                              object_handle,
                              java_name,
                              args);
     (*env)->DeleteLocalRef(env, java_name);
+    if (timing != NULL) {
+        timing->host_ns = qjs_now_ns() - start;
+    }
     // Check java exceptions
     jthrowable exception = try_catch_java_exceptions(env);
     if (exception != NULL) {
@@ -164,14 +720,20 @@ JSValue jni_invoke_async_function(JSContext *context, jobject call_host,
 JSValue
 property_getter(JSContext *context, JSValueConst this_val, int argc, JSValueConst *argv, int magic,
                 JSValue *func_data) {
-    int64_t host_address;
-    JS_ToInt64(context, &host_address, func_data[0]);
-    jobject call_host = (jobject) host_address;
-    int64_t object_handle;
-    JS_ToInt64(context, &object_handle, func_data[1]);
-    const char *prop_name = JS_ToCString(context, func_data[2]);
+    BindingHost *binding = binding_host_of_call(context, this_val, magic, func_data);
+    if (binding == NULL) {
+        return JS_EXCEPTION;
+    }
+    const char *prop_name = JS_ToCString(context, func_data[1]);
 
-    JSValue result = jni_invoke_getter(context, call_host, object_handle, prop_name);
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
+
+    JSValue result = jni_invoke_getter(context, binding->host, binding->handle, NULL,
+                                       prop_name, timing);
+
+    record_call_timing(binding, timing, slot, result);
 
     JS_FreeCString(context, prop_name);
 
@@ -181,14 +743,20 @@ property_getter(JSContext *context, JSValueConst this_val, int argc, JSValueCons
 JSValue
 property_setter(JSContext *context, JSValueConst this_val, int argc, JSValueConst *argv, int magic,
                 JSValue *func_data) {
-    int64_t host_address;
-    JS_ToInt64(context, &host_address, func_data[0]);
-    jobject call_host = (jobject) host_address;
-    int64_t object_handle;
-    JS_ToInt64(context, &object_handle, func_data[1]);
-    const char *prop_name = JS_ToCString(context, func_data[2]);
+    BindingHost *binding = binding_host_of_call(context, this_val, magic, func_data);
+    if (binding == NULL) {
+        return JS_EXCEPTION;
+    }
+    const char *prop_name = JS_ToCString(context, func_data[1]);
 
-    JSValue result = jni_invoke_setter(context, call_host, object_handle, prop_name, argc, argv);
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
+
+    JSValue result = jni_invoke_setter(context, binding->host, binding->handle, NULL,
+                                       prop_name, argc, argv, timing);
+
+    record_call_timing(binding, timing, slot, result);
 
     JS_FreeCString(context, prop_name);
 
@@ -198,14 +766,101 @@ property_setter(JSContext *context, JSValueConst this_val, int argc, JSValueCons
 JSValue
 function_invoke(JSContext *context, JSValueConst this_val, int argc, JSValueConst *argv, int magic,
                 JSValue *func_data) {
-    int64_t host_address;
-    JS_ToInt64(context, &host_address, func_data[0]);
-    jobject call_host = (jobject) host_address;
-    int64_t object_handle;
-    JS_ToInt64(context, &object_handle, func_data[1]);
-    const char *func_name = JS_ToCString(context, func_data[2]);
+    BindingHost *binding = binding_host_of_call(context, this_val, magic, func_data);
+    if (binding == NULL) {
+        return JS_EXCEPTION;
+    }
+    const char *func_name = JS_ToCString(context, func_data[1]);
+
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
 
-    JSValue result = jni_invoke_function(context, call_host, object_handle, func_name, argc, argv);
+    JSValue result = jni_invoke_function(context, binding->host, binding->handle, NULL,
+                                         func_name, argc, argv, timing);
+
+    record_call_timing(binding, timing, slot, result);
+
+    JS_FreeCString(context, func_name);
+
+    return result;
+}
+
+JSValue
+class_property_getter(JSContext *context, JSValueConst this_val, int argc, JSValueConst *argv,
+                      int magic, JSValue *func_data) {
+    BindingHost *binding = binding_host_from_func_data(func_data);
+    if (binding == NULL || binding->host == NULL) {
+        return JS_ThrowInternalError(context, "Binding is already released.");
+    }
+    HostInstance *host = host_instance_from_this(context, this_val, func_data);
+    if (host == NULL) {
+        return JS_EXCEPTION;
+    }
+    const char *prop_name = JS_ToCString(context, func_data[1]);
+
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
+
+    JSValue result = jni_invoke_getter(context, binding->host, GLOBAL_THIS_HANDLE, host,
+                                       prop_name, timing);
+
+    record_call_timing(binding, timing, slot, result);
+
+    JS_FreeCString(context, prop_name);
+
+    return result;
+}
+
+JSValue
+class_property_setter(JSContext *context, JSValueConst this_val, int argc, JSValueConst *argv,
+                      int magic, JSValue *func_data) {
+    BindingHost *binding = binding_host_from_func_data(func_data);
+    if (binding == NULL || binding->host == NULL) {
+        return JS_ThrowInternalError(context, "Binding is already released.");
+    }
+    HostInstance *host = host_instance_from_this(context, this_val, func_data);
+    if (host == NULL) {
+        return JS_EXCEPTION;
+    }
+    const char *prop_name = JS_ToCString(context, func_data[1]);
+
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
+
+    JSValue result = jni_invoke_setter(context, binding->host, GLOBAL_THIS_HANDLE, host,
+                                       prop_name, argc, argv, timing);
+
+    record_call_timing(binding, timing, slot, result);
+
+    JS_FreeCString(context, prop_name);
+
+    return result;
+}
+
+JSValue
+class_function_invoke(JSContext *context, JSValueConst this_val, int argc, JSValueConst *argv,
+                      int magic, JSValue *func_data) {
+    BindingHost *binding = binding_host_from_func_data(func_data);
+    if (binding == NULL || binding->host == NULL) {
+        return JS_ThrowInternalError(context, "Binding is already released.");
+    }
+    HostInstance *host = host_instance_from_this(context, this_val, func_data);
+    if (host == NULL) {
+        return JS_EXCEPTION;
+    }
+    const char *func_name = JS_ToCString(context, func_data[1]);
+
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
+
+    JSValue result = jni_invoke_function(context, binding->host, GLOBAL_THIS_HANDLE, host,
+                                         func_name, argc, argv, timing);
+
+    record_call_timing(binding, timing, slot, result);
 
     JS_FreeCString(context, func_name);
 
@@ -220,25 +875,14 @@ JSValue async_function_invoke(JSContext *context, JSValueConst this_val,
         return JS_EXCEPTION;
     }
 
-    // Get the jni host
-    int64_t host_address;
-    JS_ToInt64(context, &host_address, func_data[0]);
-    jobject call_host = (jobject) host_address;
-
-    // Get the parent handle
-    int64_t object_handle;
-    JS_ToInt64(context, &object_handle, func_data[1]);
+    BindingHost *binding = binding_host_of_call(context, this_val, magic, func_data);
+    if (binding == NULL) {
+        return JS_EXCEPTION;
+    }
+    Globals *globals = binding->globals;
 
     // Get the function name
-    const char *function_name = JS_ToCString(context, func_data[2]);
-
-    // Get globals
-    int64_t globals_address_low;
-    int64_t globals_address_high;
-    JS_ToInt64(context, &globals_address_low, func_data[3]);
-    JS_ToInt64(context, &globals_address_high, func_data[4]);
-    int64_t globals_address = (globals_address_low & 0xFFFFFFFF) | globals_address_high << 32;
-    Globals *globals = (Globals *) globals_address;
+    const char *function_name = JS_ToCString(context, func_data[1]);
 
     // Handles are the indices
     int64_t resolve_handle = cvector_size(globals->created_js_functions);
@@ -251,10 +895,20 @@ JSValue async_function_invoke(JSContext *context, JSValueConst this_val,
     cvector_push_back(globals->created_js_functions, promise_functions[0]);
     cvector_push_back(globals->created_js_functions, promise_functions[1]);
 
+    track_handle(globals, HANDLE_KIND_MANAGED_JS_VALUE, "asyncCall", function_name, NULL);
+    track_handle(globals, HANDLE_KIND_PROMISE_FUNCTION, "asyncCall", function_name, NULL);
+    track_handle(globals, HANDLE_KIND_PROMISE_FUNCTION, "asyncCall", function_name, NULL);
+
+    CallTiming timing_data;
+    int32_t slot = -1;
+    CallTiming *timing = call_timing_from_func_data(binding, func_data, &timing_data, &slot);
+
     // Call java function
-    JSValue result = jni_invoke_async_function(context, call_host, object_handle,
+    JSValue result = jni_invoke_async_function(context, binding->host, binding->handle,
                                                function_name, resolve_handle, reject_handle,
-                                               argc, argv);
+                                               argc, argv, timing);
+
+    record_call_timing(binding, timing, slot, result);
 
     JS_FreeCString(context, function_name);
 
@@ -271,45 +925,38 @@ JSValue async_function_invoke(JSContext *context, JSValueConst this_val,
     return JS_DupValue(context, promise);
 }
 
-void define_async_js_function_on(JSContext *context,
-                                 Globals *globals,
-                                 JSValue parent,
-                                 const char *name,
-                                 int func_data_len,
-                                 JSValue *func_data) {
-    // Append the globals pointer to the function data
-    size_t async_func_data_len = func_data_len + 2;
-    JSValue async_func_data[async_func_data_len];
-    for (int i = 0; i < func_data_len; ++i) {
-        async_func_data[i] = func_data[i];
-    }
-    int64_t globals_address = (int64_t) (globals);
-    int64_t globals_low = globals_address & 0xFFFFFFFF;
-    int64_t globals_high = (globals_address >> 32) & 0xFFFFFFFF;
-    async_func_data[func_data_len] = JS_NewInt64(context, globals_low);
-    async_func_data[func_data_len + 1] = JS_NewInt64(context, globals_high);
-
-    for (int i = func_data_len; i < async_func_data_len; ++i) {
-        // Add to free
-        cvector_push_back(globals->managed_js_values, async_func_data[i]);
-    }
-
-    JSValue invoke = JS_NewCFunctionData(context, async_function_invoke, 0, 0,
-                                         async_func_data_len,
-                                         async_func_data);
-    int flags = JS_PROP_CONFIGURABLE;
-    JSAtom prop = JS_NewAtom(context, name);
-    // Define async function
-    JS_DefinePropertyValue(context, parent, prop, invoke, flags);
-    JS_FreeAtom(context, prop);
+/**
+ * Register a binding member to the stats, the slot is stored in the function data.
+ */
+static int32_t register_stats_slot(Globals *globals, const char *parent_name,
+                                   const char *name, BindingCallType call_type) {
+    if (parent_name == NULL) {
+        return binding_stats_register(globals->binding_stats, name, call_type);
+    }
+    size_t len = strlen(parent_name) + strlen(name) + 2;
+    char *full_name = malloc(len);
+    if (full_name == NULL) {
+        return -1;
+    }
+    snprintf(full_name, len, "%s.%s", parent_name, name);
+    int32_t slot = binding_stats_register(globals->binding_stats, full_name, call_type);
+    free(full_name);
+    return slot;
 }
 
+/**
+ * Define a function to the parent, the function data is [binding object, function name,
+ * stats slot], members of shared prototypes also have the prototype index.
+ */
 void define_js_function_on(JSContext *context,
                            JSValue parent,
                            const char *name,
-                           int func_data_len,
+                           jboolean is_async,
+                           int magic,
+                           int data_len,
                            JSValue *func_data) {
-    JSValue invoke = JS_NewCFunctionData(context, function_invoke, 0, 0, func_data_len, func_data);
+    JSCFunctionData *func = is_async ? async_function_invoke : function_invoke;
+    JSValue invoke = JS_NewCFunctionData(context, func, 0, magic, data_len, func_data);
     int flags = JS_PROP_CONFIGURABLE;
     JSAtom prop = JS_NewAtom(context, name);
     // Define function
@@ -317,12 +964,48 @@ void define_js_function_on(JSContext *context,
     JS_FreeAtom(context, prop);
 }
 
+/**
+ * Define a function of a binding object to the parent, the owner is the binding object in the
+ * function data. If the prototype index is not -1, the parent is a shared prototype.
+ */
+static void define_js_member_function_on(JSContext *context,
+                                         Globals *globals,
+                                         JSValue parent,
+                                         JSValue owner,
+                                         int32_t prototype_index,
+                                         const char *parent_name,
+                                         const char *func_name,
+                                         jboolean is_async) {
+    int magic = prototype_index < 0 ? 0 : SHARED_MEMBER_MAGIC;
+    int data_len = prototype_index < 0 ? FUNC_DATA_LEN : SHARED_FUNC_DATA_LEN;
+
+    // Function data, the function keeps the owner alive
+    BindingCallType call_type = is_async ? BINDING_CALL_ASYNC_FUNCTION : BINDING_CALL_FUNCTION;
+    JSValue func_data[SHARED_FUNC_DATA_LEN] = {
+            owner,
+            JS_NewString(context, func_name),
+            JS_NewInt32(context, register_stats_slot(globals, parent_name, func_name,
+                                                     call_type)),
+            JS_NewInt32(context, prototype_index),
+    };
+
+    define_js_function_on(context, parent, func_name, is_async, magic, data_len, func_data);
+
+    JS_FreeValue(context, func_data[1]);
+}
+
+/**
+ * Define functions to the parent, the owner is the binding object in the function data. If the
+ * prototype index is not -1, the parent is a shared prototype.
+ */
 void define_js_functions_on(JNIEnv *env,
                             JSContext *context,
                             Globals *globals,
                             JSValue parent,
-                            jobjectArray functions,
-                            JSValue *common_func_data) {
+                            JSValue owner,
+                            int32_t prototype_index,
+                            const char *parent_name,
+                            jobjectArray functions) {
     jsize func_size = (*env)->GetArrayLength(env, functions);
 
     jfieldID field_name = field_js_function_name(env);
@@ -335,154 +1018,926 @@ void define_js_functions_on(JNIEnv *env,
         const char *func_name = (*env)->GetStringUTFChars(env, j_fun_name, NULL);
         jboolean is_async = (*env)->GetBooleanField(env, j_fun, field_is_async);
 
-        // Function data
-        uint32_t data_len = COMMON_FUNC_DATA_LEN + 1;
-        JSValue func_data[data_len];
-        for (int j = 0; j < data_len - 1; j++) {
-            func_data[j] = common_func_data[j];
-        }
-        JSValue js_func_name = JS_NewString(context, func_name);
-        cvector_push_back(globals->managed_js_values, js_func_name);
-        func_data[data_len - 1] = js_func_name;
-
-        if (is_async) {
-            define_async_js_function_on(context, globals, parent, func_name, data_len, func_data);
-        } else {
-            define_js_function_on(context, parent, func_name, data_len, func_data);
-        }
+        define_js_member_function_on(context, globals, parent, owner, prototype_index,
+                                     parent_name, func_name, is_async);
 
         (*env)->ReleaseStringUTFChars(env, j_fun_name, func_name);
         (*env)->DeleteLocalRef(env, j_fun_name);
+        (*env)->DeleteLocalRef(env, j_fun);
     }
 }
 
-JSValue define_js_object(JNIEnv *env, JSContext *context,
-                         Globals *globals,
-                         jobject host,
-                         JSValue *parent,
-                         int64_t handle,
-                         jstring name,
-                         jobjectArray properties,
-                         jobjectArray functions) {
-    jobject global_host = (*env)->NewGlobalRef(env, host);
-    cvector_push_back(globals->global_object_refs, global_host);
+/**
+ * Define an accessor of a binding object to the parent, the owner is the binding object in the
+ * function data. If the prototype index is not -1, the parent is a shared prototype.
+ */
+static void define_js_accessor_on(JSContext *context,
+                                  Globals *globals,
+                                  JSValue parent,
+                                  JSValue owner,
+                                  int32_t prototype_index,
+                                  const char *parent_name,
+                                  const char *prop_name,
+                                  jboolean configurable,
+                                  jboolean writable,
+                                  jboolean enumerable) {
+    int magic = prototype_index < 0 ? 0 : SHARED_MEMBER_MAGIC;
+    int data_len = prototype_index < 0 ? FUNC_DATA_LEN : SHARED_FUNC_DATA_LEN;
+
+    // Function data, accessors keep the owner alive
+    JSValue func_data[SHARED_FUNC_DATA_LEN] = {
+            owner,
+            JS_NewString(context, prop_name),
+            JS_NewInt32(context, register_stats_slot(globals, parent_name, prop_name,
+                                                     BINDING_CALL_GETTER)),
+            JS_NewInt32(context, prototype_index),
+    };
 
-    jsize prop_size = (*env)->GetArrayLength(env, properties);
+    JSValue getter = JS_NewCFunctionData(context, property_getter, 0, magic, data_len,
+                                         func_data);
+    int flags = JS_PROP_C_W_E;
+    if (configurable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_CONFIGURABLE;
+    }
+    if (writable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_WRITABLE;
+    }
+    if (enumerable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_ENUMERABLE;
+    }
 
-    JSValue common_func_data[COMMON_FUNC_DATA_LEN] = {
-            JS_NewInt64(context, (int64_t) global_host), // host address
-            JS_NewInt64(context, handle), // object handle
-    };
+    JSAtom prop = JS_NewAtom(context, prop_name);
 
-    // Free these values before freeing the runtime
-    for (uint32_t i = 0; i < COMMON_FUNC_DATA_LEN; i++) {
-        cvector_push_back(globals->managed_js_values, common_func_data[i]);
+    // Define property
+    if (writable == JNI_FALSE) {
+        JS_DefinePropertyGetSet(context, parent, prop, getter, JS_UNDEFINED, 0);
+    } else {
+        func_data[2] = JS_NewInt32(context, register_stats_slot(globals, parent_name,
+                                                                prop_name,
+                                                                BINDING_CALL_SETTER));
+        JSValue setter = JS_NewCFunctionData(context, property_setter, 0, magic, data_len,
+                                             func_data);
+        JS_DefinePropertyGetSet(context, parent, prop, getter, setter, flags);
     }
 
-    JSValue object = JS_NewObject(context);
+    JS_FreeAtom(context, prop);
+    JS_FreeValue(context, func_data[1]);
+}
+
+/**
+ * Define accessors to the parent, the owner is the binding object in the function data. If the
+ * prototype index is not -1, the parent is a shared prototype.
+ */
+static void define_js_properties_on(JNIEnv *env,
+                                    JSContext *context,
+                                    Globals *globals,
+                                    JSValue parent,
+                                    JSValue owner,
+                                    int32_t prototype_index,
+                                    const char *parent_name,
+                                    jobjectArray properties) {
+    jsize prop_size = (*env)->GetArrayLength(env, properties);
 
-    // Add properties
     for (jsize i = 0; i < prop_size; i++) {
         jobject element = (*env)->GetObjectArrayElement(env, properties, i);
+        if ((*env)->GetBooleanField(env, element, field_js_property_is_constant(env))) {
+            // Constants are defined on the object by define_js_constants_on()
+            (*env)->DeleteLocalRef(env, element);
+            continue;
+        }
+
+        jstring j_prop_name = (*env)->GetObjectField(env, element, field_js_property_name(env));
+        const char *prop_name = (*env)->GetStringUTFChars(env, j_prop_name, NULL);
+        jboolean configurable = (*env)->GetBooleanField(env, element,
+                                                        field_js_property_configurable(env));
+        jboolean writable = (*env)->GetBooleanField(env, element, field_js_property_writable(env));
+        jboolean enumerable = (*env)->GetBooleanField(env, element,
+                                                      field_js_property_enumerable(env));
+
+        define_js_accessor_on(context, globals, parent, owner, prototype_index, parent_name,
+                              prop_name, configurable, writable, enumerable);
+
+        (*env)->ReleaseStringUTFChars(env, j_prop_name, prop_name);
+        (*env)->DeleteLocalRef(env, j_prop_name);
+        (*env)->DeleteLocalRef(env, element);
+    }
+}
+
+/**
+ * Define a constant as a plain data property, returns -1 if the value can't be converted.
+ */
+static int define_js_constant_on(JNIEnv *env, JSContext *context, JSValue object,
+                                 const char *prop_name, jobject j_value,
+                                 jboolean configurable, jboolean writable, jboolean enumerable) {
+    JSValue value = j_value == NULL ? JS_NULL : jobject_to_js_value(env, context, NULL, j_value);
+    if (JS_IsException(value)) {
+        return -1;
+    }
+    int flags = JS_PROP_C_W_E;
+    if (configurable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_CONFIGURABLE;
+    }
+    if (writable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_WRITABLE;
+    }
+    if (enumerable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_ENUMERABLE;
+    }
+    JS_DefinePropertyValueStr(context, object, prop_name, value, flags);
+    return 0;
+}
+
+/**
+ * Define constant properties as plain data properties, their values are converted once so
+ * reads never call the host. Returns -1 if a value can't be converted.
+ */
+static int define_js_constants_on(JNIEnv *env, JSContext *context, JSValue object,
+                                  jobjectArray properties) {
+    jsize prop_size = (*env)->GetArrayLength(env, properties);
+    int ret = 0;
+
+    for (jsize i = 0; i < prop_size && ret == 0; i++) {
+        jobject element = (*env)->GetObjectArrayElement(env, properties, i);
+        if (!(*env)->GetBooleanField(env, element, field_js_property_is_constant(env))) {
+            (*env)->DeleteLocalRef(env, element);
+            continue;
+        }
 
         jstring j_prop_name = (*env)->GetObjectField(env, element, field_js_property_name(env));
         const char *prop_name = (*env)->GetStringUTFChars(env, j_prop_name, NULL);
+        jobject j_value = (*env)->GetObjectField(env, element, field_js_property_value(env));
         jboolean configurable = (*env)->GetBooleanField(env, element,
                                                         field_js_property_configurable(env));
         jboolean writable = (*env)->GetBooleanField(env, element, field_js_property_writable(env));
         jboolean enumerable = (*env)->GetBooleanField(env, element,
                                                       field_js_property_enumerable(env));
 
-        // Function data
-        uint32_t data_len = COMMON_FUNC_DATA_LEN + 1;
-        JSValue func_data[data_len];
-        for (int j = 0; j < data_len - 1; j++) {
-            func_data[j] = common_func_data[j];
+        ret = define_js_constant_on(env, context, object, prop_name, j_value, configurable,
+                                    writable, enumerable);
+
+        (*env)->ReleaseStringUTFChars(env, j_prop_name, prop_name);
+        (*env)->DeleteLocalRef(env, j_prop_name);
+        if (j_value != NULL) {
+            (*env)->DeleteLocalRef(env, j_value);
         }
-        JSValue js_prop_name = JS_NewString(context, prop_name);
-        cvector_push_back(globals->managed_js_values, js_prop_name);
-        func_data[data_len - 1] = js_prop_name;
-
-        JSValue getter = JS_NewCFunctionData(context, property_getter, 0, 0, data_len, func_data);
-        int flags = JS_PROP_C_W_E;
-        if (configurable == JNI_FALSE) {
-            flags = flags & ~JS_PROP_CONFIGURABLE;
+        (*env)->DeleteLocalRef(env, element);
+    }
+
+    return ret;
+}
+
+/**
+ * Members of a binding which uses a shared prototype, constants are left out since they are
+ * defined on each object.
+ */
+typedef struct {
+    cvector_vector_type(char *)entries;
+    int failed;
+} MemberSignature;
+
+static void member_signature_add(MemberSignature *signature, char kind, int flags,
+                                 const char *name) {
+    size_t len = strlen(name) + 8;
+    char *entry = malloc(len);
+    if (entry == NULL) {
+        signature->failed = 1;
+        return;
+    }
+    snprintf(entry, len, "%c%d %s", kind, flags, name);
+    cvector_push_back(signature->entries, entry);
+}
+
+static int compare_member_entries(const void *a, const void *b) {
+    return strcmp(*(char *const *) a, *(char *const *) b);
+}
+
+/**
+ * Join the sorted entries, so the same members in a different order match. The entries are
+ * freed, returns NULL if it's out of memory.
+ */
+static char *member_signature_finish(MemberSignature *signature) {
+    size_t count = cvector_size(signature->entries);
+    char *result = NULL;
+    if (!signature->failed) {
+        if (count > 0) {
+            qsort(signature->entries, count, sizeof(char *), compare_member_entries);
         }
-        if (writable == JNI_FALSE) {
-            flags = flags & ~JS_PROP_WRITABLE;
+        size_t total = 1;
+        for (size_t i = 0; i < count; i++) {
+            total += strlen(signature->entries[i]) + 1;
         }
-        if (enumerable == JNI_FALSE) {
-            flags = flags & ~JS_PROP_ENUMERABLE;
+        result = malloc(total);
+        if (result != NULL) {
+            char *p = result;
+            for (size_t i = 0; i < count; i++) {
+                size_t len = strlen(signature->entries[i]);
+                memcpy(p, signature->entries[i], len);
+                p[len] = '\n';
+                p += len + 1;
+            }
+            *p = '\0';
         }
+    }
+    for (size_t i = 0; i < count; i++) {
+        free(signature->entries[i]);
+    }
+    cvector_free(signature->entries);
+    signature->entries = NULL;
+    return result;
+}
 
-        JSAtom prop = JS_NewAtom(context, prop_name);
+/**
+ * Get the member signature of binding properties and functions.
+ */
+static char *object_member_signature(JNIEnv *env, jobjectArray properties,
+                                     jobjectArray functions) {
+    MemberSignature signature = {.entries = NULL, .failed = 0};
 
-        // Define property
-        if (writable == JNI_FALSE) {
-            JS_DefinePropertyGetSet(context, object, prop, getter, JS_UNDEFINED, 0);
-        } else {
-            JSValue setter = JS_NewCFunctionData(context, property_setter, 0, 0, data_len,
-                                                 func_data);
-            JS_DefinePropertyGetSet(context, object, prop, getter, setter, flags);
+    jsize prop_size = (*env)->GetArrayLength(env, properties);
+    for (jsize i = 0; i < prop_size; i++) {
+        jobject element = (*env)->GetObjectArrayElement(env, properties, i);
+        if (!(*env)->GetBooleanField(env, element, field_js_property_is_constant(env))) {
+            int flags = 0;
+            if ((*env)->GetBooleanField(env, element, field_js_property_configurable(env))) {
+                flags |= TREE_PROPERTY_CONFIGURABLE;
+            }
+            if ((*env)->GetBooleanField(env, element, field_js_property_writable(env))) {
+                flags |= TREE_PROPERTY_WRITABLE;
+            }
+            if ((*env)->GetBooleanField(env, element, field_js_property_enumerable(env))) {
+                flags |= TREE_PROPERTY_ENUMERABLE;
+            }
+            jstring j_name = (*env)->GetObjectField(env, element, field_js_property_name(env));
+            const char *name = (*env)->GetStringUTFChars(env, j_name, NULL);
+            member_signature_add(&signature, 'p', flags, name);
+            (*env)->ReleaseStringUTFChars(env, j_name, name);
+            (*env)->DeleteLocalRef(env, j_name);
         }
+        (*env)->DeleteLocalRef(env, element);
+    }
 
-        JS_FreeAtom(context, prop);
+    jsize func_size = (*env)->GetArrayLength(env, functions);
+    for (jsize i = 0; i < func_size; i++) {
+        jobject j_fun = (*env)->GetObjectArrayElement(env, functions, i);
+        jstring j_name = (*env)->GetObjectField(env, j_fun, field_js_function_name(env));
+        const char *name = (*env)->GetStringUTFChars(env, j_name, NULL);
+        int flags = (*env)->GetBooleanField(env, j_fun, field_js_function_is_async(env))
+                    ? TREE_FUNCTION_ASYNC : 0;
+        member_signature_add(&signature, 'f', flags, name);
+        (*env)->ReleaseStringUTFChars(env, j_name, name);
+        (*env)->DeleteLocalRef(env, j_name);
+        (*env)->DeleteLocalRef(env, j_fun);
+    }
 
-        (*env)->ReleaseStringUTFChars(env, j_prop_name, prop_name);
-        (*env)->DeleteLocalRef(env, j_prop_name);
-        (*env)->DeleteLocalRef(env, element);
+    return member_signature_finish(&signature);
+}
+
+/**
+ * Find the shared prototype of the key, returns -1 if it's not created.
+ */
+static int32_t find_shared_prototype(Globals *globals, const char *key) {
+    size_t size = cvector_size(globals->shared_prototypes);
+    for (size_t i = 0; i < size; i++) {
+        if (strcmp(globals->shared_prototypes[i].key, key) == 0) {
+            return (int32_t) i;
+        }
     }
+    return -1;
+}
 
-    // Add functions
-    define_js_functions_on(env, context, globals, object, functions, common_func_data);
+/**
+ * Check the members of a binding which reuses the shared prototype at the index, bindings
+ * with different members can't share a key. The members are freed, returns the index, or -1
+ * with a thrown exception on a mismatch.
+ */
+static int32_t check_shared_prototype(JNIEnv *env, Globals *globals, int32_t index,
+                                      const char *key, char *members) {
+    int matched = strcmp(globals->shared_prototypes[index].members, members) == 0;
+    free(members);
+    if (!matched) {
+        jni_throw_qjs_exception(env, "Bindings with different members can't share the "
+                                     "prototype key '%s'.", key);
+        return -1;
+    }
+    return index;
+}
 
-    const char *c_name = (*env)->GetStringUTFChars(env, name, NULL);
+/**
+ * Add a shared prototype, the key is copied, the members and the prototype are owned by the
+ * globals.
+ */
+static void add_shared_prototype(Globals *globals, const char *key, char *members,
+                                 JSValue proto) {
+    size_t key_len = strlen(key) + 1;
+    SharedPrototype shared = {
+            .key = malloc(key_len),
+            .members = members,
+            .proto = proto,
+    };
+    memcpy(shared.key, key, key_len);
+    cvector_push_back(globals->shared_prototypes, shared);
+}
 
+/**
+ * Get the index of the prototype shared by objects with the key, it's created with the members
+ * on the first call. The function data of the members is [hidden binding object, name, stats
+ * slot, prototype index].
+ */
+static int32_t shared_prototype_index(JNIEnv *env, JSContext *context, Globals *globals,
+                                      jobject host, jstring prototype_key,
+                                      jobjectArray properties, jobjectArray functions) {
+    const char *key = (*env)->GetStringUTFChars(env, prototype_key, NULL);
+    char *members = object_member_signature(env, properties, functions);
+    if (members == NULL) {
+        jni_throw_qjs_exception(env, "Failed to read members of the prototype '%s'.", key);
+        (*env)->ReleaseStringUTFChars(env, prototype_key, key);
+        return -1;
+    }
+    int32_t found = find_shared_prototype(globals, key);
+    if (found >= 0) {
+        found = check_shared_prototype(env, globals, found, key, members);
+        (*env)->ReleaseStringUTFChars(env, prototype_key, key);
+        return found;
+    }
+
+    // A hidden binding object which owns the host ref of the prototype members
+    JSValue holder = new_binding_object(env, context, globals, host, GLOBAL_THIS_HANDLE, -1,
+                                        "sharedPrototype", key);
+    if (JS_IsException(holder)) {
+        free(members);
+        (*env)->ReleaseStringUTFChars(env, prototype_key, key);
+        return -1;
+    }
+
+    int32_t prototype_index = (int32_t) cvector_size(globals->shared_prototypes);
+    JSValue proto = JS_NewObject(context);
+    define_js_properties_on(env, context, globals, proto, holder, prototype_index, key,
+                            properties);
+    define_js_functions_on(env, context, globals, proto, holder, prototype_index, key,
+                           functions);
+    JS_FreeValue(context, holder);
+
+    add_shared_prototype(globals, key, members, proto);
+
+    (*env)->ReleaseStringUTFChars(env, prototype_key, key);
+    return prototype_index;
+}
+
+void release_shared_prototypes(JSContext *context, Globals *globals) {
+    cvector_vector_type(SharedPrototype)shared_prototypes = globals->shared_prototypes;
+    if (shared_prototypes == NULL) {
+        return;
+    }
+    size_t size = cvector_size(shared_prototypes);
+    for (size_t i = 0; i < size; i++) {
+        free(shared_prototypes[i].key);
+        free(shared_prototypes[i].members);
+        JS_FreeValue(context, shared_prototypes[i].proto);
+    }
+    cvector_free(shared_prototypes);
+    globals->shared_prototypes = NULL;
+}
+
+/**
+ * Attach the object with the same flags as other targets, so it can be deleted and
+ * garbage-collected. It's attached to 'globalThis' if the parent is NULL.
+ */
+static void attach_js_object(JSContext *context, JSValue *parent, const char *name,
+                             JSValue object) {
     if (parent == NULL) {
         JSValue global_this = JS_GetGlobalObject(context);
         // Attach object to globalThis
-        JS_DefinePropertyValueStr(context, global_this, c_name, object, 0);
+        JS_DefinePropertyValueStr(context, global_this, name, object, JS_PROP_C_W_E);
         JS_FreeValue(context, global_this);
     } else {
         // Attach object to parent
-        JS_DefinePropertyValueStr(context, *parent, c_name, object, 0);
+        JS_DefinePropertyValueStr(context, *parent, name, object, JS_PROP_C_W_E);
     }
+}
+
+JSValue define_js_object(JNIEnv *env, JSContext *context,
+                         Globals *globals,
+                         jobject host,
+                         JSValue *parent,
+                         int64_t handle,
+                         jstring name,
+                         jobjectArray properties,
+                         jobjectArray functions,
+                         jstring prototype_key) {
+    const char *c_name = (*env)->GetStringUTFChars(env, name, NULL);
+
+    int32_t prototype_index = -1;
+    if (prototype_key != NULL) {
+        prototype_index = shared_prototype_index(env, context, globals, host, prototype_key,
+                                                 properties, functions);
+        if (prototype_index < 0) {
+            (*env)->ReleaseStringUTFChars(env, name, c_name);
+            return JS_EXCEPTION;
+        }
+    }
+
+    JSValue object = new_binding_object(env, context, globals, host, handle, prototype_index,
+                                        "defineObject", c_name);
+    if (JS_IsException(object)) {
+        (*env)->ReleaseStringUTFChars(env, name, c_name);
+        return object;
+    }
+
+    if (prototype_index < 0) {
+        define_js_properties_on(env, context, globals, object, object, -1, c_name, properties);
+        define_js_functions_on(env, context, globals, object, object, -1, c_name, functions);
+    }
+    // Constants hold values of this object, they are never shared
+    if (define_js_constants_on(env, context, object, properties) != 0) {
+        JS_FreeValue(context, object);
+        (*env)->ReleaseStringUTFChars(env, name, c_name);
+        return JS_EXCEPTION;
+    }
+
+    attach_js_object(context, parent, c_name, object);
 
     (*env)->ReleaseStringUTFChars(env, name, c_name);
 
     return object;
 }
 
+/**
+ * Reads an encoded binding tree, see define_js_object_tree() for the layout. Reads past the end
+ * or of malformed strings set 'failed' and return zeros.
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    size_t offset;
+    int failed;
+} TreeReader;
+
+static uint8_t tree_read_u8(TreeReader *reader) {
+    if (reader->failed || reader->offset + 1 > reader->length) {
+        reader->failed = 1;
+        return 0;
+    }
+    return reader->data[reader->offset++];
+}
+
+static uint32_t tree_read_u32(TreeReader *reader) {
+    if (reader->failed || reader->offset + 4 > reader->length) {
+        reader->failed = 1;
+        return 0;
+    }
+    const uint8_t *p = reader->data + reader->offset;
+    reader->offset += 4;
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) |
+           ((uint32_t) p[3] << 24);
+}
+
+/**
+ * Read a string, it points into the buffer and is NUL-terminated.
+ */
+static const char *tree_read_str(TreeReader *reader) {
+    uint32_t len = tree_read_u32(reader);
+    if (reader->failed || len >= reader->length - reader->offset ||
+        reader->data[reader->offset + len] != '\0') {
+        reader->failed = 1;
+        return NULL;
+    }
+    const char *str = (const char *) reader->data + reader->offset;
+    reader->offset += len + 1;
+    return str;
+}
+
+/**
+ * Walk the members of an encoded object, the mode decides which ones are defined, members are
+ * only skipped if the mode is 0. Returns -1 if the buffer is malformed or a constant can't be
+ * converted.
+ */
+static int define_tree_members(JNIEnv *env, JSContext *context, Globals *globals,
+                               TreeReader *reader, jobjectArray values, JSValue target,
+                               JSValue owner, int32_t prototype_index, const char *parent_name,
+                               int mode) {
+    uint32_t prop_count = tree_read_u32(reader);
+    for (uint32_t i = 0; i < prop_count && !reader->failed; i++) {
+        const char *prop_name = tree_read_str(reader);
+        uint8_t flags = tree_read_u8(reader);
+        uint32_t value_index = 0;
+        if (flags & TREE_PROPERTY_CONSTANT) {
+            value_index = tree_read_u32(reader);
+        }
+        if (reader->failed) {
+            break;
+        }
+        jboolean configurable = (flags & TREE_PROPERTY_CONFIGURABLE) ? JNI_TRUE : JNI_FALSE;
+        jboolean writable = (flags & TREE_PROPERTY_WRITABLE) ? JNI_TRUE : JNI_FALSE;
+        jboolean enumerable = (flags & TREE_PROPERTY_ENUMERABLE) ? JNI_TRUE : JNI_FALSE;
+
+        if (flags & TREE_PROPERTY_CONSTANT) {
+            if (!(mode & TREE_DEFINE_CONSTANTS)) {
+                continue;
+            }
+            if (values == NULL || value_index >= (uint32_t) (*env)->GetArrayLength(env, values)) {
+                return -1;
+            }
+            jobject j_value = (*env)->GetObjectArrayElement(env, values, (jsize) value_index);
+            int ret = define_js_constant_on(env, context, target, prop_name, j_value,
+                                            configurable, writable, enumerable);
+            if (j_value != NULL) {
+                (*env)->DeleteLocalRef(env, j_value);
+            }
+            if (ret != 0) {
+                return -1;
+            }
+        } else if (mode & TREE_DEFINE_ACCESSORS) {
+            define_js_accessor_on(context, globals, target, owner, prototype_index, parent_name,
+                                  prop_name, configurable, writable, enumerable);
+        }
+    }
+
+    uint32_t func_count = tree_read_u32(reader);
+    for (uint32_t i = 0; i < func_count && !reader->failed; i++) {
+        const char *func_name = tree_read_str(reader);
+        uint8_t flags = tree_read_u8(reader);
+        if (reader->failed) {
+            break;
+        }
+        if (mode & TREE_DEFINE_FUNCTIONS) {
+            jboolean is_async = (flags & TREE_FUNCTION_ASYNC) ? JNI_TRUE : JNI_FALSE;
+            define_js_member_function_on(context, globals, target, owner, prototype_index,
+                                         parent_name, func_name, is_async);
+        }
+    }
+
+    return reader->failed ? -1 : 0;
+}
+
+/**
+ * Get the member signature of an encoded object, the reader is at the members of the object.
+ * The buffer is checked by define_tree_members() before.
+ */
+static char *tree_member_signature(TreeReader reader) {
+    MemberSignature signature = {.entries = NULL, .failed = 0};
+
+    uint32_t prop_count = tree_read_u32(&reader);
+    for (uint32_t i = 0; i < prop_count && !reader.failed; i++) {
+        const char *prop_name = tree_read_str(&reader);
+        uint8_t flags = tree_read_u8(&reader);
+        if (flags & TREE_PROPERTY_CONSTANT) {
+            tree_read_u32(&reader);
+        } else if (!reader.failed) {
+            member_signature_add(&signature, 'p', flags, prop_name);
+        }
+    }
+
+    uint32_t func_count = tree_read_u32(&reader);
+    for (uint32_t i = 0; i < func_count && !reader.failed; i++) {
+        const char *func_name = tree_read_str(&reader);
+        uint8_t flags = tree_read_u8(&reader);
+        if (!reader.failed) {
+            member_signature_add(&signature, 'f', flags & TREE_FUNCTION_ASYNC, func_name);
+        }
+    }
+
+    if (reader.failed) {
+        signature.failed = 1;
+    }
+    return member_signature_finish(&signature);
+}
+
+/**
+ * Get the index of the shared prototype of an encoded object, the prototype is created with
+ * the members on the first call. The reader is at the members of the object.
+ */
+static int32_t tree_shared_prototype_index(JNIEnv *env, JSContext *context, Globals *globals,
+                                           jobject host, const char *key, TreeReader members) {
+    char *signature = tree_member_signature(members);
+    if (signature == NULL) {
+        jni_throw_qjs_exception(env, "Failed to read members of the prototype '%s'.", key);
+        return -1;
+    }
+    int32_t found = find_shared_prototype(globals, key);
+    if (found >= 0) {
+        return check_shared_prototype(env, globals, found, key, signature);
+    }
+
+    // A hidden binding object which owns the host ref of the prototype members
+    JSValue holder = new_binding_object(env, context, globals, host, GLOBAL_THIS_HANDLE, -1,
+                                        "sharedPrototype", key);
+    if (JS_IsException(holder)) {
+        free(signature);
+        return -1;
+    }
+
+    int32_t prototype_index = (int32_t) cvector_size(globals->shared_prototypes);
+    JSValue proto = JS_NewObject(context);
+    define_tree_members(env, context, globals, &members, NULL, proto, holder, prototype_index,
+                        key, TREE_DEFINE_ACCESSORS | TREE_DEFINE_FUNCTIONS);
+    JS_FreeValue(context, holder);
+
+    add_shared_prototype(globals, key, signature, proto);
+    return prototype_index;
+}
+
+/**
+ * An object of a binding tree which is built but not attached yet.
+ */
+typedef struct {
+    JSValue object;
+    int64_t handle;
+    int32_t parent_index;
+    const char *name;
+} TreeObject;
+
+/**
+ * Build the objects of a tree without attaching them, 'built' is the count of objects that
+ * are built. Returns -1 if the tree is malformed or failed to define.
+ */
+static int build_tree_objects(JNIEnv *env, JSContext *context, Globals *globals, jobject host,
+                              TreeReader *reader, jobjectArray values, TreeObject *objects,
+                              uint32_t count, uint32_t *built) {
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t parent_index = (int32_t) tree_read_u32(reader);
+        const char *name = tree_read_str(reader);
+        const char *prototype_key = tree_read_u8(reader) ? tree_read_str(reader) : NULL;
+        // Objects come after their parents
+        if (reader->failed || parent_index >= (int32_t) i) {
+            return -1;
+        }
+        TreeReader members = *reader;
+        if (define_tree_members(env, context, globals, reader, NULL, JS_UNDEFINED,
+                                JS_UNDEFINED, -1, name, 0) != 0) {
+            return -1;
+        }
+
+        int32_t prototype_index = -1;
+        if (prototype_key != NULL) {
+            prototype_index = tree_shared_prototype_index(env, context, globals, host,
+                                                          prototype_key, members);
+            if (prototype_index < 0) {
+                return -1;
+            }
+        }
+
+        int64_t handle = acquire_object_handle(globals);
+        JSValue object = new_binding_object(env, context, globals, host, handle, prototype_index,
+                                            "defineObject", name);
+        if (JS_IsException(object)) {
+            release_object_handle(globals, handle);
+            return -1;
+        }
+
+        int mode = TREE_DEFINE_CONSTANTS;
+        if (prototype_index < 0) {
+            mode |= TREE_DEFINE_ACCESSORS | TREE_DEFINE_FUNCTIONS;
+        }
+        TreeReader object_members = members;
+        if (define_tree_members(env, context, globals, &object_members, values, object, object,
+                                -1, name, mode) != 0) {
+            // The finalizer releases the handle
+            JS_FreeValue(context, object);
+            return -1;
+        }
+
+        objects[i] = (TreeObject) {
+                .object = object,
+                .handle = handle,
+                .parent_index = parent_index,
+                .name = name,
+        };
+        *built = i + 1;
+    }
+    return 0;
+}
+
+int32_t define_js_object_tree(JNIEnv *env, JSContext *context,
+                              Globals *globals,
+                              jobject host,
+                              int64_t parent_handle,
+                              const uint8_t *tree,
+                              size_t tree_len,
+                              jobjectArray values,
+                              int64_t *handles,
+                              int32_t max_count) {
+    TreeReader reader = {.data = tree, .length = tree_len, .offset = 0, .failed = 0};
+    uint32_t count = tree_read_u32(&reader);
+    if (reader.failed || count > (uint32_t) max_count) {
+        return -1;
+    }
+
+    // Build every object first, they are attached only if the whole tree succeeds
+    TreeObject *objects = malloc(sizeof(TreeObject) * (count > 0 ? count : 1));
+    if (objects == NULL) {
+        JS_ThrowOutOfMemory(context);
+        return -1;
+    }
+    uint32_t built = 0;
+    int ret = build_tree_objects(env, context, globals, host, &reader, values, objects, count,
+                                 &built);
+    // Allocations of the objects may have collected the parent
+    if (ret == 0 && parent_handle >= 0 &&
+        defined_object_of_handle(globals, parent_handle) == NULL) {
+        jni_throw_qjs_exception(env, "Parent object has been garbage-collected.");
+        ret = -1;
+    }
+    if (ret != 0) {
+        // Nothing is attached, freeing the objects runs their finalizers which release the
+        // handles and the host refs
+        for (uint32_t i = 0; i < built; i++) {
+            JS_FreeValue(context, objects[i].object);
+        }
+        free(objects);
+        return -1;
+    }
+
+    // Nothing below acquires handles, so the defined objects don't move
+    for (uint32_t i = 0; i < count; i++) {
+        TreeObject *node = &objects[i];
+        JSValue *parent = node->parent_index < 0
+                          ? defined_object_of_handle(globals, parent_handle)
+                          : &objects[node->parent_index].object;
+        attach_js_object(context, parent, node->name, node->object);
+        set_defined_object(globals, node->handle, node->object);
+        handles[i] = node->handle;
+    }
+    free(objects);
+    return (int32_t) count;
+}
+
 void define_js_function(JNIEnv *env, JSContext *context,
                         Globals *globals,
                         jobject host,
                         jstring name,
                         jboolean is_async) {
-    jobject global_host = (*env)->NewGlobalRef(env, host);
-    cvector_push_back(globals->global_object_refs, global_host);
-
     const char *func_name = (*env)->GetStringUTFChars(env, name, NULL);
 
+    // A hidden binding object which owns the host ref of the function
+    JSValue holder = new_binding_object(env, context, globals, host, GLOBAL_THIS_HANDLE, -1,
+                                        "defineFunction", func_name);
+    if (JS_IsException(holder)) {
+        (*env)->ReleaseStringUTFChars(env, name, func_name);
+        return;
+    }
+
     // Function data
-    uint32_t data_len = COMMON_FUNC_DATA_LEN + 1;
-    JSValue func_data[3] = {
-            JS_NewInt64(context, (int64_t) global_host), // host address
-            JS_NewInt64(context, GLOBAL_THIS_HANDLE), // parent object handle
+    BindingCallType call_type = is_async ? BINDING_CALL_ASYNC_FUNCTION : BINDING_CALL_FUNCTION;
+    JSValue func_data[FUNC_DATA_LEN] = {
+            holder, // binding object
             JS_NewString(context, func_name), // function name
+            // stats slot
+            JS_NewInt32(context, register_stats_slot(globals, NULL, func_name, call_type)),
+    };
+
+    JSValue global_this = JS_GetGlobalObject(context);
+    define_js_function_on(context, global_this, func_name, is_async, 0, FUNC_DATA_LEN,
+                          func_data);
+    JS_FreeValue(context, global_this);
+
+    JS_FreeValue(context, func_data[0]);
+    JS_FreeValue(context, func_data[1]);
+
+    (*env)->ReleaseStringUTFChars(env, name, func_name);
+}
+
+static JSValue illegal_constructor(JSContext *context, JSValueConst new_target,
+                                   int argc, JSValueConst *argv) {
+    return JS_ThrowTypeError(context, "Illegal constructor");
+}
+
+/**
+ * Define an accessor on the class prototype, the function data is [binding object, property
+ * name, stats slot, class index].
+ */
+static void define_class_accessor(JNIEnv *env, JSContext *context, Globals *globals,
+                                  JSValue holder, JSValue proto, int32_t class_index,
+                                  const char *class_name, jobject property) {
+    jstring j_prop_name = (*env)->GetObjectField(env, property, field_js_property_name(env));
+    const char *prop_name = (*env)->GetStringUTFChars(env, j_prop_name, NULL);
+    jboolean configurable = (*env)->GetBooleanField(env, property,
+                                                    field_js_property_configurable(env));
+    jboolean writable = (*env)->GetBooleanField(env, property, field_js_property_writable(env));
+    jboolean enumerable = (*env)->GetBooleanField(env, property,
+                                                  field_js_property_enumerable(env));
+
+    JSValue func_data[CLASS_FUNC_DATA_LEN] = {
+            holder,
+            JS_NewString(context, prop_name),
+            JS_NewInt32(context, register_stats_slot(globals, class_name, prop_name,
+                                                     BINDING_CALL_GETTER)),
+            JS_NewInt32(context, class_index),
     };
 
-    for (uint32_t i = 0; i < data_len; i++) {
-        cvector_push_back(globals->managed_js_values, func_data[i]);
+    JSValue getter = JS_NewCFunctionData(context, class_property_getter, 0, 0,
+                                         CLASS_FUNC_DATA_LEN, func_data);
+    JSValue setter = JS_UNDEFINED;
+    if (writable == JNI_TRUE) {
+        func_data[2] = JS_NewInt32(context, register_stats_slot(globals, class_name, prop_name,
+                                                                BINDING_CALL_SETTER));
+        setter = JS_NewCFunctionData(context, class_property_setter, 0, 0,
+                                     CLASS_FUNC_DATA_LEN, func_data);
     }
 
-    JSValue global_this = JS_GetGlobalObject(context);
-    if (is_async) {
-        define_async_js_function_on(context, globals, global_this, func_name,
-                                    data_len, func_data);
-    } else {
-        define_js_function_on(context, global_this, func_name, data_len, func_data);
+    int flags = JS_PROP_CONFIGURABLE | JS_PROP_ENUMERABLE;
+    if (configurable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_CONFIGURABLE;
+    }
+    if (enumerable == JNI_FALSE) {
+        flags = flags & ~JS_PROP_ENUMERABLE;
     }
+
+    JSAtom prop = JS_NewAtom(context, prop_name);
+    JS_DefinePropertyGetSet(context, proto, prop, getter, setter, flags);
+    JS_FreeAtom(context, prop);
+    JS_FreeValue(context, func_data[1]);
+
+    (*env)->ReleaseStringUTFChars(env, j_prop_name, prop_name);
+    (*env)->DeleteLocalRef(env, j_prop_name);
+}
+
+/**
+ * Define a function on the class prototype, the function data is [binding object, function
+ * name, stats slot, class index].
+ */
+static void define_class_function(JNIEnv *env, JSContext *context, Globals *globals,
+                                  JSValue holder, JSValue proto, int32_t class_index,
+                                  const char *class_name, jobject function) {
+    jstring j_fun_name = (*env)->GetObjectField(env, function, field_js_function_name(env));
+    const char *func_name = (*env)->GetStringUTFChars(env, j_fun_name, NULL);
+
+    JSValue func_data[CLASS_FUNC_DATA_LEN] = {
+            holder,
+            JS_NewString(context, func_name),
+            JS_NewInt32(context, register_stats_slot(globals, class_name, func_name,
+                                                     BINDING_CALL_FUNCTION)),
+            JS_NewInt32(context, class_index),
+    };
+
+    JSValue invoke = JS_NewCFunctionData(context, class_function_invoke, 0, 0,
+                                         CLASS_FUNC_DATA_LEN, func_data);
+    JSAtom prop = JS_NewAtom(context, func_name);
+    JS_DefinePropertyValue(context, proto, prop, invoke,
+                           JS_PROP_CONFIGURABLE | JS_PROP_WRITABLE);
+    JS_FreeAtom(context, prop);
+    JS_FreeValue(context, func_data[1]);
+
+    (*env)->ReleaseStringUTFChars(env, j_fun_name, func_name);
+    (*env)->DeleteLocalRef(env, j_fun_name);
+}
+
+int32_t define_host_class(JNIEnv *env, JSContext *context,
+                          Globals *globals,
+                          jobject host,
+                          jclass cls,
+                          jstring name,
+                          jobjectArray properties,
+                          jobjectArray functions) {
+    const char *c_name = (*env)->GetStringUTFChars(env, name, NULL);
+
+    // A hidden binding object which owns the host ref of the class members
+    JSValue holder = new_binding_object(env, context, globals, host, GLOBAL_THIS_HANDLE, -1,
+                                        "defineClass", c_name);
+    if (JS_IsException(holder)) {
+        (*env)->ReleaseStringUTFChars(env, name, c_name);
+        return -1;
+    }
+
+    int32_t class_index = (int32_t) cvector_size(globals->host_classes);
+    JSValue proto = JS_NewObject(context);
+
+    jsize prop_size = (*env)->GetArrayLength(env, properties);
+    for (jsize i = 0; i < prop_size; i++) {
+        jobject property = (*env)->GetObjectArrayElement(env, properties, i);
+        define_class_accessor(env, context, globals, holder, proto, class_index, c_name,
+                              property);
+        (*env)->DeleteLocalRef(env, property);
+    }
+
+    jsize func_size = (*env)->GetArrayLength(env, functions);
+    for (jsize i = 0; i < func_size; i++) {
+        jobject function = (*env)->GetObjectArrayElement(env, functions, i);
+        define_class_function(env, context, globals, holder, proto, class_index, c_name,
+                              function);
+        (*env)->DeleteLocalRef(env, function);
+    }
+
+    // The constructor can't be called, it's for 'instanceof' checks and the prototype
+    JSValue constructor = JS_NewCFunction2(context, illegal_constructor, c_name, 0,
+                                           JS_CFUNC_constructor, 0);
+    JS_SetConstructor(context, constructor, proto);
+    JSValue global_this = JS_GetGlobalObject(context);
+    JS_DefinePropertyValueStr(context, global_this, c_name, constructor,
+                              JS_PROP_CONFIGURABLE | JS_PROP_WRITABLE);
     JS_FreeValue(context, global_this);
 
-    (*env)->ReleaseStringUTFChars(env, name, func_name);
+    HostClass host_class = {
+            .cls = (*env)->NewGlobalRef(env, cls),
+            .proto = proto,
+    };
+    cvector_push_back(globals->host_classes, host_class);
+    // Cached classes may be subclasses of the new class
+    clear_host_class_cache(env, globals);
+    // Let the value mapping find the host classes
+    JS_SetContextOpaque(context, globals);
+
+    JS_FreeValue(context, holder);
+    (*env)->ReleaseStringUTFChars(env, name, c_name);
+
+    return class_index;
 }
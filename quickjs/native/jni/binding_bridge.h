@@ -6,9 +6,86 @@
 #include "cvector.h"
 #include "quickjs_jni.h"
 
+/**
+ * Register the class of binding objects to the runtime. Binding objects hold the JNI host refs,
+ * which are released when the objects are garbage-collected.
+ */
+void register_binding_class(JSRuntime *runtime, JSContext *context);
+
+/**
+ * Release the JNI refs of all binding objects which are still alive. Finalizers that run after
+ * this will only free the binding hosts.
+ */
+void release_binding_hosts(JNIEnv *env, Globals *globals);
+
+/**
+ * Release the JNI refs of host instances which are still alive and free the defined classes.
+ * Finalizers that run after this will only free the instances.
+ */
+void release_host_classes(JNIEnv *env, JSContext *context, Globals *globals);
+
+/**
+ * Free the prototypes shared by object bindings.
+ */
+void release_shared_prototypes(JSContext *context, Globals *globals);
+
+/**
+ * Reserve a slot in 'Globals.defined_js_objects' and return its handle. A handle encodes the
+ * slot index and generation, so it won't match the object of a reused slot.
+ */
+int64_t acquire_object_handle(Globals *globals);
+
+/**
+ * Get the defined object of the handle, NULL is returned if the handle is invalid or the object
+ * has been garbage-collected.
+ */
+JSValue *defined_object_of_handle(Globals *globals, int64_t handle);
+
+/**
+ * Set the object of a reserved handle.
+ */
+void set_defined_object(Globals *globals, int64_t handle, JSValue object);
+
+/**
+ * Release the slot of the handle, it does nothing if the slot has been released.
+ */
+void release_object_handle(Globals *globals, int64_t handle);
+
+/**
+ * Notify the host of bindings which were finalized on a thread without a JNI env, and release
+ * their refs.
+ */
+void release_stale_bindings(JNIEnv *env, Globals *globals);
+
+/**
+ * Create a host instance if the object's class is defined by defineClass(), otherwise,
+ * JS_UNDEFINED is returned.
+ */
+JSValue new_host_instance(JNIEnv *env, JSContext *context, jobject value);
+
+/**
+ * Get a local ref of the host object if the value is a host instance, otherwise, NULL is
+ * returned.
+ */
+jobject host_instance_to_jobject(JNIEnv *env, JSValue value);
+
+/**
+ * Define a JavaScript class for the host class, and attach its constructor to 'globalThis'.
+ * Returns the class index, or -1 if failed.
+ */
+int32_t define_host_class(JNIEnv *env, JSContext *context,
+                          Globals *globals,
+                          jobject host,
+                          jclass cls,
+                          jstring name,
+                          jobjectArray properties,
+                          jobjectArray functions);
+
 /**
  * Define a JavaScript object. It will be attached to the parent if the parent is not null,
- * otherwise, it will be attached to 'globalThis'.
+ * otherwise, it will be attached to 'globalThis'. If the prototype key is not null, members
+ * are defined once on the prototype shared by objects with the same key. Constant properties
+ * are always defined on the object as data properties.
  */
 JSValue define_js_object(JNIEnv *env, JSContext *context,
                          Globals *globals,
@@ -17,7 +94,32 @@ JSValue define_js_object(JNIEnv *env, JSContext *context,
                          int64_t handle,
                          jstring name,
                          jobjectArray properties,
-                         jobjectArray function_names);
+                         jobjectArray function_names,
+                         jstring prototype_key);
+
+/**
+ * Define the objects of an encoded binding tree in one call, the handle of each object is
+ * written to the handles. Objects whose parent index is -1 are attached to the parent handle,
+ * or to 'globalThis' if it's -1. Returns the object count, or -1 if the tree is malformed or
+ * failed to define, with the JS or Java exception pending if any. Objects are attached only
+ * after the whole tree is built, nothing is defined on a failure.
+ *
+ * The tree is little-endian, strings are a u32 byte length and the UTF-8 bytes with a NUL:
+ *
+ *   u32 object count
+ *   objects: i32 parent index, str name, u8 has prototype key, [str prototype key],
+ *            u32 property count, properties: str name, u8 flags, [u32 constant value index],
+ *            u32 function count, functions: str name, u8 flags
+ */
+int32_t define_js_object_tree(JNIEnv *env, JSContext *context,
+                              Globals *globals,
+                              jobject host,
+                              int64_t parent_handle,
+                              const uint8_t *tree,
+                              size_t tree_len,
+                              jobjectArray values,
+                              int64_t *handles,
+                              int32_t max_count);
 
 
 /**
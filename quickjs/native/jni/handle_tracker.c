@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "handle_tracker.h"
+#include "jni_globals_generated.h"
+
+static const char *handle_kind_names[HANDLE_KIND_COUNT] = {
+        "ManagedJsValue",
+        "PromiseFunction",
+        "GlobalRef",
+        "BindingObject",
+};
+
+void track_handle(Globals *globals, HandleKind kind, const char *call_type,
+                  const char *binding, const void *ref) {
+    if (!globals->track_handles) {
+        return;
+    }
+    const char *name = binding != NULL ? binding : "";
+    TrackedHandle handle = {
+            .kind = kind,
+            .call_type = call_type,
+            .binding = malloc(strlen(name) + 1),
+            .ref = ref,
+    };
+    strcpy(handle.binding, name);
+    cvector_push_back(globals->tracked_handles, handle);
+}
+
+void untrack_handle(Globals *globals, const void *ref) {
+    if (globals->tracked_handles == NULL || ref == NULL) {
+        return;
+    }
+    size_t size = cvector_size(globals->tracked_handles);
+    for (size_t i = 0; i < size; i++) {
+        if (globals->tracked_handles[i].ref == ref) {
+            free(globals->tracked_handles[i].binding);
+            cvector_erase(globals->tracked_handles, i);
+            return;
+        }
+    }
+}
+
+void free_tracked_handles(Globals *globals) {
+    if (globals->tracked_handles == NULL) {
+        return;
+    }
+    size_t size = cvector_size(globals->tracked_handles);
+    for (size_t i = 0; i < size; i++) {
+        free(globals->tracked_handles[i].binding);
+    }
+    cvector_free(globals->tracked_handles);
+    globals->tracked_handles = NULL;
+}
+
+jlongArray handle_counts_to_java(JNIEnv *env, Globals *globals) {
+    // Skip hidden holders of global functions, classes and shared prototypes, the native bridge
+    // has no such objects
+    jlong binding_objects = 0;
+    size_t host_count = cvector_size(globals->binding_hosts);
+    for (size_t i = 0; i < host_count; i++) {
+        if (globals->binding_hosts[i]->handle >= 0) {
+            binding_objects++;
+        }
+    }
+    jlong counts[HANDLE_KIND_COUNT] = {
+            (jlong) cvector_size(globals->managed_js_values),
+            (jlong) cvector_size(globals->created_js_functions),
+            (jlong) cvector_size(globals->global_object_refs),
+            binding_objects,
+    };
+    jlongArray array = (*env)->NewLongArray(env, HANDLE_KIND_COUNT);
+    (*env)->SetLongArrayRegion(env, array, 0, HANDLE_KIND_COUNT, counts);
+    return array;
+}
+
+jobjectArray tracked_handles_to_java(JNIEnv *env, Globals *globals) {
+    size_t size = cvector_size(globals->tracked_handles);
+    jobjectArray array = (*env)->NewObjectArray(env, (jsize) size, cls_string(env), NULL);
+    for (size_t i = 0; i < size; i++) {
+        TrackedHandle handle = globals->tracked_handles[i];
+        const char *kind = handle_kind_names[handle.kind];
+        size_t len = strlen(kind) + strlen(handle.call_type) + strlen(handle.binding) + 3;
+        char *item = malloc(len);
+        snprintf(item, len, "%s|%s|%s", kind, handle.call_type, handle.binding);
+        jstring j_item = (*env)->NewStringUTF(env, item);
+        (*env)->SetObjectArrayElement(env, array, (jsize) i, j_item);
+        (*env)->DeleteLocalRef(env, j_item);
+        free(item);
+    }
+    return array;
+}
@@ -0,0 +1,63 @@
+#ifndef QJS_KT_HANDLE_TRACKER_H
+#define QJS_KT_HANDLE_TRACKER_H
+
+#include "jni.h"
+#include "quickjs_jni.h"
+
+/**
+ * Kinds of the handles held by the bridge, names must match the kotlin HandleKind enum.
+ */
+typedef enum {
+    HANDLE_KIND_MANAGED_JS_VALUE = 0,
+    HANDLE_KIND_PROMISE_FUNCTION = 1,
+    HANDLE_KIND_GLOBAL_REF = 2,
+    HANDLE_KIND_BINDING_OBJECT = 3,
+    HANDLE_KIND_COUNT = 4,
+} HandleKind;
+
+/**
+ * The creation site of a handle.
+ */
+typedef struct TrackedHandle {
+    HandleKind kind;
+    /**
+     * Static string, e.g. 'defineObject', 'asyncCall'.
+     */
+    const char *call_type;
+    /**
+     * Copied binding name.
+     */
+    char *binding;
+    /**
+     * The tracked pointer, used to untrack the handle, or NULL if the handle lives until closing.
+     */
+    const void *ref;
+} TrackedHandle;
+
+/**
+ * Record the creation site of a handle if handle tracking is enabled.
+ */
+void track_handle(Globals *globals, HandleKind kind, const char *call_type,
+                  const char *binding, const void *ref);
+
+/**
+ * Remove the record of the handle which has the ref, if any.
+ */
+void untrack_handle(Globals *globals, const void *ref);
+
+/**
+ * Free all tracked records.
+ */
+void free_tracked_handles(Globals *globals);
+
+/**
+ * Count the live handles by kinds, including untracked handles.
+ */
+jlongArray handle_counts_to_java(JNIEnv *env, Globals *globals);
+
+/**
+ * Convert the tracked handles to a Java string array, items are 'kind|call_type|binding'.
+ */
+jobjectArray tracked_handles_to_java(JNIEnv *env, Globals *globals);
+
+#endif //QJS_KT_HANDLE_TRACKER_H
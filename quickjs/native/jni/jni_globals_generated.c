@@ -75,6 +75,11 @@ static jmethodID _method_quick_js_on_call_setter = NULL;
 static jmethodID _method_quick_js_on_call_function = NULL;
 static jmethodID _method_quick_js_set_eval_exception = NULL;
 static jmethodID _method_quick_js_set_unhandled_promise_rejection = NULL;
+static jmethodID _method_quick_js_on_call_class_getter = NULL;
+static jmethodID _method_quick_js_on_call_class_setter = NULL;
+static jmethodID _method_quick_js_on_call_class_function = NULL;
+static jmethodID _method_quick_js_on_binding_finalized = NULL;
+static jmethodID _method_quick_js_on_threshold_gc = NULL;
 static jmethodID _method_memory_usage_init = NULL;
 static jmethodID _method_js_object_init = NULL;
 
@@ -85,6 +90,8 @@ static jfieldID _field_js_property_name = NULL;
 static jfieldID _field_js_property_configurable = NULL;
 static jfieldID _field_js_property_writable = NULL;
 static jfieldID _field_js_property_enumerable = NULL;
+static jfieldID _field_js_property_is_constant = NULL;
+static jfieldID _field_js_property_value = NULL;
 static jfieldID _field_js_function_name = NULL;
 static jfieldID _field_js_function_is_async = NULL;
 
@@ -613,6 +620,41 @@ jmethodID method_quick_js_set_unhandled_promise_rejection(JNIEnv *env) {
     return _method_quick_js_set_unhandled_promise_rejection;
 }
 
+jmethodID method_quick_js_on_call_class_getter(JNIEnv *env) {
+    if (_method_quick_js_on_call_class_getter == NULL) {
+        _method_quick_js_on_call_class_getter = (*env)->GetMethodID(env, cls_quick_js(env), "onCallClassGetter", "(ILjava/lang/Object;Ljava/lang/String;)Ljava/lang/Object;");
+    }
+    return _method_quick_js_on_call_class_getter;
+}
+
+jmethodID method_quick_js_on_call_class_setter(JNIEnv *env) {
+    if (_method_quick_js_on_call_class_setter == NULL) {
+        _method_quick_js_on_call_class_setter = (*env)->GetMethodID(env, cls_quick_js(env), "onCallClassSetter", "(ILjava/lang/Object;Ljava/lang/String;Ljava/lang/Object;)V");
+    }
+    return _method_quick_js_on_call_class_setter;
+}
+
+jmethodID method_quick_js_on_call_class_function(JNIEnv *env) {
+    if (_method_quick_js_on_call_class_function == NULL) {
+        _method_quick_js_on_call_class_function = (*env)->GetMethodID(env, cls_quick_js(env), "onCallClassFunction", "(ILjava/lang/Object;Ljava/lang/String;[Ljava/lang/Object;)Ljava/lang/Object;");
+    }
+    return _method_quick_js_on_call_class_function;
+}
+
+jmethodID method_quick_js_on_binding_finalized(JNIEnv *env) {
+    if (_method_quick_js_on_binding_finalized == NULL) {
+        _method_quick_js_on_binding_finalized = (*env)->GetMethodID(env, cls_quick_js(env), "onBindingFinalized", "(J)V");
+    }
+    return _method_quick_js_on_binding_finalized;
+}
+
+jmethodID method_quick_js_on_threshold_gc(JNIEnv *env) {
+    if (_method_quick_js_on_threshold_gc == NULL) {
+        _method_quick_js_on_threshold_gc = (*env)->GetMethodID(env, cls_quick_js(env), "onThresholdGc", "(Z)V");
+    }
+    return _method_quick_js_on_threshold_gc;
+}
+
 jmethodID method_memory_usage_init(JNIEnv *env) {
     if (_method_memory_usage_init == NULL) {
         _method_memory_usage_init = (*env)->GetMethodID(env, cls_memory_usage(env), "<init>", "(JJJJJJJJJJJJJJJJJJJJJJJJJJ)V");
@@ -669,6 +711,20 @@ jfieldID field_js_property_enumerable(JNIEnv *env) {
     return _field_js_property_enumerable;
 }
 
+jfieldID field_js_property_is_constant(JNIEnv *env) {
+    if (_field_js_property_is_constant == NULL) {
+        _field_js_property_is_constant = (*env)->GetFieldID(env, cls_js_property(env), "isConstant", "Z");
+    }
+    return _field_js_property_is_constant;
+}
+
+jfieldID field_js_property_value(JNIEnv *env) {
+    if (_field_js_property_value == NULL) {
+        _field_js_property_value = (*env)->GetFieldID(env, cls_js_property(env), "value", "Ljava/lang/Object;");
+    }
+    return _field_js_property_value;
+}
+
 jfieldID field_js_function_name(JNIEnv *env) {
     if (_field_js_function_name == NULL) {
         _field_js_function_name = (*env)->GetFieldID(env, cls_js_function(env), "name", "Ljava/lang/String;");
@@ -841,6 +897,11 @@ void clear_jni_refs_cache(JNIEnv *env) {
     _method_quick_js_on_call_function = NULL;
     _method_quick_js_set_eval_exception = NULL;
     _method_quick_js_set_unhandled_promise_rejection = NULL;
+    _method_quick_js_on_call_class_getter = NULL;
+    _method_quick_js_on_call_class_setter = NULL;
+    _method_quick_js_on_call_class_function = NULL;
+    _method_quick_js_on_binding_finalized = NULL;
+    _method_quick_js_on_threshold_gc = NULL;
     _method_memory_usage_init = NULL;
     _method_js_object_init = NULL;
 
@@ -850,6 +911,8 @@ void clear_jni_refs_cache(JNIEnv *env) {
     _field_js_property_configurable = NULL;
     _field_js_property_writable = NULL;
     _field_js_property_enumerable = NULL;
+    _field_js_property_is_constant = NULL;
+    _field_js_property_value = NULL;
     _field_js_function_name = NULL;
     _field_js_function_is_async = NULL;
 }
@@ -146,6 +146,16 @@ jmethodID method_quick_js_set_eval_exception(JNIEnv *env);
 
 jmethodID method_quick_js_set_unhandled_promise_rejection(JNIEnv *env);
 
+jmethodID method_quick_js_on_call_class_getter(JNIEnv *env);
+
+jmethodID method_quick_js_on_call_class_setter(JNIEnv *env);
+
+jmethodID method_quick_js_on_call_class_function(JNIEnv *env);
+
+jmethodID method_quick_js_on_binding_finalized(JNIEnv *env);
+
+jmethodID method_quick_js_on_threshold_gc(JNIEnv *env);
+
 jmethodID method_memory_usage_init(JNIEnv *env);
 
 jmethodID method_js_object_init(JNIEnv *env);
@@ -162,6 +172,10 @@ jfieldID field_js_property_writable(JNIEnv *env);
 
 jfieldID field_js_property_enumerable(JNIEnv *env);
 
+jfieldID field_js_property_is_constant(JNIEnv *env);
+
+jfieldID field_js_property_value(JNIEnv *env);
+
 jfieldID field_js_function_name(JNIEnv *env);
 
 jfieldID field_js_function_is_async(JNIEnv *env);
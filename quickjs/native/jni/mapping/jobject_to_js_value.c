@@ -5,6 +5,7 @@
 #include "exception_util.h"
 #include "log_util.h"
 #include "jni_globals_generated.h"
+#include "binding_bridge.h"
 
 void throw_circular_ref_error(JSContext *context) {
     const char *msg = "Unable to map objects with circular reference.";
@@ -519,6 +520,12 @@ JSValue jobject_to_js_value(JNIEnv *env, JSContext *context, jobject visited_set
         return result;
     }
 
+    // Objects of classes defined by defineClass()
+    result = new_host_instance(env, context, value);
+    if (!JS_IsUndefined(result)) {
+        return result;
+    }
+
     jclass cls = (*env)->GetObjectClass(env, value);
     jstring j_cls_name = (jstring) (*env)->CallObjectMethod(env, cls, method_class_get_name(env));
     const char *cls_name = (*env)->GetStringUTFChars(env, j_cls_name, NULL);
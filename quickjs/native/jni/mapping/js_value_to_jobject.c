@@ -6,6 +6,7 @@
 #include "exception_util.h"
 #include "log_util.h"
 #include "jni_types_util.h"
+#include "binding_bridge.h"
 
 jobject to_java_string(JNIEnv *env, const char *str) {
     return str != NULL ? (*env)->NewStringUTF(env, str) : NULL;
@@ -392,6 +393,12 @@ jobject js_value_to_jobject(JNIEnv *env, JSContext *context, JSValue value) {
 
         return java_buffer;
     } else if (JS_IsObject(value)) {
+        // Host instances are passed back as the host objects
+        jobject host_object = host_instance_to_jobject(env, value);
+        if (host_object != NULL) {
+            return host_object;
+        }
+
         JSValue global_this = JS_GetGlobalObject(context);
         jobject result;
 
@@ -12,6 +12,11 @@
 #include "js_value_util.h"
 #include "quickjs_version.h"
 #include "promise_rejection_handler.h"
+#include "handle_tracker.h"
+#include "memory_accounting.h"
+#include "timed_eval.h"
+#include "opcode_stats.h"
+#include "atom_hook.h"
 
 JSRuntime *runtime_from_ptr(JNIEnv *env, jlong ptr) {
     if (ptr == 0) {
@@ -29,6 +34,18 @@ JSContext *context_from_ptr(JNIEnv *env, jlong ptr) {
     return (JSContext *) ptr;
 }
 
+/**
+ * Report threshold GCs to the host, so they can be traced.
+ */
+static void threshold_gc_listener(void *opaque, int is_end) {
+    JNIEnv *env = get_jni_env();
+    if (env == NULL) {
+        return;
+    }
+    (*env)->CallVoidMethod(env, (jobject) opaque, method_quick_js_on_threshold_gc(env),
+                           is_end ? JNI_TRUE : JNI_FALSE);
+}
+
 Globals *globals_from_ptr(JNIEnv *env, jlong ptr) {
     if (ptr == 0) {
         jni_throw_qjs_exception(env, "Globals is destroyed.");
@@ -48,34 +65,119 @@ JNIEXPORT jlong JNICALL Java_com_dokar_quickjs_QuickJs_initGlobals(JNIEnv *env,
 #pragma ide diagnostic ignored "MemoryLeak"
     Globals *globals = malloc(sizeof(Globals));
 #pragma clang diagnostic pop
+    JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
+    if (runtime == NULL) {
+        free(globals);
+        return 0;
+    }
+    BindingStats *binding_stats = binding_stats_new();
+    SamplingProfiler *profiler = profiler_new();
+    GcStats *gc_stats = gc_stats_new(runtime);
+    if (globals == NULL || binding_stats == NULL || profiler == NULL || gc_stats == NULL) {
+        free(globals);
+        binding_stats_free(binding_stats);
+        profiler_free(profiler);
+        gc_stats_free(gc_stats);
+        jni_throw_qjs_exception(env, "Failed to create globals.");
+        return 0;
+    }
 
     globals->managed_js_values = NULL;
     globals->defined_js_objects = NULL;
+    globals->free_object_slots = NULL;
+    globals->stale_bindings = NULL;
+    globals->stale_host_refs = NULL;
     globals->global_object_refs = NULL;
     globals->created_js_functions = NULL;
+    globals->binding_hosts = NULL;
+    globals->host_classes = NULL;
+    globals->host_class_cache = NULL;
+    globals->template_atoms = NULL;
+    globals->host_instances = NULL;
+    globals->shared_prototypes = NULL;
+    globals->tracked_handles = NULL;
+    globals->track_handles = 0;
+    globals->binding_stats = binding_stats;
+    globals->profiler = profiler;
+    globals->time_evals = 0;
+    globals->eval_compile_ns = 0;
     globals->evaluate_result_promise = NULL;
 
     pthread_mutex_init(&globals->js_mutex, NULL);
 
     cache_java_vm(env);
 
-    JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
     jobject global_host_ref = (*env)->NewGlobalRef(env, this);
     cvector_push_back(globals->global_object_refs, global_host_ref);
     // Handle unhandled promise rejections
     JS_SetHostPromiseRejectionTracker(runtime, promise_rejection_handler,
                                       global_host_ref);
 
+    globals->gc_stats = gc_stats;
+    gc_stats_set_listener(globals->gc_stats, threshold_gc_listener, global_host_ref);
+    globals->runtime_hooks.profiler = globals->profiler;
+    runtime_hooks_install(runtime, &globals->runtime_hooks);
+
     return (jlong) globals;
 }
 
+/**
+ * Intern names from the atom template, the atom hash is sized for all names first so it doesn't
+ * grow while interning. The atoms are kept until releasing globals.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_internAtoms(JNIEnv *env, jobject this,
+                                           jlong context_ptr,
+                                           jlong globals_ptr,
+                                           jobjectArray names) {
+    JSContext *context = context_from_ptr(env, context_ptr);
+    if (context == NULL) {
+        return;
+    }
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return;
+    }
+    jsize size = (*env)->GetArrayLength(env, names);
+    if (JS_ReserveAtoms(JS_GetRuntime(context), size) != 0) {
+        jni_throw_qjs_exception(env, "Failed to reserve atoms.");
+        return;
+    }
+    for (jsize i = 0; i < size; i++) {
+        jstring j_name = (*env)->GetObjectArrayElement(env, names, i);
+        const char *name = (*env)->GetStringUTFChars(env, j_name, NULL);
+        JSAtom atom = JS_NewAtom(context, name);
+        (*env)->ReleaseStringUTFChars(env, j_name, name);
+        (*env)->DeleteLocalRef(env, j_name);
+        if (atom == JS_ATOM_NULL) {
+            jni_throw_qjs_exception(env, "Failed to intern atoms.");
+            return;
+        }
+        cvector_push_back(globals->template_atoms, atom);
+    }
+}
+
 /**
  * Create a new QuickJS JavaScript runtime.
  *
+ * @param accounted Whether to record allocations to a memory accounting, it's the runtime opaque.
  * @return Runtime pointer.
  */
-JNIEXPORT jlong JNICALL Java_com_dokar_quickjs_QuickJs_newRuntime(JNIEnv *env, jobject this) {
-    JSRuntime *runtime = JS_NewRuntime();
+JNIEXPORT jlong JNICALL Java_com_dokar_quickjs_QuickJs_newRuntime(JNIEnv *env, jobject this,
+                                                                  jboolean accounted) {
+    MemoryAccounting *accounting = NULL;
+    JSRuntime *runtime;
+    if (accounted == JNI_TRUE) {
+        runtime = accounting_new_runtime(&accounting);
+    } else {
+        runtime = JS_NewRuntime();
+    }
+    if (runtime == NULL) {
+        jni_throw_qjs_exception(env, "Failed to create the runtime.");
+        return 0;
+    }
+    // Keep the accounting in the runtime, freed in releaseRuntime()
+    JS_SetRuntimeOpaque(runtime, accounting);
     return (jlong) runtime;
 }
 
@@ -92,6 +194,9 @@ Java_com_dokar_quickjs_QuickJs_newContext(JNIEnv *env, jobject this, jlong runti
         return 0;
     }
     JSContext *context = JS_NewContext(runtime);
+    if (context != NULL) {
+        register_binding_class(runtime, context);
+    }
     return (jlong) context;
 }
 
@@ -136,6 +241,41 @@ Java_com_dokar_quickjs_QuickJs_releaseGlobals(JNIEnv *env, jobject this, jlong c
     if (globals->defined_js_objects != NULL) {
         cvector_free(globals->defined_js_objects);
     }
+    if (globals->free_object_slots != NULL) {
+        cvector_free(globals->free_object_slots);
+    }
+
+    // Binding objects are freed with the context, detach them from the host
+    release_stale_bindings(env, globals);
+    release_binding_hosts(env, globals);
+    release_host_classes(env, context, globals);
+    release_shared_prototypes(context, globals);
+    JS_SetContextOpaque(context, NULL);
+
+    free_tracked_handles(globals);
+
+    cvector_vector_type(JSAtom)template_atoms = globals->template_atoms;
+    if (template_atoms != NULL) {
+        size_t size = cvector_size(template_atoms);
+        for (uint32_t i = 0; i < size; i++) {
+            JS_FreeAtom(context, template_atoms[i]);
+        }
+        cvector_free(template_atoms);
+        globals->template_atoms = NULL;
+    }
+
+    binding_stats_free(globals->binding_stats);
+    globals->binding_stats = NULL;
+
+    // Remove the interrupt handler before freeing its hooks
+    runtime_hooks_uninstall(JS_GetRuntime(context));
+
+    // Stop the timer thread
+    profiler_free(globals->profiler);
+    globals->profiler = NULL;
+
+    gc_stats_free(globals->gc_stats);
+    globals->gc_stats = NULL;
 
     // Check and free global jni object refs
     cvector_vector_type(jobject)global_object_refs = globals->global_object_refs;
@@ -185,7 +325,9 @@ Java_com_dokar_quickjs_QuickJs_releaseRuntime(JNIEnv *env, jobject this, jlong r
         return;
     }
     JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
+    MemoryAccounting *accounting = JS_GetRuntimeOpaque(runtime);
     JS_FreeRuntime(runtime);
+    accounting_free(accounting);
 }
 
 /**
@@ -198,7 +340,8 @@ Java_com_dokar_quickjs_QuickJs_defineObject(JNIEnv *env, jobject this,
                                             jlong parent,
                                             jstring name,
                                             jobjectArray properties,
-                                            jobjectArray function_names) {
+                                            jobjectArray function_names,
+                                            jstring prototype_key) {
     Globals *globals = globals_from_ptr(env, globals_ptr);
     if (globals == NULL) {
         return -1;
@@ -207,15 +350,18 @@ Java_com_dokar_quickjs_QuickJs_defineObject(JNIEnv *env, jobject this,
     if (context == NULL) {
         return -1;
     }
-    int64_t parent_index = parent;
-    uint32_t defined_size = cvector_size(globals->defined_js_objects);
-    if (parent_index >= defined_size) {
-        jni_throw_qjs_exception(env, "Parent handle out of the bounds.");
-        return -1;
+    release_stale_bindings(env, globals);
+    // Reserve the handle first, it may move the defined objects
+    int64_t handle = acquire_object_handle(globals);
+    JSValue *parent_val = NULL;
+    if (parent >= 0) {
+        parent_val = defined_object_of_handle(globals, parent);
+        if (parent_val == NULL) {
+            release_object_handle(globals, handle);
+            jni_throw_qjs_exception(env, "Parent object has been garbage-collected.");
+            return -1;
+        }
     }
-    JSValue *parent_val = parent_index < 0 ? NULL : &globals->defined_js_objects[parent_index];
-    // The global js value index
-    int64_t handle = defined_size;
     JSValue result = define_js_object(env,
                                       context,
                                       globals,
@@ -224,13 +370,104 @@ Java_com_dokar_quickjs_QuickJs_defineObject(JNIEnv *env, jobject this,
                                       handle,
                                       name,
                                       properties,
-                                      function_names);
-    // Insert at the target index
-    cvector_push_back(globals->defined_js_objects, result);
+                                      function_names,
+                                      prototype_key);
+    if (JS_IsException(result)) {
+        release_object_handle(globals, handle);
+        if (!(*env)->ExceptionCheck(env)) {
+            jni_throw_qjs_exception(env, "Failed to create the binding object.");
+        }
+        return -1;
+    }
+    set_defined_object(globals, handle, result);
     // Return the handle
     return handle;
 }
 
+/**
+ * Define the objects of an encoded binding tree to the 'parent', the handles are written to
+ * 'handles' in the tree order.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_defineObjectTree(JNIEnv *env, jobject this,
+                                                jlong globals_ptr,
+                                                jlong context_ptr,
+                                                jlong parent,
+                                                jbyteArray tree,
+                                                jobjectArray values,
+                                                jlongArray handles) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return;
+    }
+    JSContext *context = context_from_ptr(env, context_ptr);
+    if (context == NULL) {
+        return;
+    }
+    release_stale_bindings(env, globals);
+    if (parent >= 0 && defined_object_of_handle(globals, parent) == NULL) {
+        jni_throw_qjs_exception(env, "Parent object has been garbage-collected.");
+        return;
+    }
+
+    jsize max_count = (*env)->GetArrayLength(env, handles);
+    int64_t *object_handles = malloc(sizeof(int64_t) * (max_count > 0 ? max_count : 1));
+    if (object_handles == NULL) {
+        jni_throw_qjs_exception(env, "Failed to allocate handles of the binding tree.");
+        return;
+    }
+    jsize tree_len = (*env)->GetArrayLength(env, tree);
+    jbyte *tree_bytes = (*env)->GetByteArrayElements(env, tree, NULL);
+    if (tree_bytes == NULL) {
+        free(object_handles);
+        return;
+    }
+
+    int32_t count = define_js_object_tree(env, context, globals, this, parent,
+                                          (const uint8_t *) tree_bytes, (size_t) tree_len,
+                                          values, object_handles, max_count);
+
+    (*env)->ReleaseByteArrayElements(env, tree, tree_bytes, JNI_ABORT);
+    if (count < 0) {
+        free(object_handles);
+        // Keep the Java exception of a constant conversion, or report the JS one
+        if (!(*env)->ExceptionCheck(env) && !check_js_context_exception(env, context)) {
+            jni_throw_qjs_exception(env, "Failed to define the binding tree.");
+        }
+        return;
+    }
+    (*env)->SetLongArrayRegion(env, handles, 0, count, (const jlong *) object_handles);
+    free(object_handles);
+}
+
+/**
+ * Define a class for the host class, returns the class index.
+ */
+JNIEXPORT jint JNICALL
+Java_com_dokar_quickjs_QuickJs_defineClass(JNIEnv *env, jobject this,
+                                           jlong globals_ptr,
+                                           jlong context_ptr,
+                                           jclass cls,
+                                           jstring name,
+                                           jobjectArray properties,
+                                           jobjectArray functions) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return -1;
+    }
+    JSContext *context = context_from_ptr(env, context_ptr);
+    if (context == NULL) {
+        return -1;
+    }
+    int32_t class_index = define_host_class(env, context, globals, this, cls, name,
+                                            properties, functions);
+    if (class_index < 0) {
+        jni_throw_qjs_exception(env, "Failed to define the class.");
+        return -1;
+    }
+    return class_index;
+}
+
 /**
  * Define an object to the 'parent'.
  */
@@ -248,6 +485,7 @@ Java_com_dokar_quickjs_QuickJs_defineFunction(JNIEnv *env, jobject this,
     if (context == NULL) {
         return;
     }
+    release_stale_bindings(env, globals);
     define_js_function(env, context, globals, this, name, is_async);
 }
 
@@ -260,7 +498,80 @@ Java_com_dokar_quickjs_QuickJs_gc(JNIEnv *env, jobject this, jlong runtime_ptr,
     Globals *globals = globals_from_ptr(env, globals_ptr);
     pthread_mutex_lock(&globals->js_mutex);
     JS_UpdateStackTop(runtime);
-    JS_RunGC(runtime);
+    gc_stats_run(globals->gc_stats);
+    pthread_mutex_unlock(&globals->js_mutex);
+}
+
+/**
+ * Get the GC stats, see GC_STATS_SIZE for the layout.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getGcStats(JNIEnv *env, jobject this, jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    jlong stats[GC_STATS_SIZE];
+    pthread_mutex_lock(&globals->js_mutex);
+    gc_stats_snapshot(globals->gc_stats, (int64_t *) stats);
+    pthread_mutex_unlock(&globals->js_mutex);
+    jlongArray array = (*env)->NewLongArray(env, GC_STATS_SIZE);
+    (*env)->SetLongArrayRegion(env, array, 0, GC_STATS_SIZE, stats);
+    return array;
+}
+
+/**
+ * Get the opcode names, indexed by opcodes.
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getOpcodeNames(JNIEnv *env, jobject this) {
+    int count = opcode_stats_opcode_count();
+    jobjectArray array = (*env)->NewObjectArray(env, count, cls_string(env), NULL);
+    for (int i = 0; i < count; i++) {
+        jstring name = (*env)->NewStringUTF(env, opcode_stats_opcode_name(i));
+        (*env)->SetObjectArrayElement(env, array, i, name);
+        (*env)->DeleteLocalRef(env, name);
+    }
+    return array;
+}
+
+/**
+ * Get the executed opcode counts, returns NULL if the engine is not instrumented.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getOpcodeCounts(JNIEnv *env, jobject this, jlong runtime_ptr,
+                                               jlong globals_ptr) {
+    if (!opcode_stats_available()) {
+        return NULL;
+    }
+    JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (runtime == NULL || globals == NULL) {
+        return NULL;
+    }
+    int count = opcode_stats_opcode_count();
+    jlongArray array = (*env)->NewLongArray(env, count);
+    jlong *counts = (*env)->GetLongArrayElements(env, array, NULL);
+    pthread_mutex_lock(&globals->js_mutex);
+    opcode_stats_snapshot(runtime, (int64_t *) counts);
+    pthread_mutex_unlock(&globals->js_mutex);
+    (*env)->ReleaseLongArrayElements(env, array, counts, 0);
+    return array;
+}
+
+/**
+ * Reset the executed opcode counts.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_resetOpcodeCounts(JNIEnv *env, jobject this, jlong runtime_ptr,
+                                                 jlong globals_ptr) {
+    JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (runtime == NULL || globals == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    opcode_stats_reset(runtime);
     pthread_mutex_unlock(&globals->js_mutex);
 }
 
@@ -350,6 +661,277 @@ Java_com_dokar_quickjs_QuickJs_getMemoryUsage(JNIEnv *env, jobject this,
     return usage;
 }
 
+/**
+ * Start the memory accounting of an evaluation.
+ *
+ * @return The eval accounting, pass it to endEvalAccounting(). 0 if the runtime is not accounted.
+ */
+JNIEXPORT jlong JNICALL
+Java_com_dokar_quickjs_QuickJs_beginEvalAccounting(JNIEnv *env, jobject this,
+                                                   jlong runtime_ptr,
+                                                   jlong globals_ptr,
+                                                   jlong limit) {
+    JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
+    if (runtime == NULL) {
+        return 0;
+    }
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return 0;
+    }
+    MemoryAccounting *accounting = JS_GetRuntimeOpaque(runtime);
+    EvalAccounting *eval = NULL;
+    if (accounting != NULL) {
+        eval = malloc(sizeof(EvalAccounting));
+        if (eval == NULL) {
+            jni_throw_qjs_exception(env, "Failed to create the eval accounting.");
+            return 0;
+        }
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    if (eval != NULL) {
+        accounting_begin_eval(accounting, eval, limit);
+    }
+    binding_stats_begin_eval(globals->binding_stats);
+    globals->eval_compile_ns = 0;
+    pthread_mutex_unlock(&globals->js_mutex);
+    return (jlong) eval;
+}
+
+/**
+ * Stop the memory accounting of an evaluation and free the eval accounting.
+ *
+ * @return [allocated bytes, peak bytes], or NULL if the eval accounting is 0.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_dokar_quickjs_QuickJs_endEvalAccounting(JNIEnv *env, jobject this,
+                                                 jlong runtime_ptr,
+                                                 jlong globals_ptr,
+                                                 jlong eval_ptr) {
+    if (eval_ptr == 0) {
+        return NULL;
+    }
+    EvalAccounting *eval = (EvalAccounting *) eval_ptr;
+    JSRuntime *runtime = runtime_from_ptr(env, runtime_ptr);
+    if (runtime == NULL) {
+        return NULL;
+    }
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    accounting_end_eval(JS_GetRuntimeOpaque(runtime), eval);
+    pthread_mutex_unlock(&globals->js_mutex);
+    jlong stats[2] = {
+            (jlong) eval->allocated_bytes,
+            (jlong) eval->peak_bytes,
+    };
+    free(eval);
+    jlongArray array = (*env)->NewLongArray(env, 2);
+    (*env)->SetLongArrayRegion(env, array, 0, 2, stats);
+    return array;
+}
+
+/**
+ * Enable or disable recording creation sites of handles.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_setHandleTracking(JNIEnv *env, jobject this,
+                                                 jlong globals_ptr,
+                                                 jboolean enabled) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    globals->track_handles = enabled == JNI_TRUE;
+    pthread_mutex_unlock(&globals->js_mutex);
+}
+
+/**
+ * Get the counts of live handles, indexed by handle kinds.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getHandleCounts(JNIEnv *env, jobject this, jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    jlongArray counts = handle_counts_to_java(env, globals);
+    pthread_mutex_unlock(&globals->js_mutex);
+    return counts;
+}
+
+/**
+ * Get the creation sites of tracked handles.
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getTrackedHandles(JNIEnv *env, jobject this, jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    jobjectArray handles = tracked_handles_to_java(env, globals);
+    pthread_mutex_unlock(&globals->js_mutex);
+    return handles;
+}
+
+/**
+ * Enable or disable recording call metrics of bindings.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_setBindingStatsEnabled(JNIEnv *env, jobject this,
+                                                      jlong globals_ptr,
+                                                      jboolean enabled) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return;
+    }
+    binding_stats_set_enabled(globals->binding_stats, enabled == JNI_TRUE);
+}
+
+/**
+ * Get the names of binding stats slots.
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getBindingStatsNames(JNIEnv *env, jobject this,
+                                                    jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    int32_t count = binding_stats_slot_count(globals->binding_stats);
+    jobjectArray names = (*env)->NewObjectArray(env, count, cls_string(env), NULL);
+    for (int32_t i = 0; i < count; i++) {
+        jstring name = (*env)->NewStringUTF(env,
+                                            binding_stats_slot_name(globals->binding_stats, i));
+        (*env)->SetObjectArrayElement(env, names, i, name);
+        (*env)->DeleteLocalRef(env, name);
+    }
+    return names;
+}
+
+/**
+ * Get the binding stats of the first 'slot_count' slots, see BINDING_STATS_SLOT_SIZE for
+ * the layout.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getBindingStats(JNIEnv *env, jobject this,
+                                               jlong globals_ptr,
+                                               jint slot_count) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    size_t len = (size_t) slot_count * BINDING_STATS_SLOT_SIZE;
+    int64_t *buffer = malloc(sizeof(int64_t) * (len > 0 ? len : 1));
+    int32_t count = binding_stats_snapshot(globals->binding_stats, buffer, slot_count);
+    jsize copied = (jsize) ((size_t) count * BINDING_STATS_SLOT_SIZE);
+    jlongArray array = (*env)->NewLongArray(env, copied);
+    (*env)->SetLongArrayRegion(env, array, 0, copied, (const jlong *) buffer);
+    free(buffer);
+    return array;
+}
+
+/**
+ * Enable or disable the breakdown of slow evaluations, timing compilation and binding calls.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_setSlowEvalTracking(JNIEnv *env, jobject this,
+                                                   jlong globals_ptr,
+                                                   jboolean enabled) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    globals->time_evals = enabled == JNI_TRUE;
+    binding_stats_set_eval_tracking(globals->binding_stats, enabled == JNI_TRUE);
+    pthread_mutex_unlock(&globals->js_mutex);
+}
+
+/**
+ * Get the compile time of the current evaluation.
+ */
+JNIEXPORT jlong JNICALL
+Java_com_dokar_quickjs_QuickJs_getEvalCompileNanos(JNIEnv *env, jobject this,
+                                                   jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return 0;
+    }
+    return globals->eval_compile_ns;
+}
+
+/**
+ * Get bindings called in the current evaluation, see BINDING_STATS_EVAL_ENTRY_SIZE for the
+ * layout.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_dokar_quickjs_QuickJs_getEvalBindingCalls(JNIEnv *env, jobject this,
+                                                   jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    int32_t slot_count = binding_stats_slot_count(globals->binding_stats);
+    size_t len = (size_t) slot_count * BINDING_STATS_EVAL_ENTRY_SIZE;
+    int64_t *buffer = malloc(sizeof(int64_t) * (len > 0 ? len : 1));
+    int32_t count = binding_stats_eval_snapshot(globals->binding_stats, buffer, slot_count);
+    pthread_mutex_unlock(&globals->js_mutex);
+    jsize copied = (jsize) ((size_t) count * BINDING_STATS_EVAL_ENTRY_SIZE);
+    jlongArray array = (*env)->NewLongArray(env, copied);
+    (*env)->SetLongArrayRegion(env, array, 0, copied, (const jlong *) buffer);
+    free(buffer);
+    return array;
+}
+
+/**
+ * Start the sampling profiler.
+ */
+JNIEXPORT void JNICALL
+Java_com_dokar_quickjs_QuickJs_startProfiling(JNIEnv *env, jobject this,
+                                              jlong context_ptr,
+                                              jlong globals_ptr,
+                                              jlong interval_us) {
+    JSContext *context = context_from_ptr(env, context_ptr);
+    if (context == NULL) {
+        return;
+    }
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    int result = profiler_start(globals->profiler, context, interval_us);
+    pthread_mutex_unlock(&globals->js_mutex);
+    if (result != 0) {
+        jni_throw_qjs_exception(env, "Failed to start the profiler thread.");
+    }
+}
+
+/**
+ * Stop the sampling profiler, return samples in the collapsed stack format.
+ */
+JNIEXPORT jstring JNICALL
+Java_com_dokar_quickjs_QuickJs_stopProfiling(JNIEnv *env, jobject this, jlong globals_ptr) {
+    Globals *globals = globals_from_ptr(env, globals_ptr);
+    if (globals == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&globals->js_mutex);
+    profiler_stop(globals->profiler);
+    pthread_mutex_unlock(&globals->js_mutex);
+    char *stacks = profiler_collapsed_stacks(globals->profiler);
+    jstring result = (*env)->NewStringUTF(env, stacks != NULL ? stacks : "");
+    free(stacks);
+    return result;
+}
+
 jobject handle_eval_result(JNIEnv *env,
                            JSContext *context,
                            Globals *globals,
@@ -429,7 +1011,8 @@ jobject eval(JNIEnv *env, jlong context_ptr,
     JS_UpdateStackTop(JS_GetRuntime(context));
 
     // Run code
-    JSValue value = JS_Eval(context, code, strlen(code), filename, eval_flags);
+    JSValue value = timed_eval(context, code, strlen(code), filename, eval_flags,
+                               globals->time_evals ? &globals->eval_compile_ns : NULL);
 
     // Free strings
     (*env)->ReleaseStringUTFChars(env, jfilename, filename);
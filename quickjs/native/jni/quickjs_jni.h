@@ -5,6 +5,26 @@
 #include "cvector.h"
 #include "quickjs.h"
 #include "jni.h"
+#include "binding_stats.h"
+#include "sampling_profiler.h"
+#include "gc_stats.h"
+#include "runtime_hooks.h"
+
+struct BindingHost;
+
+struct HostClass;
+
+struct HostClassCacheEntry;
+
+struct HostInstance;
+
+struct SharedPrototype;
+
+struct TrackedHandle;
+
+struct DefinedObject;
+
+struct StaleBinding;
 
 /**
  * Global objects for the wrapped runtime.
@@ -15,9 +35,23 @@ typedef struct {
      */
     cvector_vector_type(JSValue)managed_js_values;
     /**
-     * Defined JS objects, keep them to support nested define.
+     * Defined JS objects, keep them to support nested define. Slots of collected objects are
+     * reused, see acquire_object_handle().
+     */
+    cvector_vector_type(struct DefinedObject)defined_js_objects;
+    /**
+     * Indexes of released slots in 'defined_js_objects'.
+     */
+    cvector_vector_type(uint32_t)free_object_slots;
+    /**
+     * Bindings finalized on a thread without a JNI env, the host is notified on the next JNI call.
+     */
+    cvector_vector_type(struct StaleBinding)stale_bindings;
+    /**
+     * Global refs of host instances finalized on a thread without a JNI env, they are deleted on
+     * the next JNI call.
      */
-    cvector_vector_type(JSValue)defined_js_objects;
+    cvector_vector_type(jobject)stale_host_refs;
     /**
      * Promise resolve/reject functions.
      */
@@ -26,6 +60,64 @@ typedef struct {
      * Global JNI refs.
      */
     cvector_vector_type(jobject)global_object_refs;
+    /**
+     * Hosts of the binding objects which are not finalized yet.
+     */
+    cvector_vector_type(struct BindingHost *)binding_hosts;
+    /**
+     * Classes defined by defineClass(), a class index is the index in this vector.
+     */
+    cvector_vector_type(struct HostClass)host_classes;
+    /**
+     * Host classes of the exact classes of converted objects, so an object doesn't check every
+     * host class. It's cleared when a class is defined.
+     */
+    cvector_vector_type(struct HostClassCacheEntry)host_class_cache;
+    /**
+     * Atoms interned from the atom template, freed when releasing globals.
+     */
+    cvector_vector_type(JSAtom)template_atoms;
+    /**
+     * The list of host instances which are not finalized yet.
+     */
+    struct HostInstance *host_instances;
+    /**
+     * Prototypes shared by object bindings with the same key, a prototype index is the index in
+     * this vector.
+     */
+    cvector_vector_type(struct SharedPrototype)shared_prototypes;
+    /**
+     * Creation sites of handles, only recorded when handle tracking is enabled.
+     */
+    cvector_vector_type(struct TrackedHandle)tracked_handles;
+    /**
+     * Whether to record creation sites of handles.
+     */
+    int track_handles;
+    /**
+     * Call metrics of binding members, recorded only when enabled.
+     */
+    BindingStats *binding_stats;
+    /**
+     * The sampling profiler, samples are captured by the interrupt handler while running.
+     */
+    SamplingProfiler *profiler;
+    /**
+     * Pause and reclaim stats of GC runs.
+     */
+    GcStats *gc_stats;
+    /**
+     * Hooks of the runtime interrupt handler.
+     */
+    RuntimeHooks runtime_hooks;
+    /**
+     * Whether to time the compilation of evaluations, enabled by the slow evaluation log.
+     */
+    int time_evals;
+    /**
+     * The compile time of the current evaluation.
+     */
+    int64_t eval_compile_ns;
     /**
      * Result promises of eval calls.
      */
@@ -37,4 +129,130 @@ typedef struct {
     pthread_mutex_t js_mutex;
 } Globals;
 
+/**
+ * The opaque of a binding object. It's owned by the JS object and released by the class finalizer.
+ */
+typedef struct BindingHost {
+    /**
+     * Global JNI ref of the QuickJs instance, NULL after globals are released.
+     */
+    jobject host;
+    /**
+     * Handle of the binding object, or -1 for global functions.
+     */
+    int64_t handle;
+    /**
+     * Index of the shared prototype in 'Globals.shared_prototypes', or -1 if members are defined
+     * on the object itself.
+     */
+    int32_t prototype_index;
+    /**
+     * Globals of the runtime, NULL after globals are released.
+     */
+    Globals *globals;
+    /**
+     * Index in 'Globals.binding_hosts'.
+     */
+    size_t host_index;
+} BindingHost;
+
+/**
+ * A slot of 'Globals.defined_js_objects'.
+ */
+typedef struct DefinedObject {
+    /**
+     * The object, it's not owned by the slot. JS_UNDEFINED if the slot is free or the object has
+     * been garbage-collected.
+     */
+    JSValue value;
+    /**
+     * Bumped when the slot is released, handles of the previous objects won't match it.
+     */
+    uint32_t generation;
+} DefinedObject;
+
+/**
+ * A finalized binding whose host has not been notified yet.
+ */
+typedef struct StaleBinding {
+    /**
+     * Global JNI ref of the QuickJs instance.
+     */
+    jobject host;
+    /**
+     * Handle of the binding object, or -1 for global functions.
+     */
+    int64_t handle;
+} StaleBinding;
+
+/**
+ * A class defined by defineClass().
+ */
+typedef struct HostClass {
+    /**
+     * Global JNI ref of the host class, used to find the JS class of host objects.
+     */
+    jclass cls;
+    /**
+     * The class prototype, accessors and functions are defined on it.
+     */
+    JSValue proto;
+} HostClass;
+
+/**
+ * The host class of an exact object class.
+ */
+typedef struct HostClassCacheEntry {
+    /**
+     * The identity hash code of the class, compared before the class itself.
+     */
+    jint hash;
+    /**
+     * Global JNI ref of the exact class.
+     */
+    jclass cls;
+    /**
+     * Index of the host class in 'Globals.host_classes', or -1 if it's not a host class.
+     */
+    int32_t class_index;
+} HostClassCacheEntry;
+
+/**
+ * The opaque of a host instance. It's owned by the JS object and released by the class finalizer.
+ */
+typedef struct HostInstance {
+    /**
+     * Global JNI ref of the host object, NULL after globals are released.
+     */
+    jobject instance;
+    /**
+     * Index of the class in 'Globals.host_classes'.
+     */
+    int32_t class_index;
+    /**
+     * Globals of the runtime, NULL after globals are released.
+     */
+    Globals *globals;
+    struct HostInstance *prev;
+    struct HostInstance *next;
+} HostInstance;
+
+/**
+ * A prototype shared by object bindings with the same key.
+ */
+typedef struct SharedPrototype {
+    /**
+     * The prototype key, owned by the prototype.
+     */
+    char *key;
+    /**
+     * The sorted member entries of the first binding, later bindings with the key must match.
+     */
+    char *members;
+    /**
+     * The prototype, accessors and functions are defined on it.
+     */
+    JSValue proto;
+} SharedPrototype;
+
 #endif //QJS_KT_JNI_H
@@ -0,0 +1,58 @@
+package com.dokar.quickjs
+
+import com.dokar.quickjs.binding.ObjectBinding
+
+/**
+ * A set of names to intern as atoms when creating a [QuickJs] instance, usually binding names,
+ * property names and common keys. Build it once and share it between pooled instances.
+ *
+ * The atom hash of the new runtime is sized for all names before interning, so it doesn't grow
+ * and rehash while creating them. The atoms are kept until closing, so later defines and
+ * evaluations only look them up. Atoms are owned by the runtime in QuickJS, so each instance
+ * still has its own atom table.
+ */
+@ExperimentalQuickJsApi
+class AtomTemplate private constructor(
+    internal val names: Array<String>,
+) {
+    /**
+     * The count of names in the template.
+     */
+    val size: Int get() = names.size
+
+    class Builder {
+        private val names = linkedSetOf<String>()
+
+        /**
+         * Add names.
+         */
+        fun add(vararg names: String): Builder = apply {
+            this.names.addAll(names)
+        }
+
+        /**
+         * Add names.
+         */
+        fun addAll(names: Iterable<String>): Builder = apply {
+            this.names.addAll(names)
+        }
+
+        /**
+         * Add the binding name and the names of its properties and functions.
+         */
+        fun addBinding(name: String, binding: ObjectBinding): Builder = apply {
+            names.add(name)
+            binding.properties.forEach { names.add(it.name) }
+            binding.functions.forEach { names.add(it.name) }
+        }
+
+        fun build(): AtomTemplate = AtomTemplate(names.toTypedArray())
+    }
+
+    companion object {
+        /**
+         * Create a template from names.
+         */
+        fun of(vararg names: String): AtomTemplate = Builder().add(*names).build()
+    }
+}
@@ -0,0 +1,86 @@
+package com.dokar.quickjs
+
+/**
+ * Call types of binding members.
+ */
+@ExperimentalQuickJsApi
+enum class BindingCallType {
+    Getter,
+    Setter,
+    Function,
+
+    /**
+     * Async functions, the host execution time only covers launching the call.
+     */
+    AsyncFunction,
+}
+
+/**
+ * Call metrics of a binding member.
+ *
+ * @param name The member name, prefixed with the object name, e.g. 'app.version'.
+ * @param callType The call type.
+ * @param callCount The count of recorded calls.
+ * @param errorCount The count of failed calls.
+ * @param argConversion Time of converting JS arguments to host values.
+ * @param hostExecution Time of executing the host binding.
+ * @param resultConversion Time of converting the host result to a JS value.
+ */
+@ExperimentalQuickJsApi
+class BindingCallStats internal constructor(
+    val name: String,
+    val callType: BindingCallType,
+    val callCount: Long,
+    val errorCount: Long,
+    val argConversion: LatencyHistogram,
+    val hostExecution: LatencyHistogram,
+    val resultConversion: LatencyHistogram,
+) {
+    override fun toString(): String {
+        return "BindingCallStats(name='$name', callType=$callType, callCount=$callCount, " +
+                "errorCount=$errorCount, argConversion=$argConversion, " +
+                "hostExecution=$hostExecution, resultConversion=$resultConversion)"
+    }
+
+    internal companion object {
+        // Keep in sync with 'binding_stats.h'
+        const val SLOT_SIZE = 3 + 3 * LatencyHistogram.SIZE
+
+        /**
+         * Parse the native snapshot, members without recorded calls are skipped.
+         */
+        fun fromSnapshot(names: Array<String>, data: LongArray): List<BindingCallStats> {
+            val count = minOf(names.size, data.size / SLOT_SIZE)
+            val result = mutableListOf<BindingCallStats>()
+            for (i in 0 until count) {
+                val offset = i * SLOT_SIZE
+                val callCount = data[offset + 1]
+                if (callCount == 0L) continue
+                result.add(
+                    BindingCallStats(
+                        name = names[i],
+                        callType = BindingCallType.entries[data[offset].toInt()],
+                        callCount = callCount,
+                        errorCount = data[offset + 2],
+                        argConversion = LatencyHistogram.fromSnapshot(
+                            count = callCount,
+                            data = data,
+                            offset = offset + 3,
+                        ),
+                        hostExecution = LatencyHistogram.fromSnapshot(
+                            count = callCount,
+                            data = data,
+                            offset = offset + 3 + LatencyHistogram.SIZE,
+                        ),
+                        resultConversion = LatencyHistogram.fromSnapshot(
+                            count = callCount,
+                            data = data,
+                            offset = offset + 3 + 2 * LatencyHistogram.SIZE,
+                        ),
+                    )
+                )
+            }
+            return result
+        }
+    }
+}
@@ -0,0 +1,65 @@
+package com.dokar.quickjs
+
+/**
+ * Samples of JS call stacks recorded by the sampling profiler.
+ *
+ * @param samples Sampled stacks, sorted by count in descending order.
+ * @param samplingIntervalMicros The sampling interval of the profiling session.
+ */
+@ExperimentalQuickJsApi
+class CpuProfile internal constructor(
+    val samples: List<StackSample>,
+    val samplingIntervalMicros: Long,
+) {
+    /**
+     * The count of all samples.
+     */
+    val sampleCount: Long get() = samples.sumOf { it.count }
+
+    /**
+     * Export samples in the collapsed stack format, which can be rendered by flamegraph tools.
+     */
+    fun toCollapsedStacks(): String {
+        return samples.joinToString(separator = "") { sample ->
+            sample.frames.joinToString(separator = ";", postfix = " ${sample.count}\n")
+        }
+    }
+
+    override fun toString(): String {
+        return "CpuProfile(sampleCount=$sampleCount, stacks=${samples.size}, " +
+                "samplingIntervalMicros=$samplingIntervalMicros)"
+    }
+
+    internal companion object {
+        /**
+         * Parse the collapsed stacks exported by the native profiler.
+         */
+        fun fromCollapsedStacks(text: String, samplingIntervalMicros: Long): CpuProfile {
+            val samples = text.lineSequence()
+                .filter { it.isNotEmpty() }
+                .mapNotNull { line ->
+                    val separator = line.lastIndexOf(' ')
+                    if (separator <= 0) return@mapNotNull null
+                    val count = line.substring(separator + 1).toLongOrNull()
+                        ?: return@mapNotNull null
+                    StackSample(frames = line.substring(0, separator).split(';'), count = count)
+                }
+                .sortedByDescending { it.count }
+                .toList()
+            return CpuProfile(samples = samples, samplingIntervalMicros = samplingIntervalMicros)
+        }
+    }
+}
+
+/**
+ * A sampled JS call stack.
+ *
+ * @param frames Frames from the root to the leaf, formatted as 'name (file:line)'. Stacks deeper
+ * than 256 frames start with a '...' frame.
+ * @param count How many times the stack was sampled.
+ */
+@ExperimentalQuickJsApi
+data class StackSample(
+    val frames: List<String>,
+    val count: Long,
+)
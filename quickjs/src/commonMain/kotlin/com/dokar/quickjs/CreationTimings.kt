@@ -0,0 +1,55 @@
+package com.dokar.quickjs
+
+import kotlin.time.TimeSource
+
+/**
+ * Time spent on creating a [QuickJs] instance, split by steps.
+ *
+ * @param libraryLoadNanos Time of loading the native library, it's loaded once and shared by
+ * all instances. Always 0 on Kotlin/Native, where the library is linked statically.
+ * @param runtimeNanos Time of creating the JS runtime.
+ * @param contextNanos Time of creating the JS context, including the intrinsic objects.
+ * @param globalsNanos Time of creating the bridge state, e.g. binding classes and stats.
+ */
+@ExperimentalQuickJsApi
+class CreationTimings internal constructor(
+    val libraryLoadNanos: Long,
+    val runtimeNanos: Long,
+    val contextNanos: Long,
+    val globalsNanos: Long,
+) {
+    /**
+     * Time of creating the instance, excluding the library load.
+     */
+    val totalNanos: Long get() = runtimeNanos + contextNanos + globalsNanos
+
+    override fun toString(): String {
+        return "CreationTimings(libraryLoadNanos=$libraryLoadNanos, runtimeNanos=$runtimeNanos, " +
+                "contextNanos=$contextNanos, globalsNanos=$globalsNanos)"
+    }
+}
+
+/**
+ * Time the creation steps, call [lap] after the runtime and the context are created, then
+ * [finish] after the globals are created.
+ */
+@ExperimentalQuickJsApi
+internal class CreationTimer {
+    private var mark = TimeSource.Monotonic.markNow()
+    private val laps = LongArray(2)
+    private var lapCount = 0
+
+    fun lap() {
+        laps[lapCount++] = mark.elapsedNow().inWholeNanoseconds
+        mark = TimeSource.Monotonic.markNow()
+    }
+
+    fun finish(libraryLoadNanos: Long): CreationTimings {
+        return CreationTimings(
+            libraryLoadNanos = libraryLoadNanos,
+            runtimeNanos = laps[0],
+            contextNanos = laps[1],
+            globalsNanos = mark.elapsedNow().inWholeNanoseconds,
+        )
+    }
+}
@@ -0,0 +1,65 @@
+package com.dokar.quickjs
+
+/**
+ * Memory accounting of an evaluation, including the async jobs it awaited.
+ *
+ * @param allocatedBytes Bytes allocated during the evaluation, including freed allocations.
+ * @param peakBytes The peak growth of the live heap during the evaluation.
+ */
+@ExperimentalQuickJsApi
+class EvalMemoryStats(
+    val allocatedBytes: Long,
+    val peakBytes: Long,
+) {
+    override fun equals(other: Any?): Boolean {
+        if (this === other) return true
+        if (other !is EvalMemoryStats) return false
+
+        if (allocatedBytes != other.allocatedBytes) return false
+        if (peakBytes != other.peakBytes) return false
+
+        return true
+    }
+
+    override fun hashCode(): Int {
+        var result = allocatedBytes.hashCode()
+        result = 31 * result + peakBytes.hashCode()
+        return result
+    }
+
+    override fun toString(): String {
+        return "EvalMemoryStats(allocatedBytes=$allocatedBytes, peakBytes=$peakBytes)"
+    }
+}
+
+/**
+ * The result of [QuickJs.evaluateWithMemoryStats].
+ *
+ * @param value The evaluation result.
+ * @param memoryStats The memory accounting of this evaluation.
+ */
+@ExperimentalQuickJsApi
+class EvalMemoryResult<T>(
+    val value: T,
+    val memoryStats: EvalMemoryStats,
+) {
+    override fun equals(other: Any?): Boolean {
+        if (this === other) return true
+        if (other !is EvalMemoryResult<*>) return false
+
+        if (value != other.value) return false
+        if (memoryStats != other.memoryStats) return false
+
+        return true
+    }
+
+    override fun hashCode(): Int {
+        var result = value?.hashCode() ?: 0
+        result = 31 * result + memoryStats.hashCode()
+        return result
+    }
+
+    override fun toString(): String {
+        return "EvalMemoryResult(value=$value, memoryStats=$memoryStats)"
+    }
+}
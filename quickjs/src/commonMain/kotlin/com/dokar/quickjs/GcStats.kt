@@ -0,0 +1,51 @@
+package com.dokar.quickjs
+
+/**
+ * Stats of the GC runs of a [QuickJs] instance.
+ *
+ * @param explicitCount The count of GCs run by [QuickJs.gc].
+ * @param thresholdCount The count of GCs triggered by the allocation threshold.
+ * @param freedAllocations The count of allocations freed by GCs.
+ * @param reclaimedBytes The bytes reclaimed by GCs.
+ * @param pauses Pause times of all GC runs.
+ */
+@ExperimentalQuickJsApi
+class GcStats internal constructor(
+    val explicitCount: Long,
+    val thresholdCount: Long,
+    val freedAllocations: Long,
+    val reclaimedBytes: Long,
+    val pauses: LatencyHistogram,
+) {
+    /**
+     * The count of all GC runs.
+     */
+    val count: Long get() = explicitCount + thresholdCount
+
+    override fun toString(): String {
+        return "GcStats(explicitCount=$explicitCount, thresholdCount=$thresholdCount, " +
+                "freedAllocations=$freedAllocations, reclaimedBytes=$reclaimedBytes, " +
+                "pauses=$pauses)"
+    }
+
+    internal companion object {
+        // Keep in sync with 'gc_stats.h'
+        const val SIZE = 4 + LatencyHistogram.SIZE
+
+        fun fromSnapshot(data: LongArray): GcStats {
+            val explicitCount = data[0]
+            val thresholdCount = data[1]
+            return GcStats(
+                explicitCount = explicitCount,
+                thresholdCount = thresholdCount,
+                freedAllocations = data[2],
+                reclaimedBytes = data[3],
+                pauses = LatencyHistogram.fromSnapshot(
+                    count = explicitCount + thresholdCount,
+                    data = data,
+                    offset = 4,
+                ),
+            )
+        }
+    }
+}
@@ -0,0 +1,146 @@
+package com.dokar.quickjs
+
+/**
+ * Kinds of the handles held by the native bridge.
+ */
+@ExperimentalQuickJsApi
+enum class HandleKind {
+    /**
+     * JS values kept until the instance is closed, e.g. promises of async function calls.
+     */
+    ManagedJsValue,
+
+    /**
+     * Resolve and reject functions of async function calls.
+     */
+    PromiseFunction,
+
+    /**
+     * Global references to the host instance.
+     */
+    GlobalRef,
+
+    /**
+     * Binding objects that are not garbage-collected yet, each one holds a reference to the host.
+     * Objects that are hidden from scripts, e.g. the holders of global functions, are not counted.
+     */
+    BindingObject,
+}
+
+/**
+ * The creation site of handles.
+ *
+ * @param kind The handle kind.
+ * @param callType The call that created the handle, e.g. 'defineObject', 'asyncCall'. Handles
+ * created when handle tracking is disabled are reported as [UNTRACKED].
+ * @param binding The binding name, empty for untracked handles.
+ */
+@ExperimentalQuickJsApi
+data class HandleSite(
+    val kind: HandleKind,
+    val callType: String,
+    val binding: String,
+) {
+    override fun toString(): String {
+        return if (binding.isEmpty()) "$kind($callType)" else "$kind($callType '$binding')"
+    }
+
+    companion object {
+        const val UNTRACKED = "untracked"
+    }
+}
+
+/**
+ * Counts of the handles held by the native bridge, grouped by their creation sites.
+ *
+ * @param counts Handle counts by sites.
+ * @param jsObjectCount The object count of the JS heap.
+ */
+@ExperimentalQuickJsApi
+class HandleReport(
+    val counts: Map<HandleSite, Int>,
+    val jsObjectCount: Long,
+) {
+    /**
+     * The count of all handles.
+     */
+    val total: Int get() = counts.values.sum()
+
+    /**
+     * Get the handle count of a kind.
+     */
+    fun countOf(kind: HandleKind): Int {
+        return counts.entries.sumOf { if (it.key.kind == kind) it.value else 0 }
+    }
+
+    /**
+     * Get the sites that hold more handles than in the [baseline], values are the increases.
+     */
+    fun grownSince(baseline: HandleReport): Map<HandleSite, Int> {
+        return counts
+            .mapValues { (site, count) -> count - (baseline.counts[site] ?: 0) }
+            .filterValues { it > 0 }
+    }
+
+    override fun toString(): String {
+        val sites = counts.entries
+            .sortedByDescending { it.value }
+            .joinToString(separator = "") { "\n  ${it.key}: ${it.value}" }
+        return "HandleReport(total=$total, jsObjectCount=$jsObjectCount)$sites"
+    }
+
+    internal companion object {
+        /**
+         * Build a report from the live counts of each kind and the recorded sites. Handles
+         * without a recorded site are reported as untracked.
+         */
+        fun create(
+            kindCounts: LongArray,
+            trackedSites: List<HandleSite>,
+            jsObjectCount: Long,
+        ): HandleReport {
+            val counts = trackedSites.groupingBy { it }.eachCount().toMutableMap()
+            for (kind in HandleKind.entries) {
+                val tracked = trackedSites.count { it.kind == kind }
+                val untracked = kindCounts[kind.ordinal].toInt() - tracked
+                if (untracked > 0) {
+                    counts[HandleSite(kind, HandleSite.UNTRACKED, "")] = untracked
+                }
+            }
+            return HandleReport(counts = counts, jsObjectCount = jsObjectCount)
+        }
+    }
+}
+
+/**
+ * Run the [block] with handle tracking enabled, then check that handle counts and the JS object
+ * count return to the baseline after a GC. Useful in tests to find leaked handles.
+ *
+ * Note that values of async function calls are held until the instance is closed.
+ *
+ * @param jsObjectTolerance The allowed increase of the JS object count.
+ * @throws IllegalStateException If any site holds more handles than before.
+ */
+@ExperimentalQuickJsApi
+suspend fun QuickJs.assertHandlesReturnToBaseline(
+    jsObjectTolerance: Long = 0,
+    block: suspend QuickJs.() -> Unit,
+) {
+    val wasTracking = isHandleTrackingEnabled
+    isHandleTrackingEnabled = true
+    try {
+        gc()
+        val baseline = handleReport()
+        block()
+        gc()
+        val report = handleReport()
+        val grown = report.grownSince(baseline)
+        val objectGrowth = report.jsObjectCount - baseline.jsObjectCount
+        check(grown.isEmpty() && objectGrowth <= jsObjectTolerance) {
+            val sites = grown.entries.joinToString(separator = "") { "\n  ${it.key}: +${it.value}" }
+            "Handles did not return to the baseline, JS objects: +$objectGrowth$sites"
+        }
+    } finally {
+        isHandleTrackingEnabled = wasTracking
+    }
+}
@@ -0,0 +1,74 @@
+package com.dokar.quickjs
+
+/**
+ * A latency histogram with log-linear buckets, values are recorded in nanoseconds with a
+ * relative error of 25%.
+ *
+ * @param count The count of recorded values.
+ * @param totalNanos The sum of recorded values.
+ * @param maxNanos The max recorded value.
+ */
+@ExperimentalQuickJsApi
+class LatencyHistogram internal constructor(
+    val count: Long,
+    val totalNanos: Long,
+    val maxNanos: Long,
+    private val bucketCounts: LongArray,
+) {
+    /**
+     * The mean of recorded values, 0 if nothing is recorded.
+     */
+    val meanNanos: Long get() = if (count == 0L) 0L else totalNanos / count
+
+    /**
+     * Get the upper bound of the bucket that contains the value at the [percentile].
+     *
+     * @param percentile The percentile, in the range of 0.0 to 100.0.
+     */
+    fun valueAtPercentile(percentile: Double): Long {
+        require(percentile in 0.0..100.0) { "Percentile must be in 0..100, got $percentile" }
+        if (count == 0L) return 0L
+        val target = maxOf(1L, kotlin.math.ceil(count * percentile / 100.0).toLong())
+        var seen = 0L
+        for (i in bucketCounts.indices) {
+            seen += bucketCounts[i]
+            if (seen >= target) {
+                return minOf(bucketUpperBound(i), maxNanos)
+            }
+        }
+        return maxNanos
+    }
+
+    override fun toString(): String {
+        return "LatencyHistogram(count=$count, mean=${meanNanos}ns, " +
+                "p50=${valueAtPercentile(50.0)}ns, p99=${valueAtPercentile(99.0)}ns, " +
+                "max=${maxNanos}ns)"
+    }
+
+    internal companion object {
+        // Keep in sync with 'latency_histogram.h'
+        private const val SUB_BUCKET_BITS = 2
+        private const val MAX_VALUE_BITS = 40
+        private const val SUB_BUCKET_COUNT = 1 shl SUB_BUCKET_BITS
+        const val BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) shl SUB_BUCKET_BITS
+        const val SIZE = 2 + BUCKET_COUNT
+
+        fun bucketUpperBound(index: Int): Long {
+            if (index < SUB_BUCKET_COUNT) return index.toLong()
+            if (index == BUCKET_COUNT - 1) return Long.MAX_VALUE
+            val shift = (index shr SUB_BUCKET_BITS) - 1
+            val subBucket = index and (SUB_BUCKET_COUNT - 1)
+            val lowerBound = (SUB_BUCKET_COUNT + subBucket).toLong() shl shift
+            return lowerBound + (1L shl shift) - 1
+        }
+
+        fun fromSnapshot(count: Long, data: LongArray, offset: Int): LatencyHistogram {
+            return LatencyHistogram(
+                count = count,
+                totalNanos = data[offset],
+                maxNanos = data[offset + 1],
+                bucketCounts = data.copyOfRange(offset + 2, offset + SIZE),
+            )
+        }
+    }
+}
@@ -0,0 +1,165 @@
+package com.dokar.quickjs
+
+/**
+ * Kinds of property accesses, derived from the opcodes that perform them.
+ */
+@ExperimentalQuickJsApi
+enum class PropertyAccessKind {
+    /**
+     * Named property reads, e.g. 'obj.name'.
+     */
+    GetField,
+
+    /**
+     * Named property writes, e.g. 'obj.name = value'.
+     */
+    PutField,
+
+    /**
+     * Computed property reads, e.g. 'obj[key]'.
+     */
+    GetElement,
+
+    /**
+     * Computed property writes, e.g. 'obj[key] = value'.
+     */
+    PutElement,
+
+    /**
+     * Global variable reads and writes.
+     */
+    Global,
+
+    /**
+     * Local, argument and closure variable reads and writes.
+     */
+    Variable,
+
+    /**
+     * Private field and super property accesses.
+     */
+    Other,
+}
+
+/**
+ * Counts of executed opcodes, only available when the engine is built with the
+ * 'QJS_KT_OPCODE_STATS' CMake option.
+ *
+ * @param counts Executed opcodes and their counts, sorted by count in descending order.
+ * Opcodes that are not executed are skipped.
+ */
+@ExperimentalQuickJsApi
+class OpcodeStats internal constructor(
+    val counts: List<OpcodeCount>,
+) {
+    /**
+     * The count of all executed opcodes.
+     */
+    val totalCount: Long get() = counts.sumOf { it.count }
+
+    /**
+     * Counts of property accesses by kind, kinds without accesses are skipped.
+     */
+    val propertyAccesses: Map<PropertyAccessKind, Long>
+        get() {
+            val result = mutableMapOf<PropertyAccessKind, Long>()
+            for (item in counts) {
+                val kind = propertyAccessKindOf(item.name) ?: continue
+                result[kind] = (result[kind] ?: 0L) + item.count
+            }
+            return result
+        }
+
+    /**
+     * Format the [limit] most executed opcodes and the property access breakdown as a plain
+     * text table.
+     */
+    fun toReport(limit: Int = 30): String = buildString {
+        val total = totalCount
+        appendLine("Opcodes: $total executed, ${counts.size} distinct")
+        for (item in counts.take(limit)) {
+            append(item.name.padEnd(24))
+            append(item.count.toString().padStart(14))
+            appendLine(percentOf(item.count, total).padStart(9))
+        }
+        val accesses = propertyAccesses
+        if (accesses.isNotEmpty()) {
+            appendLine("Property accesses:")
+            for ((kind, count) in accesses.entries.sortedByDescending { it.value }) {
+                append(kind.name.padEnd(24))
+                append(count.toString().padStart(14))
+                appendLine(percentOf(count, total).padStart(9))
+            }
+        }
+    }
+
+    override fun toString(): String {
+        return "OpcodeStats(totalCount=$totalCount, distinct=${counts.size})"
+    }
+
+    internal companion object {
+        /**
+         * Parse the native counts, which are indexed by opcodes like [names].
+         */
+        fun fromSnapshot(names: Array<String>, data: LongArray): OpcodeStats {
+            val count = minOf(names.size, data.size)
+            val counts = (0 until count)
+                .filter { data[it] != 0L }
+                .map { OpcodeCount(name = names[it], count = data[it]) }
+                .sortedByDescending { it.count }
+            return OpcodeStats(counts)
+        }
+
+        private fun percentOf(count: Long, total: Long): String {
+            if (total == 0L) return "0.0%"
+            val permille = count * 1000 / total
+            return "${permille / 10}.${permille % 10}%"
+        }
+
+        /**
+         * Map opcode names in 'quickjs-opcode.h' to access kinds, null for other opcodes.
+         */
+        fun propertyAccessKindOf(opcode: String): PropertyAccessKind? {
+            return when {
+                opcode == "get_field" || opcode == "get_field2" || opcode == "get_length" ->
+                    PropertyAccessKind.GetField
+
+                opcode == "put_field" || opcode == "define_field" -> PropertyAccessKind.PutField
+
+                opcode.startsWith("get_array_el") || opcode == "get_array2" ||
+                        opcode == "get_ref_value" -> PropertyAccessKind.GetElement
+
+                opcode == "put_array_el" || opcode == "define_array_el" ||
+                        opcode == "put_ref_value" -> PropertyAccessKind.PutElement
+
+                opcode.endsWith("_var") || opcode == "get_var_undef" ||
+                        opcode == "put_var_init" || opcode == "put_var_strict" ->
+                    PropertyAccessKind.Global
+
+                opcode.startsWith("get_loc") || opcode.startsWith("put_loc") ||
+                        opcode.startsWith("set_loc") || opcode.startsWith("get_arg") ||
+                        opcode.startsWith("put_arg") || opcode.startsWith("set_arg") ||
+                        opcode.startsWith("get_var_ref") || opcode.startsWith("put_var_ref") ||
+                        opcode.startsWith("set_var_ref") -> PropertyAccessKind.Variable
+
+                opcode.startsWith("get_private_field") || opcode.startsWith("put_private_field") ||
+                        opcode == "define_private_field" || opcode == "get_super_value" ||
+                        opcode == "put_super_value" -> PropertyAccessKind.Other
+
+                else -> null
+            }
+        }
+    }
+}
+
+/**
+ * An executed opcode.
+ *
+ * @param name The opcode name, as defined in 'quickjs-opcode.h'.
+ * @param count How many times the opcode was executed.
+ */
+@ExperimentalQuickJsApi
+data class OpcodeCount(
+    val name: String,
+    val count: Long,
+)
@@ -1,6 +1,8 @@
 package com.dokar.quickjs
 
 import com.dokar.quickjs.binding.AsyncFunctionBinding
+import com.dokar.quickjs.binding.BindingTreeNode
+import com.dokar.quickjs.binding.ClassBinding
 import com.dokar.quickjs.binding.FunctionBinding
 import com.dokar.quickjs.binding.JsObjectHandle
 import com.dokar.quickjs.binding.ObjectBinding
@@ -9,6 +11,7 @@ import com.dokar.quickjs.converter.TypeConverters
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlin.coroutines.cancellation.CancellationException
 import kotlin.coroutines.coroutineContext
+import kotlin.reflect.KClass
 
 /**
  * DSL for [QuickJs]. The instance will be closed automatically when the [block] is finished.
@@ -73,6 +76,114 @@ expect class QuickJs {
      */
     val memoryUsage: MemoryUsage
 
+    /**
+     * Time spent on creating this instance.
+     */
+    @ExperimentalQuickJsApi
+    val creationTimings: CreationTimings
+
+    /**
+     * Pause and reclaim stats of the GC runs, including explicit [gc] calls and the automatic
+     * GCs triggered by the allocation threshold.
+     */
+    @ExperimentalQuickJsApi
+    val gcStats: GcStats
+
+    /**
+     * Counts of the opcodes executed since the instance was created or the last
+     * [resetOpcodeStats], or null if the engine is not built with the 'QJS_KT_OPCODE_STATS'
+     * CMake option.
+     */
+    @ExperimentalQuickJsApi
+    fun opcodeStats(): OpcodeStats?
+
+    /**
+     * Reset the opcode counts, does nothing if the engine is not instrumented.
+     */
+    @ExperimentalQuickJsApi
+    fun resetOpcodeStats()
+
+    /**
+     * Set the memory limit for each evaluation, -1 means no limit. It limits how much the heap
+     * can grow during an evaluation, allocations that exceed it fail with an out of memory
+     * error, only the current evaluation will be aborted.
+     *
+     * It requires memory accounting, see [create].
+     *
+     * @throws IllegalStateException If setting a limit while memory accounting is not enabled.
+     */
+    @ExperimentalQuickJsApi
+    var evalMemoryLimit: Long
+
+    /**
+     * Whether to record the creation sites of native handles, see [handleReport]. Handles
+     * created while it's disabled are reported as untracked.
+     */
+    @ExperimentalQuickJsApi
+    var isHandleTrackingEnabled: Boolean
+
+    /**
+     * Count the handles held by the native bridge, grouped by their creation sites.
+     */
+    @ExperimentalQuickJsApi
+    fun handleReport(): HandleReport
+
+    /**
+     * Whether to record call metrics of bindings, see [bindingStats]. Calls are not timed while
+     * it's disabled.
+     */
+    @ExperimentalQuickJsApi
+    var isBindingStatsEnabled: Boolean
+
+    /**
+     * Get the call metrics of binding members that have been called while recording.
+     */
+    @ExperimentalQuickJsApi
+    fun bindingStats(): List<BindingCallStats>
+
+    /**
+     * Start sampling JS call stacks, samples of the previous session are discarded. Stacks
+     * are captured at the next interrupt check after each tick, so idle time is not sampled.
+     *
+     * @param samplingIntervalMicros The sampling interval, defaults to 1 ms.
+     */
+    @ExperimentalQuickJsApi
+    fun startCpuProfiling(samplingIntervalMicros: Long = 1000)
+
+    /**
+     * Stop sampling and return the recorded profile.
+     */
+    @ExperimentalQuickJsApi
+    fun stopCpuProfiling(): CpuProfile
+
+    /**
+     * The tracer which receives begin and end callbacks of compiling, evaluating, loading
+     * modules, draining jobs, GC and binding calls. Defaults to [QuickJsTracer.NoOp].
+     */
+    @ExperimentalQuickJsApi
+    var tracer: QuickJsTracer
+
+    /**
+     * Report evaluations that take longer than this threshold to [slowEvalSink], -1 to disable.
+     * Defaults to -1. Evaluations under the threshold cost two clock reads.
+     */
+    @ExperimentalQuickJsApi
+    var slowEvalThresholdMillis: Long
+
+    /**
+     * Whether to split slow evaluations into phases and find their slowest bindings, see
+     * [SlowEvaluation]. It times the phases and the binding calls of every evaluation, not only
+     * the slow ones, so it's disabled by default.
+     */
+    @ExperimentalQuickJsApi
+    var isSlowEvalBreakdownEnabled: Boolean
+
+    /**
+     * The sink of slow evaluations, defaults to null. Evaluations are not timed without a sink.
+     */
+    @ExperimentalQuickJsApi
+    var slowEvalSink: SlowEvalSink?
+
     /**
      * Add type converters to extend the type mapping on function parameters,
      * function returns, and [evaluate] results.
@@ -118,6 +229,24 @@ expect class QuickJs {
         binding: AsyncFunctionBinding<R>,
     )
 
+    /**
+     * Define a JavaScript class for the host type [type], and attach its constructor to
+     * 'globalThis'. Host objects of [type] returned to JavaScript become instances of the class,
+     * they can be passed back to Kotlin as is. The constructor can't be called from JavaScript.
+     *
+     * Async functions are not supported by class bindings.
+     *
+     * @param name The class name in JavaScript code.
+     * @param type The host type.
+     * @param binding The kotlin binding, shared by all instances.
+     */
+    @ExperimentalQuickJsApi
+    fun <T : Any> defineClass(
+        name: String,
+        type: KClass<T>,
+        binding: ClassBinding<T>,
+    )
+
     /**
      * Add a JavaScript module
      *
@@ -180,6 +309,28 @@ expect class QuickJs {
         asModule: Boolean = false,
     ): T
 
+    /**
+     * Evaluate javascript code like [evaluate], and return the memory accounting of this
+     * evaluation with the result. The accounting covers the allocations made while the
+     * evaluation is in progress, including the async jobs it awaited.
+     *
+     * It requires memory accounting, see [create].
+     *
+     * @param T The result type.
+     * @param code The code to evaluate.
+     * @param filename The script filename.
+     * @param asModule Whether evaluate the code as a module or evaluate it globally.
+     * @throws QuickJsException If an error occurred when evaluating code or mapping values.
+     * @throws IllegalStateException If memory accounting is not enabled.
+     */
+    @ExperimentalQuickJsApi
+    @Throws(QuickJsException::class, CancellationException::class)
+    suspend inline fun <reified T> evaluateWithMemoryStats(
+        code: String,
+        filename: String = "main.js",
+        asModule: Boolean = false,
+    ): EvalMemoryResult<T>
+
     /**
      * Run GC.
      */
@@ -190,6 +341,12 @@ expect class QuickJs {
      */
     fun close()
 
+    /**
+     * Define a tree of object bindings and return their handles in the tree order. The JNI
+     * bridge defines all objects in one native call.
+     */
+    internal fun defineBindingTree(nodes: List<BindingTreeNode>): List<JsObjectHandle>
+
     /**
      * Start new job to invoke the suspend function.
      */
@@ -207,5 +364,23 @@ expect class QuickJs {
          */
         @Throws(QuickJsException::class)
         fun create(jobDispatcher: CoroutineDispatcher): QuickJs
+
+        /**
+         * Create new QuickJS runtime with experimental options.
+         *
+         * @param jobDispatcher The dispatcher for executing async jobs.
+         * @param atomTemplate The names to intern when creating, null to intern nothing.
+         * @param enableMemoryAccounting Whether to account the allocations of evaluations, it's
+         * required by [evalMemoryLimit] and [evaluateWithMemoryStats]. Each allocation of an
+         * accounted runtime carries a 16 bytes header, so it's disabled by default.
+         * @throws QuickJsException If failed to create a runtime.
+         */
+        @ExperimentalQuickJsApi
+        @Throws(QuickJsException::class)
+        fun create(
+            jobDispatcher: CoroutineDispatcher,
+            atomTemplate: AtomTemplate? = null,
+            enableMemoryAccounting: Boolean = false,
+        ): QuickJs
     }
 }
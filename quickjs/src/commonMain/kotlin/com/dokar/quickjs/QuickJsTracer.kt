@@ -0,0 +1,107 @@
+package com.dokar.quickjs
+
+/**
+ * Phases of [QuickJs] activity reported to tracers.
+ */
+@ExperimentalQuickJsApi
+enum class TracePhase {
+    /**
+     * Compiling code to bytecode.
+     */
+    Compile,
+
+    /**
+     * Evaluating code or bytecode, including the async jobs it awaited.
+     */
+    Evaluate,
+
+    /**
+     * Evaluating modules added by [QuickJs.addModule] before an evaluation.
+     */
+    LoadModules,
+
+    /**
+     * Draining pending JS jobs, e.g. promise reactions.
+     */
+    ExecutePendingJobs,
+
+    /**
+     * Running the garbage collector.
+     */
+    Gc,
+
+    /**
+     * Calling a host binding from JS.
+     */
+    BindingCall,
+}
+
+/**
+ * Receive begin and end callbacks of [QuickJs] activity, e.g. to add spans to distributed
+ * traces. Spans of the same instance can be nested, e.g. binding calls inside an evaluation.
+ *
+ * Callbacks are invoked on the thread that does the work, evaluation spans may end on a
+ * different thread than they began.
+ */
+@ExperimentalQuickJsApi
+interface QuickJsTracer {
+    /**
+     * Called when a phase begins.
+     *
+     * @param phase The phase.
+     * @param name The name of the work, e.g. the filename or the binding name.
+     * @param attributes Extra attributes of the phase.
+     * @return A token that is passed to [end], e.g. the span.
+     */
+    fun begin(phase: TracePhase, name: String, attributes: Map<String, Any?>): Any?
+
+    /**
+     * Called when a phase ends.
+     *
+     * @param phase The phase.
+     * @param token The token returned by [begin].
+     * @param error The error if the phase failed.
+     */
+    fun end(phase: TracePhase, token: Any?, error: Throwable?)
+
+    companion object {
+        /**
+         * The default tracer which does nothing, attributes are not collected with it.
+         */
+        val NoOp: QuickJsTracer = object : QuickJsTracer {
+            override fun begin(
+                phase: TracePhase,
+                name: String,
+                attributes: Map<String, Any?>,
+            ): Any? = null
+
+            override fun end(phase: TracePhase, token: Any?, error: Throwable?) {}
+        }
+    }
+}
+
+/**
+ * Run the [block] in a span of the [phase], attributes are only built if the tracer is not
+ * [QuickJsTracer.NoOp].
+ */
+@ExperimentalQuickJsApi
+internal inline fun <T> QuickJsTracer.trace(
+    phase: TracePhase,
+    name: String,
+    attributes: () -> Map<String, Any?> = { emptyMap() },
+    block: () -> T,
+): T {
+    if (this === QuickJsTracer.NoOp) {
+        return block()
+    }
+    val token = begin(phase, name, attributes())
+    var error: Throwable? = null
+    try {
+        return block()
+    } catch (e: Throwable) {
+        error = e
+        throw e
+    } finally {
+        end(phase, token, error)
+    }
+}
@@ -0,0 +1,195 @@
+package com.dokar.quickjs
+
+import kotlin.time.TimeSource
+
+/**
+ * An evaluation that took longer than [QuickJs.slowEvalThresholdMillis].
+ *
+ * @param filename The filename of the code, or 'bytecode' for bytecode evaluations.
+ * @param sourceHash The FNV-1a hash of the code or bytecode, in hex.
+ * @param durationNanos The total duration.
+ * @param compileNanos Time of compiling the code, 0 for bytecode evaluations.
+ * @param runNanos Time of running the compiled code.
+ * @param asyncWaitNanos Time of awaiting async jobs and promises.
+ * @param resultConversionNanos Time of converting the result to a host value.
+ * @param bindingCallCount The count of binding calls.
+ * @param topBindings Bindings that took the most time, sorted by time in descending order.
+ *
+ * The phases and bindings are only recorded when [QuickJs.isSlowEvalBreakdownEnabled] is true,
+ * otherwise the phase times and [bindingCallCount] are -1 and [topBindings] is empty.
+ */
+@ExperimentalQuickJsApi
+class SlowEvaluation internal constructor(
+    val filename: String,
+    val sourceHash: String,
+    val durationNanos: Long,
+    val compileNanos: Long,
+    val runNanos: Long,
+    val asyncWaitNanos: Long,
+    val resultConversionNanos: Long,
+    val bindingCallCount: Long,
+    val topBindings: List<BindingTime>,
+) {
+    override fun toString(): String {
+        return "SlowEvaluation(filename='$filename', sourceHash=$sourceHash, " +
+                "duration=${durationNanos}ns, compile=${compileNanos}ns, run=${runNanos}ns, " +
+                "asyncWait=${asyncWaitNanos}ns, resultConversion=${resultConversionNanos}ns, " +
+                "bindingCallCount=$bindingCallCount, topBindings=$topBindings)"
+    }
+}
+
+/**
+ * Calls of a binding member in an evaluation.
+ *
+ * @param name The member name, prefixed with the object name, e.g. 'app.version'.
+ * @param callCount The count of calls.
+ * @param totalNanos The total time of calls, including argument and result conversion.
+ */
+@ExperimentalQuickJsApi
+class BindingTime internal constructor(
+    val name: String,
+    val callCount: Long,
+    val totalNanos: Long,
+) {
+    override fun toString(): String {
+        return "BindingTime(name='$name', callCount=$callCount, total=${totalNanos}ns)"
+    }
+}
+
+/**
+ * Receive slow evaluations. It's called before the evaluation returns, on the thread that
+ * finished the evaluation, so it must not use the same [QuickJs] instance.
+ *
+ * Exceptions thrown by the sink are thrown by the evaluation like other host errors. If the
+ * evaluation failed, they are added to the suppressed exceptions of its error instead.
+ */
+@ExperimentalQuickJsApi
+fun interface SlowEvalSink {
+    fun onSlowEvaluation(evaluation: SlowEvaluation)
+}
+
+/**
+ * Time an evaluation. Without the breakdown it only reads the clock when starting and
+ * finishing, the record is built for slow evaluations only.
+ */
+@ExperimentalQuickJsApi
+internal class SlowEvalTimer(val thresholdMillis: Long, val isBreakdownEnabled: Boolean) {
+    // Not private, they are used by the inline function
+    val start = TimeSource.Monotonic.markNow()
+    var evaluatedNanos = -1L
+        private set
+    var awaitedNanos = -1L
+        private set
+
+    fun evaluated() {
+        if (isBreakdownEnabled) {
+            evaluatedNanos = start.elapsedNow().inWholeNanoseconds
+        }
+    }
+
+    fun awaited() {
+        if (isBreakdownEnabled) {
+            awaitedNanos = start.elapsedNow().inWholeNanoseconds
+        }
+    }
+
+    /**
+     * End the evaluation and return the record if it's slow, send it with [report] after
+     * the evaluation is settled. Phases that are not reached,
+     * e.g. when the evaluation failed, end with the evaluation.
+     *
+     * @param sourceHash Called only for slow evaluations.
+     * @param compileNanos Called only for slow evaluations with the breakdown.
+     * @param bindingCalls Called only for slow evaluations with the breakdown, returns the
+     * names of binding slots and [slot, call count, total ns] entries of bindings called in the
+     * evaluation.
+     */
+    inline fun finish(
+        filename: String,
+        sourceHash: () -> String,
+        compileNanos: () -> Long,
+        bindingCalls: () -> Pair<Array<String>, LongArray>,
+    ): SlowEvaluation? {
+        val end = start.elapsedNow().inWholeNanoseconds
+        if (end < thresholdMillis * 1_000_000) return null
+        if (!isBreakdownEnabled) {
+            return SlowEvaluation(
+                filename = filename,
+                sourceHash = sourceHash(),
+                durationNanos = end,
+                compileNanos = -1,
+                runNanos = -1,
+                asyncWaitNanos = -1,
+                resultConversionNanos = -1,
+                bindingCallCount = -1,
+                topBindings = emptyList(),
+            )
+        }
+        val evaluated = if (evaluatedNanos >= 0) evaluatedNanos else end
+        val awaited = if (awaitedNanos >= 0) awaitedNanos else end
+        val compile = compileNanos().coerceIn(0, evaluated)
+        val (names, entries) = bindingCalls()
+        val bindings = (0 until entries.size / BINDING_ENTRY_SIZE).map {
+            val offset = it * BINDING_ENTRY_SIZE
+            BindingTime(
+                name = names.getOrElse(entries[offset].toInt()) { "" },
+                callCount = entries[offset + 1],
+                totalNanos = entries[offset + 2],
+            )
+        }
+        return SlowEvaluation(
+            filename = filename,
+            sourceHash = sourceHash(),
+            durationNanos = end,
+            compileNanos = compile,
+            runNanos = evaluated - compile,
+            asyncWaitNanos = awaited - evaluated,
+            resultConversionNanos = end - awaited,
+            bindingCallCount = bindings.sumOf { it.callCount },
+            topBindings = bindings.sortedByDescending { it.totalNanos }.take(TOP_BINDINGS),
+        )
+    }
+
+    companion object {
+        /**
+         * Send a slow [evaluation] to the [sink]. The sink failure is thrown if the evaluation
+         * succeeded, it never replaces the [error] of the evaluation.
+         */
+        fun report(sink: SlowEvalSink?, evaluation: SlowEvaluation?, error: Throwable?) {
+            if (sink == null || evaluation == null) return
+            if (error == null) {
+                sink.onSlowEvaluation(evaluation)
+                return
+            }
+            try {
+                sink.onSlowEvaluation(evaluation)
+            } catch (e: Throwable) {
+                error.addSuppressed(e)
+            }
+        }
+
+        // Keep in sync with 'binding_stats.h'
+        const val BINDING_ENTRY_SIZE = 3
+
+        const val TOP_BINDINGS = 5
+
+        fun hashSource(code: String): String {
+            var hash = FNV_OFFSET_BASIS
+            for (char in code) {
+                hash = (hash xor char.code.toLong()) * FNV_PRIME
+            }
+            return hash.toULong().toString(16).padStart(16, '0')
+        }
+
+        fun hashSource(bytecode: ByteArray): String {
+            var hash = FNV_OFFSET_BASIS
+            for (byte in bytecode) {
+                hash = (hash xor (byte.toLong() and 0xFF)) * FNV_PRIME
+            }
+            return hash.toULong().toString(16).padStart(16, '0')
+        }
+
+        private const val FNV_OFFSET_BASIS = -0x340d631b7bdddcdbL
+        private const val FNV_PRIME = 0x100000001b3L
+    }
+}
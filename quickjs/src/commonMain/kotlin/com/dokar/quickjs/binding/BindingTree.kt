@@ -0,0 +1,29 @@
+package com.dokar.quickjs.binding
+
+import com.dokar.quickjs.QuickJs
+
+/**
+ * An object of a binding tree. [parentIndex] is the index of the parent in the tree, or -1 if
+ * the object is attached to 'globalThis'.
+ */
+internal class BindingTreeNode(
+    val name: String,
+    val binding: ObjectBinding,
+    val parentIndex: Int,
+)
+
+/**
+ * Flatten the scope and its sub scopes to a binding tree, parents come before their children.
+ */
+internal fun ObjectBindingScopeImpl.toBindingTree(quickJs: QuickJs): List<BindingTreeNode> {
+    val nodes = mutableListOf<BindingTreeNode>()
+    fun add(scope: ObjectBindingScopeImpl, parentIndex: Int) {
+        val index = nodes.size
+        nodes.add(BindingTreeNode(scope.name, DslObjectBinding(scope, quickJs), parentIndex))
+        for (sub in scope.subScopes) {
+            add(sub, index)
+        }
+    }
+    add(this, parentIndex = -1)
+    return nodes
+}
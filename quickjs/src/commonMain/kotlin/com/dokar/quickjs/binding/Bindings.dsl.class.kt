@@ -0,0 +1,81 @@
+package com.dokar.quickjs.binding
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import kotlin.reflect.KClass
+
+/**
+ * Define a JavaScript class for the host type [T] and attach its constructor to 'globalThis'.
+ *
+ * ```kotlin
+ * defineClass<Item>("Item") {
+ *     property<String>("name") {
+ *         getter { it.name }
+ *     }
+ *     function("total") { item, _ -> item.price * item.count }
+ * }
+ * function("items") { store.items }
+ * ```
+ *
+ * @see QuickJs.defineClass
+ */
+@ExperimentalQuickJsApi
+inline fun <reified T : Any> QuickJs.defineClass(
+    name: String,
+    noinline block: ClassBindingScope<T>.() -> Unit,
+) {
+    defineDslClass(name = name, type = T::class, block = block)
+}
+
+@PublishedApi
+@ExperimentalQuickJsApi
+internal fun <T : Any> QuickJs.defineDslClass(
+    name: String,
+    type: KClass<T>,
+    block: ClassBindingScope<T>.() -> Unit,
+) {
+    val scope = ClassBindingScopeImpl<T>(name = name).also(block)
+    defineClass(name = name, type = type, binding = DslClassBinding(scope, this))
+}
+
+/**
+ * The binding scope of a class.
+ */
+interface ClassBindingScope<T : Any> {
+    /**
+     * Define a property on the class prototype.
+     */
+    fun <V> property(name: String, block: ClassPropertyScope<T, V>.() -> Unit)
+
+    /**
+     * Define a function on the class prototype.
+     */
+    fun <R> function(name: String, block: (instance: T, args: Array<Any?>) -> R)
+}
+
+interface ClassPropertyScope<T : Any, V> {
+    /**
+     * The 'configurable' descriptor.
+     */
+    var configurable: Boolean
+
+    /**
+     * The 'writable' descriptor. If null it will be decided by whether the setter is set or not.
+     */
+    var writable: Boolean?
+
+    /**
+     * The 'enumerable' descriptor.
+     */
+    var enumerable: Boolean
+
+    /**
+     * Define the getter of the property.
+     */
+    fun getter(block: (instance: T) -> V)
+
+    /**
+     * Define the setter of the property. Optional if there is no write on this property.
+     */
+    fun setter(block: (instance: T, value: V) -> Unit)
+}
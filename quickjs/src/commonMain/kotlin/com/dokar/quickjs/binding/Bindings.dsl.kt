@@ -15,7 +15,7 @@ fun QuickJs.define(
 ) {
     val scope = ObjectBindingScopeImpl(typeConverters = typeConverters, name = name)
     scope.block()
-    define(scope, parent = JsObjectHandle.globalThis)
+    defineBindingTree(scope.toBindingTree(this))
 }
 
 /**
@@ -60,7 +60,7 @@ internal inline fun <R : Any?> adaptedCall(
 ): Any? {
     val result = block()
 
-    if (canConvertReturnInternally(result)) {
+    if (canConvertReturnInternally(typeConverters, result)) {
         return result
     }
 
@@ -86,6 +86,11 @@ interface ObjectBindingScope {
      */
     fun <T> property(name: String, block: PropertyScope<T>.() -> Unit)
 
+    /**
+     * Define a read-only property on parent, the [value] is installed as a plain data property.
+     */
+    fun constant(name: String, value: Any?)
+
     /**
      * Define a function on parent.
      */
@@ -113,6 +118,13 @@ interface PropertyScope<T> {
      */
     var enumerable: Boolean
 
+    /**
+     * Make the property read-only. If [snapshot] is true, the getter is called once when
+     * defining and the value is installed as a plain data property, later reads don't call
+     * the getter.
+     */
+    fun readOnly(snapshot: Boolean = false)
+
     /**
      * Define the getter of the property.
      */
@@ -123,22 +135,3 @@ interface PropertyScope<T> {
      */
     fun setter(block: (value: T) -> Unit)
 }
-
-private fun QuickJs.define(
-    scope: ObjectBindingScopeImpl,
-    parent: JsObjectHandle,
-): JsObjectHandle {
-    val binding = DslObjectBinding(scope, this)
-
-    val handle = defineBinding(
-        name = scope.name,
-        binding = binding,
-        parent = parent,
-    )
-
-    for (sub in scope.subScopes) {
-        define(scope = sub, parent = handle)
-    }
-
-    return handle
-}
@@ -172,7 +172,7 @@ private inline fun <T : Any?, R : Any?> callWithTypedArg(
     @Suppress("UNCHECKED_CAST")
     val result = block(typedArg as T)
 
-    if (canConvertReturnInternally(result)) {
+    if (canConvertReturnInternally(typeConverters, result)) {
         return result
     }
 
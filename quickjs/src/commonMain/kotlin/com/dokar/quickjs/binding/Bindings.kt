@@ -13,6 +13,17 @@ interface ObjectBinding : Binding {
 
     val functions: List<JsFunction>
 
+    /**
+     * Bindings with the same key share one prototype which holds their accessors and functions,
+     * the prototype is created by the first binding with the key, so these bindings must have
+     * the same members. Shared members look up the binding from 'this', so they can't be called
+     * detached from their objects.
+     *
+     * Null to define members on the object itself.
+     */
+    val prototypeKey: String?
+        get() = null
+
     fun getter(name: String): Any?
 
     fun setter(name: String, value: Any?)
@@ -33,3 +44,20 @@ fun interface FunctionBinding<R> : Binding {
 fun interface AsyncFunctionBinding<R> : Binding {
     suspend fun invoke(args: Array<Any?>): R
 }
+
+/**
+ * The JavaScript class binding of the host type [T]. Accessors and functions are defined once
+ * on the class prototype, and every [T] object passed to JavaScript becomes an instance of the
+ * class, which only holds a reference to the host object.
+ */
+interface ClassBinding<T : Any> {
+    val properties: List<JsProperty>
+
+    val functions: List<JsFunction>
+
+    fun getter(instance: T, name: String): Any?
+
+    fun setter(instance: T, name: String, value: Any?)
+
+    fun invoke(instance: T, name: String, args: Array<Any?>): Any?
+}
@@ -0,0 +1,105 @@
+package com.dokar.quickjs.binding
+
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.converter.canConvertReturnInternally
+import com.dokar.quickjs.converter.typeOfInstance
+import com.dokar.quickjs.qjsError
+import kotlin.reflect.typeOf
+
+internal class DslClassBinding<T : Any>(
+    private val scope: ClassBindingScopeImpl<T>,
+    private val quickJs: QuickJs,
+) : ClassBinding<T> {
+    private val propertiesDef = scope.properties.associateBy { it.name }
+    private val functionsDef = scope.functions.associateBy { it.name }
+
+    override val properties: List<JsProperty> = scope.properties.map {
+        JsProperty(
+            name = it.name,
+            configurable = it.configurable,
+            writable = it.writable ?: (it.setter != null),
+            enumerable = it.enumerable,
+        )
+    }
+
+    override val functions: List<JsFunction> = scope.functions.map {
+        JsFunction(name = it.name, isAsync = false)
+    }
+
+    override fun getter(instance: T, name: String): Any? {
+        val prop = propertiesDef[name]
+            ?: qjsError("Property '$name' not found on class '${scope.name}'")
+        val propGetter = prop.getter ?: qjsError("The getter of property '$name' is null")
+        return convertResult(propGetter(instance))
+    }
+
+    override fun setter(instance: T, name: String, value: Any?) {
+        val prop = propertiesDef[name]
+            ?: qjsError("Property '$name' not found on class '${scope.name}'")
+        val propSetter = prop.setter ?: qjsError("The setter of property '$name' is null")
+        propSetter(instance, value)
+    }
+
+    override fun invoke(instance: T, name: String, args: Array<Any?>): Any? {
+        val func = functionsDef[name]
+            ?: qjsError("Function '$name' not found on class '${scope.name}'")
+        return convertResult(func.call(instance, args))
+    }
+
+    private fun convertResult(result: Any?): Any? {
+        val typeConverters = quickJs.typeConverters
+        if (canConvertReturnInternally(typeConverters, result)) {
+            return result
+        }
+        // Convert result to JsObject
+        return typeConverters.convert<Any?, JsObject>(
+            source = result,
+            sourceType = typeOfInstance(typeConverters, result),
+            targetType = typeOf<JsObject>(),
+        )
+    }
+}
+
+internal class ClassBindingScopeImpl<T : Any>(
+    val name: String,
+) : ClassBindingScope<T> {
+    val properties = mutableListOf<DslClassProperty<T, *>>()
+
+    val functions = mutableListOf<DslClassFunction<T>>()
+
+    override fun <V> property(name: String, block: ClassPropertyScope<T, V>.() -> Unit) {
+        val prop = DslClassProperty<T, V>(name = name).also(block)
+        if (prop.getter == null) {
+            qjsError("property($name) requires a getter {}.")
+        }
+        properties.add(prop)
+    }
+
+    override fun <R> function(name: String, block: (instance: T, args: Array<Any?>) -> R) {
+        functions.add(DslClassFunction(name = name, call = block))
+    }
+}
+
+internal class DslClassProperty<T : Any, V>(
+    val name: String,
+    override var configurable: Boolean = true,
+    override var writable: Boolean? = null,
+    override var enumerable: Boolean = true,
+) : ClassPropertyScope<T, V> {
+    var getter: ((T) -> Any?)? = null
+    var setter: ((T, Any?) -> Unit)? = null
+
+    override fun getter(block: (instance: T) -> V) {
+        this.getter = { block(it) }
+    }
+
+    @Suppress("unchecked_cast")
+    override fun setter(block: (instance: T, value: V) -> Unit) {
+        this.setter = { instance, value -> block(instance, value as V) }
+    }
+}
+
+internal class DslClassFunction<T : Any>(
+    val name: String,
+    val call: (instance: T, args: Array<Any?>) -> Any?,
+)
@@ -41,12 +41,12 @@ internal class DslObjectBinding(
             is ObjectBinding -> qjsError("Object cannot be invoked!")
         }
 
-        if (canConvertReturnInternally(result)) {
+        val typeConverters = quickJs.typeConverters
+        if (canConvertReturnInternally(typeConverters, result)) {
             return result
         }
 
         // Convert result to JsObject
-        val typeConverters = quickJs.typeConverters
         return typeConverters.convert<Any?, JsObject>(
             source = result,
             sourceType = typeOfInstance(typeConverters, result),
@@ -56,12 +56,24 @@ internal class DslObjectBinding(
 }
 
 private fun List<DslProperty<*>>.toJsProperties(): List<JsProperty> = map {
-    JsProperty(
-        name = it.name,
-        configurable = it.configurable,
-        writable = it.writable ?: (it.setter != null),
-        enumerable = it.enumerable,
-    )
+    if (it.snapshot) {
+        // Snapshots are taken when defining
+        JsProperty(
+            name = it.name,
+            configurable = it.configurable,
+            writable = false,
+            enumerable = it.enumerable,
+            isConstant = true,
+            value = it.getter!!.invoke(),
+        )
+    } else {
+        JsProperty(
+            name = it.name,
+            configurable = it.configurable,
+            writable = it.writable ?: (it.setter != null),
+            enumerable = it.enumerable,
+        )
+    }
 }
 
 private fun List<DslFunction>.toJsFunctions(): List<JsFunction> = map {
@@ -96,9 +108,21 @@ internal class ObjectBindingScopeImpl(
         if (prop.getter == null) {
             qjsError("property($name) requires a getter {}.")
         }
+        if (prop.snapshot && prop.setter != null) {
+            qjsError("property($name) is a snapshot and can't have a setter {}.")
+        }
         properties.add(prop)
     }
 
+    override fun constant(name: String, value: Any?) {
+        properties.add(
+            DslProperty<Any?>(name = name, writable = false).also {
+                it.snapshot = true
+                it.getter = { value }
+            }
+        )
+    }
+
     override fun <R> function(name: String, block: FunctionBinding<R>) {
         functions.add(DslFunction(name = name, call = block))
     }
@@ -116,6 +140,12 @@ internal class DslProperty<T>(
 ) : PropertyScope<T> {
     var getter: (() -> Any?)? = null
     var setter: ((Any?) -> Unit)? = null
+    var snapshot: Boolean = false
+
+    override fun readOnly(snapshot: Boolean) {
+        this.writable = false
+        this.snapshot = snapshot
+    }
 
     override fun getter(block: () -> T) {
         this.getter = { block() as Any }
@@ -0,0 +1,129 @@
+package com.dokar.quickjs.binding
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.converter.canConvertReturnInternally
+import com.dokar.quickjs.converter.castValueOr
+import com.dokar.quickjs.converter.safeCastToByteOrThrow
+import com.dokar.quickjs.converter.safeCastToFloatOrThrow
+import com.dokar.quickjs.converter.safeCastToIntOrThrow
+import com.dokar.quickjs.converter.safeCastToShortOrThrow
+import com.dokar.quickjs.converter.typeOfInstance
+import com.dokar.quickjs.qjsError
+import kotlin.reflect.KType
+import kotlin.reflect.typeOf
+
+/**
+ * Generate an [ObjectBinding] for the class with the 'quickjs-kt-binding-ksp' processor, it
+ * uses no reflection, so it works on all targets.
+ *
+ * Public properties become JS properties, mutable ones are writable. Public functions become
+ * JS functions, suspend functions become async functions. For class 'Console', the processor
+ * generates 'ConsoleBinding' and the 'QuickJs.defineConsole(name, instance)' extension.
+ */
+@Target(AnnotationTarget.CLASS)
+@Retention(AnnotationRetention.SOURCE)
+annotation class JsBinding
+
+/**
+ * Exclude a property or a function from the generated binding of a [JsBinding] class.
+ */
+@Target(AnnotationTarget.PROPERTY, AnnotationTarget.FUNCTION)
+@Retention(AnnotationRetention.SOURCE)
+annotation class JsIgnore
+
+/**
+ * The base class of bindings generated for [JsBinding] classes, not intended to be extended
+ * by hand.
+ */
+@ExperimentalQuickJsApi
+abstract class GeneratedObjectBinding(
+    private val quickJs: QuickJs,
+    private val objectName: String,
+    sharedPrototype: Boolean = false,
+) : ObjectBinding {
+    /**
+     * Bindings of the same generated class share one prototype if [sharedPrototype] is true.
+     */
+    override val prototypeKey: String? =
+        if (sharedPrototype) this::class.qualifiedName else null
+
+    /**
+     * Decode an argument or a setter value to the [type].
+     */
+    protected fun <T> arg(memberName: String, value: Any?, type: KType): T {
+        if (value == null) {
+            if (!type.isMarkedNullable) {
+                qjsError("'$objectName.$memberName' requires a non-null value but null was passed.")
+            }
+            @Suppress("UNCHECKED_CAST")
+            return null as T
+        }
+        return castValueOr(value, type) {
+            val typeConverters = quickJs.typeConverters
+            typeConverters.convert(
+                source = it,
+                sourceType = typeOfInstance(typeConverters, it),
+                targetType = type,
+            )
+        }
+    }
+
+    // Narrow numbers passed by the bridge, generated code casts them directly and only
+    // falls back to arg() for other values.
+    protected fun intArg(value: Long): Int = safeCastToIntOrThrow(value)
+
+    protected fun shortArg(value: Long): Short = safeCastToShortOrThrow(value)
+
+    protected fun byteArg(value: Long): Byte = safeCastToByteOrThrow(value)
+
+    protected fun floatArg(value: Double): Float = safeCastToFloatOrThrow(value)
+
+    /**
+     * Convert a value which is not supported by the bridge with type converters.
+     */
+    protected fun result(value: Any?): Any? {
+        val typeConverters = quickJs.typeConverters
+        if (canConvertReturnInternally(typeConverters, value)) {
+            return value
+        }
+        return typeConverters.convert<Any?, JsObject>(
+            source = value,
+            sourceType = typeOfInstance(typeConverters, value),
+            targetType = typeOf<JsObject>(),
+        )
+    }
+
+    protected fun checkArgCount(functionName: String, args: Array<Any?>, count: Int) {
+        if (args.size != count) {
+            qjsError(
+                "Parameter count mismatched on function '$objectName.$functionName', " +
+                        "js: ${args.size}, kotlin: $count"
+            )
+        }
+    }
+
+    /**
+     * Launch the call of a suspend function, [block] receives arguments without the promise
+     * handles.
+     */
+    protected fun launchAsync(
+        args: Array<Any?>,
+        block: suspend (args: Array<Any?>) -> Any?,
+    ): Any? {
+        quickJs.invokeAsyncFunction(args, block)
+        return null
+    }
+
+    protected fun propertyNotFound(name: String): Nothing {
+        qjsError("Property '$name' not found on object '$objectName'")
+    }
+
+    protected fun propertyNotWritable(name: String): Nothing {
+        qjsError("Property '$name' of object '$objectName' is not writable")
+    }
+
+    protected fun functionNotFound(name: String): Nothing {
+        qjsError("Function '$name' not found on object '$objectName'")
+    }
+}
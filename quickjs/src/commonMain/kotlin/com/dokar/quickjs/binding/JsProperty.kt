@@ -2,10 +2,16 @@ package com.dokar.quickjs.binding
 
 /**
  * Properties of a JavaScript property.
+ *
+ * A constant property is defined as a plain data property with the [value], so reads never
+ * leave the engine and the getter and setter of the binding are not called. Writes to a
+ * writable constant only change the JavaScript value. Class bindings don't support constants.
  */
 class JsProperty(
     val name: String,
     val configurable: Boolean,
     val writable: Boolean,
     val enumerable: Boolean,
+    val isConstant: Boolean = false,
+    val value: Any? = null,
 )
\ No newline at end of file
@@ -0,0 +1,29 @@
+package com.dokar.quickjs.binding
+
+import com.dokar.quickjs.util.withLockSync
+import kotlinx.coroutines.sync.Mutex
+
+/**
+ * Object bindings by their native handles. Bindings are removed by object finalizers, which run
+ * on whichever thread triggers the GC, so every access is locked.
+ */
+internal class ObjectBindings {
+    private val lock = Mutex()
+    private val bindings = mutableMapOf<Long, ObjectBinding>()
+
+    operator fun get(handle: Long): ObjectBinding? = lock.withLockSync { bindings[handle] }
+
+    operator fun set(handle: Long, binding: ObjectBinding) {
+        lock.withLockSync { bindings[handle] = binding }
+    }
+
+    operator fun contains(handle: Long): Boolean = lock.withLockSync { handle in bindings }
+
+    fun remove(handle: Long): ObjectBinding? = lock.withLockSync { bindings.remove(handle) }
+
+    fun handles(): List<Long> = lock.withLockSync { bindings.keys.toList() }
+
+    fun clear() {
+        lock.withLockSync { bindings.clear() }
+    }
+}
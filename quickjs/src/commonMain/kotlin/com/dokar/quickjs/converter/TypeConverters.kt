@@ -1,6 +1,7 @@
 package com.dokar.quickjs.converter
 
 import com.dokar.quickjs.qjsError
+import kotlin.concurrent.Volatile
 import kotlin.reflect.KClass
 import kotlin.reflect.KType
 
@@ -8,6 +9,11 @@ import kotlin.reflect.KType
 internal class TypeConverters {
     private val converters = mutableListOf<TypeConverter<*, *>>()
     private val classTypeMap = mutableMapOf<KClass<*>, KType>()
+    private val hostClasses = mutableListOf<KClass<*>>()
+    // Whether objects of an exact class are host objects, resolved once per class. It's copied
+    // on write since conversions can run on any thread.
+    @Volatile
+    private var hostObjectClasses = emptyMap<KClass<*>, Boolean>()
 
     fun addConverters(vararg serializers: TypeConverter<*, *>) {
         this.converters.addAll(serializers)
@@ -21,6 +27,24 @@ internal class TypeConverters {
         return classTypeMap[cls]
     }
 
+    /**
+     * Add a class defined by 'QuickJs.defineClass()', its objects are passed to the bridge as is.
+     */
+    fun addHostClass(cls: KClass<*>) {
+        hostClasses.add(cls)
+        // Cached classes may be subclasses of the new class
+        hostObjectClasses = emptyMap()
+    }
+
+    fun isHostObject(instance: Any): Boolean {
+        if (hostClasses.isEmpty()) return false
+        val cls = instance::class
+        hostObjectClasses[cls]?.let { return it }
+        val isHostObject = hostClasses.any { it.isInstance(instance) }
+        hostObjectClasses = hostObjectClasses + (cls to isHostObject)
+        return isHostObject
+    }
+
     @Suppress("UNCHECKED_CAST")
     fun <S : Any?, T : Any?> convert(source: S, sourceType: KType, targetType: KType): T {
         if (sourceType == targetType) {
@@ -17,6 +17,20 @@ internal fun canConvertReturnInternally(instance: Any?): Boolean {
     return typeOfInstance(instance) != null
 }
 
+/**
+ * Like [canConvertReturnInternally], objects of classes defined by 'QuickJs.defineClass()' are
+ * also converted by the bridge.
+ */
+@OptIn(ExperimentalContracts::class)
+@PublishedApi
+internal fun canConvertReturnInternally(typeConverters: TypeConverters, instance: Any?): Boolean {
+    contract {
+        returns(false) implies (instance != null)
+    }
+    instance ?: return true
+    return typeOfInstance(instance) != null || typeConverters.isHostObject(instance)
+}
+
 @OptIn(ExperimentalUnsignedTypes::class)
 @PublishedApi
 internal fun typeOfClass(typeConverters: TypeConverters, cls: KClass<*>): KType {
@@ -0,0 +1,45 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.AtomTemplate
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.define
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class, ExperimentalStdlibApi::class)
+class AtomTemplateTest {
+    @Test
+    fun internTemplateNames() = runTest {
+        val dispatcher = coroutineContext[CoroutineDispatcher]!!
+        val template = AtomTemplate.Builder()
+            .add("app", "name", "version", "launch")
+            .add("quickJsAtomTemplateTestKey")
+            .build()
+        val plain = QuickJs.create(dispatcher)
+        val pooled = QuickJs.create(dispatcher, template)
+        try {
+            assertTrue(pooled.memoryUsage.atomCount > plain.memoryUsage.atomCount)
+
+            pooled.define("app") {
+                property("name") { getter { "My App" } }
+            }
+            assertEquals("My App", pooled.evaluate("app.name"))
+        } finally {
+            plain.close()
+            pooled.close()
+        }
+    }
+
+    @Test
+    fun buildTemplate() {
+        val template = AtomTemplate.Builder()
+            .add("app", "name")
+            .addAll(listOf("name", "version"))
+            .build()
+        assertEquals(3, template.size)
+    }
+}
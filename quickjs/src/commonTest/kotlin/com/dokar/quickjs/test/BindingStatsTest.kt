@@ -0,0 +1,79 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.BindingCallType
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.binding.function
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class BindingStatsTest {
+    @Test
+    fun recordCallsWhenEnabled() = runTest {
+        quickJs {
+            var name = "Unnamed"
+            define("app") {
+                property("name") {
+                    getter { name }
+                    setter { name = it }
+                }
+                function("launch") {}
+            }
+            function("add") { it.size }
+
+            evaluate<Any?>("app.launch()")
+            assertTrue(bindingStats().isEmpty())
+
+            isBindingStatsEnabled = true
+            evaluate<Any?>(
+                """
+                    app.name = app.name + "!";
+                    app.launch();
+                    app.launch();
+                    add(1, 2);
+                """.trimIndent()
+            )
+
+            val stats = bindingStats().associateBy { it.name to it.callType }
+            assertEquals(1, stats.getValue("app.name" to BindingCallType.Getter).callCount)
+            assertEquals(1, stats.getValue("app.name" to BindingCallType.Setter).callCount)
+            assertEquals(2, stats.getValue("app.launch" to BindingCallType.Function).callCount)
+            val add = stats.getValue("add" to BindingCallType.Function)
+            assertEquals(1, add.hostExecution.count)
+            assertTrue(add.hostExecution.valueAtPercentile(50.0) <= add.hostExecution.maxNanos)
+        }
+    }
+
+    @Test
+    fun shareSlotsOfRedefinedMembers() = runTest {
+        quickJs {
+            isBindingStatsEnabled = true
+            repeat(2) {
+                define("app") {
+                    function("launch") {}
+                }
+                evaluate<Any?>("app.launch()")
+            }
+            val stats = bindingStats().single()
+            assertEquals("app.launch", stats.name)
+            assertEquals(2, stats.callCount)
+        }
+    }
+
+    @Test
+    fun recordErrors() = runTest {
+        quickJs {
+            isBindingStatsEnabled = true
+            function("fail") { error("Failed") }
+            assertFails { evaluate<Any?>("fail()") }
+            val stats = bindingStats().single()
+            assertEquals(1, stats.callCount)
+            assertEquals(1, stats.errorCount)
+        }
+    }
+}
@@ -1,11 +1,15 @@
 package com.dokar.quickjs.test
 
+import com.dokar.quickjs.binding.JsFunction
+import com.dokar.quickjs.binding.JsProperty
+import com.dokar.quickjs.binding.ObjectBinding
 import com.dokar.quickjs.binding.define
 import com.dokar.quickjs.binding.function
 import com.dokar.quickjs.quickJs
 import kotlinx.coroutines.test.runTest
 import kotlin.test.Test
 import kotlin.test.assertEquals
+import kotlin.test.assertFails
 import kotlin.test.assertTrue
 
 class BindingTest {
@@ -95,4 +99,44 @@ class BindingTest {
         assertEquals(2, launchCount)
         assertEquals("My App", name)
     }
-}
\ No newline at end of file
+
+    @Test
+    fun bindObjectCanBeCollected() = runTest {
+        quickJs {
+            define("cache") {
+                function("get") { "value" }
+            }
+            assertEquals("value", evaluate("cache.get()"))
+            evaluate<Any?>("delete globalThis.cache")
+            gc()
+            assertEquals("undefined", evaluate("typeof cache"))
+            // Define again after the old one is collected
+            define("cache") {
+                function("get") { "new value" }
+            }
+            assertEquals("new value", evaluate("cache.get()"))
+        }
+    }
+
+    @Test
+    fun defineOnCollectedParent() = runTest {
+        quickJs {
+            val handle = defineBinding("parent", EmptyObjectBinding)
+            evaluate<Any?>("delete globalThis.parent")
+            gc()
+            assertFails { defineBinding("child", EmptyObjectBinding, parent = handle) }
+        }
+    }
+
+    private object EmptyObjectBinding : ObjectBinding {
+        override val properties: List<JsProperty> = emptyList()
+
+        override val functions: List<JsFunction> = emptyList()
+
+        override fun getter(name: String): Any? = null
+
+        override fun setter(name: String, value: Any?) {}
+
+        override fun invoke(name: String, args: Array<Any?>): Any? = null
+    }
+}
@@ -0,0 +1,83 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+
+class BindingTreeTest {
+    @Test
+    fun defineNestedObjects() = runTest {
+        quickJs {
+            var count = 0L
+            define("host") {
+                constant("version", "1.0.0")
+                define("storage") {
+                    define("local") {
+                        property<Long>("count") {
+                            getter { count }
+                            setter { count = it }
+                        }
+                        function("clear") { count = 0L }
+                    }
+                    define("session") {
+                        function("id") { "session" }
+                    }
+                }
+                define("ui") {
+                    asyncFunction("show") { "shown" }
+                }
+            }
+
+            assertEquals("1.0.0", evaluate("host.version"))
+            evaluate<Any?>("host.storage.local.count = 3")
+            assertEquals(3L, count)
+            assertEquals(3L, evaluate("host.storage.local.count"))
+            evaluate<Any?>("host.storage.local.clear()")
+            assertEquals(0L, count)
+            assertEquals("session", evaluate("host.storage.session.id()"))
+            assertEquals("shown", evaluate("await host.ui.show()"))
+        }
+    }
+
+    @Test
+    fun defineManyObjects() = runTest {
+        quickJs {
+            define("host") {
+                repeat(80) { index ->
+                    define("object$index") {
+                        function("index") { index }
+                    }
+                }
+            }
+
+            assertEquals(80L, evaluate("Object.keys(host).length"))
+            assertTrue(evaluate("host.object79.index() === 79"))
+        }
+    }
+
+    @Test
+    fun defineNothingOnFailure() = runTest {
+        quickJs {
+            assertFails {
+                define("host") {
+                    define("first") {
+                        function("ping") { "pong" }
+                    }
+                    define("second") {
+                        constant("unsupported", Any())
+                    }
+                }
+            }
+            assertTrue(evaluate("typeof host === 'undefined'"))
+
+            define("host") {
+                function("ping") { "pong" }
+            }
+            assertEquals("pong", evaluate("host.ping()"))
+        }
+    }
+}
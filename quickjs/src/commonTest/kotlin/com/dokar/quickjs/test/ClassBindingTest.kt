@@ -0,0 +1,98 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.defineClass
+import com.dokar.quickjs.binding.function
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class ClassBindingTest {
+    @Test
+    fun accessInstances() = runTest {
+        quickJs {
+            defineItemClass()
+            val item = Item(name = "Pen", price = 2, count = 3)
+            function("item") { item }
+
+            assertEquals("Pen", evaluate("item().name"))
+            assertEquals(6L, evaluate("item().total()"))
+            evaluate<Any?>("item().count = 5")
+            assertEquals(5L, item.count)
+            evaluate<Any?>("item().name = 'Book'")
+            assertEquals("Pen", evaluate("item().name"))
+        }
+    }
+
+    @Test
+    fun returnInstanceList() = runTest {
+        quickJs {
+            defineItemClass()
+            val items = listOf(Item("Pen", 2, 3), Item("Book", 10, 1))
+            function("items") { items }
+
+            assertEquals(16L, evaluate("items().reduce((sum, it) => sum + it.total(), 0)"))
+            assertTrue(evaluate("items().every((it) => it instanceof Item)"))
+            assertTrue(evaluate("Object.getPrototypeOf(items()[0]) === Item.prototype"))
+        }
+    }
+
+    @Test
+    fun passInstancesBack() = runTest {
+        quickJs {
+            defineItemClass()
+            val item = Item(name = "Pen", price = 2, count = 3)
+            function("item") { item }
+            function<Item, String>("describe") { "${it.name} x ${it.count}" }
+
+            assertEquals("Pen x 3", evaluate("describe(item())"))
+            assertSame(item, evaluate<Item>("item()"))
+        }
+    }
+
+    @Test
+    fun callConstructor() = runTest {
+        quickJs {
+            defineItemClass()
+
+            assertFails { evaluate<Any?>("new Item()") }
+        }
+    }
+
+    @Test
+    fun callWithIllegalReceiver() = runTest {
+        quickJs {
+            defineItemClass()
+            function("item") { Item(name = "Pen", price = 2, count = 3) }
+
+            assertFails { evaluate<Any?>("Item.prototype.total.call({})") }
+            assertFails { evaluate<Any?>("Object.create(Item.prototype).name") }
+            assertEquals(6L, evaluate("Item.prototype.total.call(item())"))
+        }
+    }
+
+    private fun QuickJs.defineItemClass() {
+        defineClass<Item>("Item") {
+            property<String>("name") {
+                getter { it.name }
+            }
+            property<Long>("count") {
+                getter { it.count }
+                setter { item, value -> item.count = value }
+            }
+            function("total") { item, _ -> item.price * item.count }
+        }
+    }
+
+    private class Item(
+        val name: String,
+        val price: Long,
+        var count: Long,
+    )
+}
@@ -0,0 +1,75 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+
+class ConstantPropertyTest {
+    @Test
+    fun defineConstants() = runTest {
+        quickJs {
+            define("config") {
+                constant("version", "1.0.0")
+                constant("retries", 3)
+                constant("tags", listOf("a", "b"))
+                constant("empty", null)
+            }
+
+            assertEquals("1.0.0", evaluate("config.version"))
+            assertEquals(3L, evaluate("config.retries"))
+            assertEquals("a,b", evaluate("config.tags.join(',')"))
+            assertTrue(evaluate("config.empty === null"))
+            assertTrue(
+                evaluate("Object.getOwnPropertyDescriptor(config, 'version').get === undefined")
+            )
+            // Scripts are not strict, writing a read-only property is ignored
+            evaluate<Any?>("config.version = '2.0.0'")
+            assertEquals("1.0.0", evaluate("config.version"))
+        }
+    }
+
+    @Test
+    fun snapshotProperties() = runTest {
+        quickJs {
+            var reads = 0
+            define("app") {
+                property<String>("name") {
+                    readOnly(snapshot = true)
+                    getter {
+                        reads++
+                        "app"
+                    }
+                }
+                property<Int>("reads") {
+                    readOnly()
+                    getter { reads }
+                }
+            }
+
+            assertEquals(1, reads)
+            assertEquals("appappapp", evaluate("app.name + app.name + app.name"))
+            assertEquals(1, reads)
+            assertEquals(1L, evaluate("app.reads"))
+            assertTrue(evaluate("Object.getOwnPropertyDescriptor(app, 'name').writable === false"))
+        }
+    }
+
+    @Test
+    fun snapshotWithSetter() = runTest {
+        quickJs {
+            assertFails {
+                define("app") {
+                    property<String>("name") {
+                        readOnly(snapshot = true)
+                        getter { "app" }
+                        setter {}
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class CpuProfileTest {
+    @Test
+    fun sampleJsStacks() = runTest {
+        quickJs {
+            startCpuProfiling(samplingIntervalMicros = 200)
+            evaluate<Any?>(
+                """
+                    function busyLoop() {
+                        const start = Date.now();
+                        let sum = 0;
+                        while (Date.now() - start < 200) sum += Math.sqrt(sum + 1);
+                        return sum;
+                    }
+                    busyLoop();
+                """.trimIndent()
+            )
+            val profile = stopCpuProfiling()
+            assertTrue(profile.sampleCount > 0)
+            assertTrue(profile.samples.any { sample -> sample.frames.any { "busyLoop" in it } })
+            val collapsed = profile.toCollapsedStacks()
+            assertEquals(profile.samples.size, collapsed.lines().count { it.isNotEmpty() })
+        }
+    }
+
+    @Test
+    fun truncateDeepStacks() = runTest {
+        quickJs {
+            startCpuProfiling(samplingIntervalMicros = 200)
+            evaluate<Any?>(
+                """
+                    function busyLoop() {
+                        const start = Date.now();
+                        let sum = 0;
+                        while (Date.now() - start < 200) sum += Math.sqrt(sum + 1);
+                        return sum;
+                    }
+                    function recurse(depth) {
+                        const result = depth === 0 ? busyLoop() : recurse(depth - 1);
+                        return result;
+                    }
+                    recurse(300);
+                """.trimIndent()
+            )
+            val profile = stopCpuProfiling()
+            val deepest = profile.samples.maxBy { it.frames.size }
+            assertEquals("...", deepest.frames.first())
+            assertEquals(257, deepest.frames.size)
+            assertTrue(deepest.frames.takeLast(2).any { "busyLoop" in it })
+        }
+    }
+
+    @Test
+    fun noSamplesWhenIdle() = runTest {
+        quickJs {
+            startCpuProfiling(samplingIntervalMicros = 200)
+            val profile = stopCpuProfiling()
+            assertEquals(0, profile.sampleCount)
+        }
+    }
+}
@@ -0,0 +1,26 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class CreationTimingsTest {
+    @Test
+    fun recordCreationSteps() = runTest {
+        quickJs {
+            val timings = creationTimings
+            assertTrue(timings.runtimeNanos > 0)
+            assertTrue(timings.contextNanos > 0)
+            assertTrue(timings.globalsNanos > 0)
+            assertTrue(timings.libraryLoadNanos >= 0)
+            assertEquals(
+                timings.runtimeNanos + timings.contextNanos + timings.globalsNanos,
+                timings.totalNanos,
+            )
+        }
+    }
+}
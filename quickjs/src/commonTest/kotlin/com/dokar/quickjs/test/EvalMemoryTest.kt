@@ -0,0 +1,71 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertFailsWith
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class, ExperimentalStdlibApi::class)
+class EvalMemoryTest {
+    @Test
+    fun reportEvalMemoryStats() = runTest {
+        val dispatcher = coroutineContext[CoroutineDispatcher]!!
+        val quickJs = QuickJs.create(dispatcher, enableMemoryAccounting = true)
+        try {
+            val result = quickJs.evaluateWithMemoryStats<Int>(
+                """
+                    globalThis.items = Array.from({ length: 10000 }, (_, i) => 'item' + i);
+                    items.length
+                """.trimIndent()
+            )
+            assertEquals(10000, result.value)
+            val stats = result.memoryStats
+            assertTrue(stats.allocatedBytes > 0)
+            assertTrue(stats.peakBytes in 1..stats.allocatedBytes)
+
+            val small = quickJs.evaluateWithMemoryStats<Int>("1 + 1").memoryStats
+            assertTrue(small.allocatedBytes < stats.allocatedBytes)
+        } finally {
+            quickJs.close()
+        }
+    }
+
+    @Test
+    fun evalMemoryLimitAbortsOnlyTheEvaluation() = runTest {
+        val dispatcher = coroutineContext[CoroutineDispatcher]!!
+        val quickJs = QuickJs.create(dispatcher, enableMemoryAccounting = true)
+        try {
+            quickJs.evalMemoryLimit = 1024 * 1024L
+            assertFails {
+                quickJs.evaluate<Any?>(
+                    """
+                        const items = [];
+                        for (let i = 0; i < 1e6; i++) items.push('item' + i);
+                    """.trimIndent()
+                )
+            }
+            assertEquals(2, quickJs.evaluate<Int>("1 + 1"))
+        } finally {
+            quickJs.close()
+        }
+    }
+
+    @Test
+    fun requireMemoryAccounting() = runTest {
+        val quickJs = QuickJs.create(coroutineContext[CoroutineDispatcher]!!)
+        try {
+            assertFailsWith<IllegalStateException> { quickJs.evalMemoryLimit = 1024 }
+            assertFailsWith<IllegalStateException> {
+                quickJs.evaluateWithMemoryStats<Int>("1 + 1")
+            }
+            assertEquals(2, quickJs.evaluate<Int>("1 + 1"))
+        } finally {
+            quickJs.close()
+        }
+    }
+}
@@ -0,0 +1,58 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJsTracer
+import com.dokar.quickjs.TracePhase
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class GcStatsTest {
+    @Test
+    fun recordExplicitGc() = runTest {
+        quickJs {
+            val before = gcStats
+            gc()
+            val stats = gcStats
+            assertEquals(before.explicitCount + 1, stats.explicitCount)
+            assertEquals(stats.count, stats.pauses.count)
+            assertTrue(stats.pauses.maxNanos > 0)
+        }
+    }
+
+    @Test
+    fun recordThresholdGc() = runTest {
+        val triggers = mutableListOf<Any?>()
+        quickJs {
+            tracer = object : QuickJsTracer {
+                override fun begin(
+                    phase: TracePhase,
+                    name: String,
+                    attributes: Map<String, Any?>,
+                ): Any? {
+                    if (phase == TracePhase.Gc) triggers.add(attributes["trigger"])
+                    return null
+                }
+
+                override fun end(phase: TracePhase, token: Any?, error: Throwable?) {}
+            }
+            evaluate<Any?>(
+                """
+                    for (let i = 0; i < 200000; i++) {
+                        const a = {};
+                        const b = { a };
+                        a.b = b;
+                    }
+                """.trimIndent()
+            )
+            val stats = gcStats
+            assertTrue(stats.thresholdCount > 0)
+            assertTrue(stats.freedAllocations > 0)
+            assertTrue(stats.reclaimedBytes > 0)
+        }
+        assertTrue("threshold" in triggers)
+    }
+}
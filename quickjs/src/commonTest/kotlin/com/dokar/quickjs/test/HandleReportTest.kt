@@ -0,0 +1,77 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.HandleKind
+import com.dokar.quickjs.HandleSite
+import com.dokar.quickjs.assertHandlesReturnToBaseline
+import com.dokar.quickjs.binding.asyncFunction
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.binding.function
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+
+@OptIn(ExperimentalQuickJsApi::class)
+class HandleReportTest {
+    @Test
+    fun reportBindingSites() = runTest {
+        quickJs {
+            isHandleTrackingEnabled = true
+            define("app") {
+                function("launch") {}
+            }
+            val site = HandleSite(HandleKind.BindingObject, "defineObject", "app")
+            assertEquals(1, handleReport().counts[site])
+        }
+    }
+
+    @Test
+    fun skipGlobalFunctionHolders() = runTest {
+        quickJs {
+            isHandleTrackingEnabled = true
+            function("ping") { "pong" }
+            assertEquals(0, handleReport().countOf(HandleKind.BindingObject))
+        }
+    }
+
+    @Test
+    fun reportAsyncCallSites() = runTest {
+        quickJs {
+            isHandleTrackingEnabled = true
+            asyncFunction("fetch") { "Hello" }
+            assertEquals("Hello", evaluate("await fetch()"))
+            val report = handleReport()
+            val promiseSite = HandleSite(HandleKind.ManagedJsValue, "asyncCall", "fetch")
+            val functionSite = HandleSite(HandleKind.PromiseFunction, "asyncCall", "fetch")
+            assertEquals(1, report.counts[promiseSite])
+            assertEquals(2, report.counts[functionSite])
+        }
+    }
+
+    @Test
+    fun handlesReturnToBaseline() = runTest {
+        quickJs {
+            evaluate<Any?>("1 + 1")
+            assertHandlesReturnToBaseline {
+                define("temp") {
+                    function("get") { "value" }
+                }
+                assertEquals("value", evaluate("temp.get()"))
+                evaluate<Any?>("delete globalThis.temp")
+            }
+        }
+    }
+
+    @Test
+    fun detectGrownHandles() = runTest {
+        quickJs {
+            assertFailsWith<IllegalStateException> {
+                assertHandlesReturnToBaseline {
+                    define("leaked") {}
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,35 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.PropertyAccessKind
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class OpcodeStatsTest {
+    @Test
+    fun countExecutedOpcodes() = runTest {
+        quickJs {
+            // Not available in regular builds
+            opcodeStats() ?: return@quickJs
+            resetOpcodeStats()
+            evaluate<Any?>(
+                """
+                    const obj = { count: 0 };
+                    for (let i = 0; i < 100; i++) obj.count += i;
+                """.trimIndent()
+            )
+            val stats = opcodeStats()!!
+            assertTrue(stats.totalCount > 100)
+            assertTrue(stats.counts.zipWithNext().all { (a, b) -> a.count >= b.count })
+            assertTrue((stats.propertyAccesses[PropertyAccessKind.GetField] ?: 0) >= 100)
+            assertTrue(stats.toReport().startsWith("Opcodes: ${stats.totalCount} executed"))
+
+            resetOpcodeStats()
+            assertEquals(0L, opcodeStats()!!.totalCount)
+        }
+    }
+}
@@ -0,0 +1,106 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.binding.JsFunction
+import com.dokar.quickjs.binding.JsProperty
+import com.dokar.quickjs.binding.ObjectBinding
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+
+class SharedPrototypeTest {
+    @Test
+    fun shareOnePrototype() = runTest {
+        quickJs {
+            defineBinding("first", PointBinding(x = 1, y = 2))
+            defineBinding("second", PointBinding(x = 3, y = 4))
+
+            assertTrue(evaluate("Object.getPrototypeOf(first) === Object.getPrototypeOf(second)"))
+            assertTrue(evaluate("Object.keys(first).length === 0"))
+            assertEquals(3L, evaluate("first.sum()"))
+            assertEquals(7L, evaluate("second.sum()"))
+        }
+    }
+
+    @Test
+    fun writeProperties() = runTest {
+        quickJs {
+            val first = PointBinding(x = 1, y = 2)
+            val second = PointBinding(x = 3, y = 4)
+            defineBinding("first", first)
+            defineBinding("second", second)
+
+            evaluate<Any?>("first.x = 10")
+            assertEquals(10L, first.x)
+            assertEquals(3L, second.x)
+            assertEquals(14L, evaluate("first.sum() + second.x"))
+        }
+    }
+
+    @Test
+    fun callWithIllegalReceiver() = runTest {
+        quickJs {
+            defineBinding("point", PointBinding(x = 1, y = 2))
+
+            assertFails { evaluate<Any?>("const sum = point.sum; sum()") }
+            assertFails { evaluate<Any?>("Object.create(Object.getPrototypeOf(point)).x") }
+            assertEquals(3L, evaluate("Object.getPrototypeOf(point).sum.call(point)"))
+        }
+    }
+
+    @Test
+    fun rejectDifferentMembers() = runTest {
+        quickJs {
+            defineBinding("point", PointBinding(x = 1, y = 2))
+
+            assertFails { defineBinding("size", SizeBinding()) }
+            assertTrue(evaluate("typeof size === 'undefined'"))
+            assertEquals(3L, evaluate("point.sum()"))
+        }
+    }
+
+    private class SizeBinding : ObjectBinding {
+        override val prototypeKey: String = "Point"
+
+        override val properties: List<JsProperty> = listOf(
+            JsProperty(name = "width", configurable = true, writable = false, enumerable = true),
+        )
+
+        override val functions: List<JsFunction> = emptyList()
+
+        override fun getter(name: String): Any? = 0L
+
+        override fun setter(name: String, value: Any?) {}
+
+        override fun invoke(name: String, args: Array<Any?>): Any? = null
+    }
+
+    private class PointBinding(var x: Long, val y: Long) : ObjectBinding {
+        override val prototypeKey: String = "Point"
+
+        override val properties: List<JsProperty> = listOf(
+            JsProperty(name = "x", configurable = true, writable = true, enumerable = true),
+            JsProperty(name = "y", configurable = true, writable = false, enumerable = true),
+        )
+
+        override val functions: List<JsFunction> = listOf(
+            JsFunction(name = "sum", isAsync = false),
+        )
+
+        override fun getter(name: String): Any? = when (name) {
+            "x" -> x
+            "y" -> y
+            else -> null
+        }
+
+        override fun setter(name: String, value: Any?) {
+            if (name == "x") {
+                x = value as Long
+            }
+        }
+
+        override fun invoke(name: String, args: Array<Any?>): Any? = x + y
+    }
+}
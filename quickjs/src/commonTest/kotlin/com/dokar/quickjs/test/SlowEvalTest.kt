@@ -0,0 +1,94 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJsException
+import com.dokar.quickjs.SlowEvalSink
+import com.dokar.quickjs.SlowEvaluation
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.binding.function
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertContains
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class SlowEvalTest {
+    @Test
+    fun logSlowEvaluations() = runTest {
+        val logged = mutableListOf<SlowEvaluation>()
+        quickJs {
+            slowEvalThresholdMillis = 50
+            isSlowEvalBreakdownEnabled = true
+            slowEvalSink = SlowEvalSink { logged.add(it) }
+            define("app") {
+                function("tick") { it.size }
+            }
+            evaluate<Any?>("1 + 1", filename = "fast.js")
+            evaluate<Any?>(
+                """
+                    const start = Date.now();
+                    while (Date.now() - start < 100) app.tick();
+                """.trimIndent(),
+                filename = "slow.js",
+            )
+        }
+        assertEquals(1, logged.size)
+        val evaluation = logged.single()
+        assertEquals("slow.js", evaluation.filename)
+        assertEquals(16, evaluation.sourceHash.length)
+        assertTrue(evaluation.durationNanos >= 50_000_000)
+        assertEquals(
+            evaluation.durationNanos,
+            evaluation.compileNanos + evaluation.runNanos + evaluation.asyncWaitNanos +
+                    evaluation.resultConversionNanos,
+        )
+        assertTrue(evaluation.bindingCallCount > 0)
+        assertEquals("app.tick", evaluation.topBindings.first().name)
+    }
+
+    @Test
+    fun skipBreakdownByDefault() = runTest {
+        val logged = mutableListOf<SlowEvaluation>()
+        quickJs {
+            slowEvalThresholdMillis = 0
+            slowEvalSink = SlowEvalSink { logged.add(it) }
+            define("app") {
+                function("tick") { it.size }
+            }
+            evaluate<Any?>("app.tick()")
+        }
+        val evaluation = logged.single()
+        assertTrue(evaluation.durationNanos >= 0)
+        assertEquals(-1, evaluation.runNanos)
+        assertEquals(-1, evaluation.bindingCallCount)
+        assertTrue(evaluation.topBindings.isEmpty())
+    }
+
+    @Test
+    fun disabledByDefault() = runTest {
+        val logged = mutableListOf<SlowEvaluation>()
+        quickJs {
+            slowEvalSink = SlowEvalSink { logged.add(it) }
+            evaluate<Any?>("const start = Date.now(); while (Date.now() - start < 20) {}")
+        }
+        assertTrue(logged.isEmpty())
+    }
+
+    @Test
+    fun throwSinkFailures() = runTest {
+        quickJs {
+            slowEvalThresholdMillis = 0
+            slowEvalSink = SlowEvalSink { error("Sink failed") }
+            val sinkError = assertFailsWith<IllegalStateException> { evaluate<Any?>("1 + 1") }
+            assertEquals("Sink failed", sinkError.message)
+            val error = assertFailsWith<QuickJsException> {
+                evaluate<Any?>("throw new Error('Script failed')")
+            }
+            assertContains(error.message!!, "Script failed")
+            assertEquals("Sink failed", error.suppressedExceptions.single().message)
+        }
+    }
+}
@@ -0,0 +1,67 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJsTracer
+import com.dokar.quickjs.TracePhase
+import com.dokar.quickjs.binding.define
+import com.dokar.quickjs.binding.function
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertNotNull
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalQuickJsApi::class)
+class TracerTest {
+    @Test
+    fun traceEvalAndBindingCalls() = runTest {
+        val tracer = RecordingTracer()
+        quickJs {
+            this.tracer = tracer
+            define("app") {
+                function("launch") {}
+            }
+            evaluate<Any?>("app.launch()", filename = "launch.js")
+            gc()
+        }
+        val phases = tracer.ended.map { it.first }
+        assertTrue(TracePhase.BindingCall in phases)
+        assertTrue(TracePhase.ExecutePendingJobs in phases)
+        assertEquals(TracePhase.Evaluate, phases[phases.lastIndex - 1])
+        assertEquals(TracePhase.Gc, phases.last())
+        assertEquals("launch.js", tracer.begun.first { it.first == TracePhase.Evaluate }.second)
+        assertEquals(tracer.begun.size, tracer.ended.size)
+    }
+
+    @Test
+    fun traceErrors() = runTest {
+        val tracer = RecordingTracer()
+        quickJs {
+            this.tracer = tracer
+            function("fail") { error("Failed") }
+            assertFails { evaluate<Any?>("fail()") }
+        }
+        val bindingCall = tracer.ended.first { it.first == TracePhase.BindingCall }
+        assertNotNull(bindingCall.second)
+    }
+
+    private class RecordingTracer : QuickJsTracer {
+        val begun = mutableListOf<Pair<TracePhase, String>>()
+        val ended = mutableListOf<Pair<TracePhase, Throwable?>>()
+
+        override fun begin(
+            phase: TracePhase,
+            name: String,
+            attributes: Map<String, Any?>,
+        ): Any? {
+            begun.add(phase to name)
+            return null
+        }
+
+        override fun end(phase: TracePhase, token: Any?, error: Throwable?) {
+            ended.add(phase to error)
+        }
+    }
+}
@@ -2,11 +2,15 @@ package com.dokar.quickjs
 
 import com.dokar.quickjs.binding.AsyncFunctionBinding
 import com.dokar.quickjs.binding.Binding
+import com.dokar.quickjs.binding.BindingTreeNode
+import com.dokar.quickjs.binding.ClassBinding
 import com.dokar.quickjs.binding.FunctionBinding
 import com.dokar.quickjs.binding.JsFunction
 import com.dokar.quickjs.binding.JsObjectHandle
 import com.dokar.quickjs.binding.JsProperty
 import com.dokar.quickjs.binding.ObjectBinding
+import com.dokar.quickjs.binding.ObjectBindings
+import com.dokar.quickjs.binding.encode
 import com.dokar.quickjs.converter.TypeConverter
 import com.dokar.quickjs.converter.TypeConverters
 import com.dokar.quickjs.converter.castValueOr
@@ -23,8 +27,10 @@ import kotlinx.coroutines.launch
 import kotlinx.coroutines.sync.Mutex
 import kotlinx.coroutines.sync.withLock
 import java.io.Closeable
+import kotlin.reflect.KClass
 import kotlin.reflect.KType
 import kotlin.reflect.typeOf
+import kotlin.time.TimeSource
 
 /**
  * Evaluate QuickJS-compiled bytecode.
@@ -128,17 +134,23 @@ suspend fun <T> QuickJs.evaluate(
     }
 }
 
+@OptIn(ExperimentalQuickJsApi::class)
 actual class QuickJs private constructor(
     private val jobDispatcher: CoroutineDispatcher,
+    atomNames: Array<String>? = null,
+    private val isMemoryAccountingEnabled: Boolean = false,
 ) : Closeable {
     // Native pointers
     private var globals: Long = 0
     private var runtime: Long = 0
     private var context: Long = 0
 
-    private val objectBindings = mutableMapOf<Long, ObjectBinding>()
+    private val objectBindings = ObjectBindings()
     private val globalFunctions = mutableMapOf<String, Binding>()
 
+    // Indexed by the class index returned from native
+    private val classBindings = mutableListOf<ClassBinding<Any>>()
+
     private val modules = mutableListOf<ByteArray>()
 
     private var evalException: Throwable? = null
@@ -186,17 +198,144 @@ actual class QuickJs private constructor(
             setMaxStackSize(runtime, globals, value)
         }
 
+    @ExperimentalQuickJsApi
+    actual var creationTimings: CreationTimings = CreationTimings(0, 0, 0, 0)
+        private set
+
     actual val memoryUsage: MemoryUsage
         get() {
             ensureNotClosed()
             return getMemoryUsage(runtime, globals)
         }
 
+    @ExperimentalQuickJsApi
+    actual val gcStats: GcStats
+        get() {
+            ensureNotClosed()
+            return GcStats.fromSnapshot(getGcStats(globals))
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun opcodeStats(): OpcodeStats? {
+        ensureNotClosed()
+        val counts = getOpcodeCounts(runtime, globals) ?: return null
+        return OpcodeStats.fromSnapshot(names = getOpcodeNames(), data = counts)
+    }
+
+    @ExperimentalQuickJsApi
+    actual fun resetOpcodeStats() {
+        ensureNotClosed()
+        resetOpcodeCounts(runtime, globals)
+    }
+
+    @ExperimentalQuickJsApi
+    actual var evalMemoryLimit: Long = -1
+        set(value) {
+            ensureNotClosed()
+            check(value < 0 || isMemoryAccountingEnabled) {
+                "Memory accounting is not enabled for this instance."
+            }
+            field = value
+        }
+
+    @ExperimentalQuickJsApi
+    actual var isHandleTrackingEnabled: Boolean = false
+        set(value) {
+            ensureNotClosed()
+            field = value
+            setHandleTracking(globals, value)
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun handleReport(): HandleReport {
+        ensureNotClosed()
+        val sites = getTrackedHandles(globals).map {
+            val (kind, callType, binding) = it.split('|', limit = 3)
+            HandleSite(HandleKind.valueOf(kind), callType, binding)
+        }
+        return HandleReport.create(
+            kindCounts = getHandleCounts(globals),
+            trackedSites = sites,
+            jsObjectCount = memoryUsage.objCount,
+        )
+    }
+
+    @ExperimentalQuickJsApi
+    actual var isBindingStatsEnabled: Boolean = false
+        set(value) {
+            ensureNotClosed()
+            field = value
+            setBindingStatsEnabled(globals, value)
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun bindingStats(): List<BindingCallStats> {
+        ensureNotClosed()
+        val names = getBindingStatsNames(globals)
+        return BindingCallStats.fromSnapshot(
+            names = names,
+            data = getBindingStats(globals, names.size),
+        )
+    }
+
+    private var cpuProfilingIntervalMicros = 0L
+
+    @ExperimentalQuickJsApi
+    actual var tracer: QuickJsTracer = QuickJsTracer.NoOp
+
+    @ExperimentalQuickJsApi
+    actual var slowEvalThresholdMillis: Long = -1
+        set(value) {
+            ensureNotClosed()
+            field = value
+            updateSlowEvalTracking()
+        }
+
+    @ExperimentalQuickJsApi
+    actual var isSlowEvalBreakdownEnabled: Boolean = false
+        set(value) {
+            ensureNotClosed()
+            field = value
+            updateSlowEvalTracking()
+        }
+
+    @ExperimentalQuickJsApi
+    actual var slowEvalSink: SlowEvalSink? = null
+        set(value) {
+            ensureNotClosed()
+            field = value
+            updateSlowEvalTracking()
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun startCpuProfiling(samplingIntervalMicros: Long) {
+        ensureNotClosed()
+        require(samplingIntervalMicros > 0) { "Sampling interval must be positive." }
+        startProfiling(context, globals, samplingIntervalMicros)
+        cpuProfilingIntervalMicros = samplingIntervalMicros
+    }
+
+    @ExperimentalQuickJsApi
+    actual fun stopCpuProfiling(): CpuProfile {
+        ensureNotClosed()
+        return CpuProfile.fromCollapsedStacks(
+            text = stopProfiling(globals),
+            samplingIntervalMicros = cpuProfilingIntervalMicros,
+        )
+    }
+
     init {
         try {
-            runtime = newRuntime()
+            val timer = CreationTimer()
+            runtime = newRuntime(isMemoryAccountingEnabled)
+            timer.lap()
             context = newContext(runtime)
+            timer.lap()
             globals = initGlobals(runtime)
+            if (atomNames != null) {
+                internAtoms(context, globals, atomNames)
+            }
+            creationTimings = timer.finish(libraryLoadNanos = libraryLoadNanos)
         } catch (e: QuickJsException) {
             close()
             throw e
@@ -220,6 +359,7 @@ actual class QuickJs private constructor(
             name = name,
             properties = binding.properties.toTypedArray(),
             functions = binding.functions.toTypedArray(),
+            prototypeKey = binding.prototypeKey,
         )
         if (nativeHandle < 0L) {
             throw QuickJsException("Failed to define object '$name'.")
@@ -228,6 +368,24 @@ actual class QuickJs private constructor(
         return JsObjectHandle(nativeHandle)
     }
 
+    internal actual fun defineBindingTree(nodes: List<BindingTreeNode>): List<JsObjectHandle> {
+        ensureNotClosed()
+        val tree = nodes.encode()
+        val handles = LongArray(nodes.size)
+        defineObjectTree(
+            globals = globals,
+            context = context,
+            parent = JsObjectHandle.globalThis.nativeHandle,
+            tree = tree.bytes,
+            values = tree.values,
+            handles = handles,
+        )
+        return nodes.mapIndexed { index, node ->
+            objectBindings[handles[index]] = node.binding
+            JsObjectHandle(handles[index])
+        }
+    }
+
     actual fun <R> defineBinding(name: String, binding: FunctionBinding<R>) {
         ensureNotClosed()
         globalFunctions[name] = binding
@@ -250,6 +408,33 @@ actual class QuickJs private constructor(
         )
     }
 
+    @ExperimentalQuickJsApi
+    actual fun <T : Any> defineClass(
+        name: String,
+        type: KClass<T>,
+        binding: ClassBinding<T>,
+    ) {
+        ensureNotClosed()
+        if (binding.functions.any { it.isAsync }) {
+            qjsError("Async functions are not supported by the class binding '$name'.")
+        }
+        if (binding.properties.any { it.isConstant }) {
+            qjsError("Constant properties are not supported by the class binding '$name'.")
+        }
+        val classIndex = defineClass(
+            globals = globals,
+            context = context,
+            cls = type.java,
+            name = name,
+            properties = binding.properties.toTypedArray(),
+            functions = binding.functions.toTypedArray(),
+        )
+        check(classIndex == classBindings.size) { "Unexpected class index: $classIndex" }
+        @Suppress("UNCHECKED_CAST")
+        classBindings.add(binding as ClassBinding<Any>)
+        typeConverters.addHostClass(type)
+    }
+
     @Throws(QuickJsException::class)
     actual fun addModule(name: String, code: String) {
         ensureNotClosed()
@@ -265,8 +450,12 @@ actual class QuickJs private constructor(
     @Throws(QuickJsException::class)
     actual fun compile(code: String, filename: String, asModule: Boolean): ByteArray {
         ensureNotClosed()
-        jsMutex.withLockSync {
-            return compile(context, globals, filename, code, asModule)
+        return tracer.trace(
+            phase = TracePhase.Compile,
+            name = filename,
+            attributes = { mapOf("asModule" to asModule, "codeLength" to code.length) },
+        ) {
+            jsMutex.withLockSync { compile(context, globals, filename, code, asModule) }
         }
     }
 
@@ -296,9 +485,39 @@ actual class QuickJs private constructor(
         }
     }
 
+    @ExperimentalQuickJsApi
+    @Throws(QuickJsException::class, CancellationException::class)
+    actual suspend inline fun <reified T> evaluateWithMemoryStats(
+        code: String,
+        filename: String,
+        asModule: Boolean
+    ): EvalMemoryResult<T> {
+        var memoryStats: EvalMemoryStats? = null
+        val value = evaluateInternal(code, filename, asModule) { memoryStats = it }
+        return EvalMemoryResult(
+            value = castValueOr(value, typeOf<T>()) {
+                typeConverters.convert(
+                    source = it,
+                    sourceType = typeOfInstance(typeConverters, it),
+                    targetType = typeOf<T>()
+                )
+            },
+            memoryStats = memoryStats!!,
+        )
+    }
+
     @PublishedApi
-    internal suspend fun evaluateInternal(bytecode: ByteArray): Any? = evalAndAwait {
-        evaluateBytecode(context = context, globals = globals, buffer = bytecode)
+    internal suspend fun evaluateInternal(bytecode: ByteArray): Any? = tracer.trace(
+        phase = TracePhase.Evaluate,
+        name = "bytecode",
+        attributes = { mapOf("bytecodeLength" to bytecode.size) },
+    ) {
+        evalAndAwait(
+            filename = "bytecode",
+            sourceHash = { SlowEvalTimer.hashSource(bytecode) },
+        ) {
+            evaluateBytecode(context = context, globals = globals, buffer = bytecode)
+        }
     }
 
     @PublishedApi
@@ -306,26 +525,96 @@ actual class QuickJs private constructor(
         code: String,
         filename: String,
         asModule: Boolean,
-    ): Any? = evalAndAwait {
-        evaluate(context, globals, filename, code, asModule)
+        onMemoryStats: ((EvalMemoryStats) -> Unit)? = null,
+    ): Any? = tracer.trace(
+        phase = TracePhase.Evaluate,
+        name = filename,
+        attributes = { mapOf("asModule" to asModule, "codeLength" to code.length) },
+    ) {
+        evalAndAwait(
+            filename = filename,
+            sourceHash = { SlowEvalTimer.hashSource(code) },
+            onMemoryStats = onMemoryStats,
+        ) {
+            evaluate(context, globals, filename, code, asModule)
+        }
     }
 
-    private suspend fun evalAndAwait(evalBlock: suspend () -> Any?): Any? {
+    private suspend fun evalAndAwait(
+        filename: String,
+        sourceHash: () -> String,
+        onMemoryStats: ((EvalMemoryStats) -> Unit)? = null,
+        evalBlock: suspend () -> Any?,
+    ): Any? {
         ensureNotClosed()
+        check(onMemoryStats == null || isMemoryAccountingEnabled) {
+            "Memory accounting is not enabled for this instance."
+        }
         evalException = null
         loadModules()
-        val result = jsResultMutex.withLock {
-            jsMutex.withLock { evalBlock() }
-            awaitAsyncJobs()
-            jsMutex.withLock { getEvaluateResult(context, globals) }
+        val threshold = slowEvalThresholdMillis
+        val sink = slowEvalSink
+        val timer = if (threshold >= 0 && sink != null) {
+            SlowEvalTimer(threshold, isSlowEvalBreakdownEnabled)
+        } else {
+            null
         }
-        handleException()
+        var slowEvaluation: SlowEvaluation? = null
+        val result = try {
+            jsResultMutex.withLock {
+                val evalAccounting = beginEvalAccounting(runtime, globals, evalMemoryLimit)
+                try {
+                    jsMutex.withLock { evalBlock() }
+                    timer?.evaluated()
+                    awaitAsyncJobs()
+                    timer?.awaited()
+                    jsMutex.withLock { getEvaluateResult(context, globals) }
+                } finally {
+                    if (!isClosed) {
+                        val stats = endEvalAccounting(runtime, globals, evalAccounting)
+                        if (stats != null && onMemoryStats != null) {
+                            onMemoryStats(
+                                EvalMemoryStats(allocatedBytes = stats[0], peakBytes = stats[1])
+                            )
+                        }
+                        slowEvaluation = timer?.finish(
+                            filename = filename,
+                            sourceHash = sourceHash,
+                            compileNanos = { getEvalCompileNanos(globals) },
+                            bindingCalls = {
+                                getBindingStatsNames(globals) to getEvalBindingCalls(globals)
+                            },
+                        )
+                    }
+                }
+            }.also { handleException() }
+        } catch (e: Throwable) {
+            SlowEvalTimer.report(sink, slowEvaluation, e)
+            throw e
+        }
+        SlowEvalTimer.report(sink, slowEvaluation, null)
         return result
     }
 
+    /**
+     * Time phases and binding calls of evaluations only when slow evaluations are reported
+     * with the breakdown.
+     */
+    private fun updateSlowEvalTracking() {
+        val isEnabled = slowEvalThresholdMillis >= 0 && slowEvalSink != null &&
+                isSlowEvalBreakdownEnabled
+        setSlowEvalTracking(globals, isEnabled)
+    }
+
     actual fun gc() {
         ensureNotClosed()
-        gc(runtime, globals)
+        tracer.trace(
+            phase = TracePhase.Gc,
+            name = "gc",
+            attributes = { mapOf("trigger" to "explicit") },
+        ) {
+            gc(runtime, globals)
+        }
     }
 
     actual override fun close() {
@@ -337,6 +626,7 @@ actual class QuickJs private constructor(
         jsMutex.withLockSync {}
         objectBindings.clear()
         globalFunctions.clear()
+        classBindings.clear()
         modules.clear()
         if (globals != 0L) {
             releaseGlobals(context, globals)
@@ -354,11 +644,9 @@ actual class QuickJs private constructor(
 
     private suspend fun awaitAsyncJobs() {
         jsMutex.withLock {
-            do {
-                // Execute JS Promises, putting this in while(true) is unnecessary
-                // since we have the same loop after every asyncFunction call
-                val executed = executePendingJob(context, globals)
-            } while (executed)
+            // Execute JS Promises, putting this in while(true) is unnecessary
+            // since we have the same loop after every asyncFunction call
+            executePendingJobs()
         }
         while (true) {
             val jobs = jobsMutex.withLock { asyncJobs.filter { it.isActive } }
@@ -370,6 +658,17 @@ actual class QuickJs private constructor(
         }
     }
 
+    /**
+     * Drain pending JS jobs, requires the JS mutex.
+     */
+    private fun executePendingJobs() {
+        tracer.trace(phase = TracePhase.ExecutePendingJobs, name = "pendingJobs") {
+            do {
+                val executed = executePendingJob(context, globals)
+            } while (executed)
+        }
+    }
+
     private fun handleException() {
         val exception = evalException
         if (exception != null) {
@@ -379,8 +678,15 @@ actual class QuickJs private constructor(
     }
 
     private suspend fun loadModules() = jsMutex.withLock {
-        for (module in modules) {
-            evaluateBytecode(context = context, globals = globals, buffer = module)
+        if (modules.isEmpty()) return@withLock
+        tracer.trace(
+            phase = TracePhase.LoadModules,
+            name = "modules",
+            attributes = { mapOf("moduleCount" to modules.size) },
+        ) {
+            for (module in modules) {
+                evaluateBytecode(context = context, globals = globals, buffer = module)
+            }
         }
         modules.clear()
     }
@@ -418,9 +724,7 @@ actual class QuickJs private constructor(
                 // The job is completed, see what we can do next:
                 // - Execute subsequent Promises
                 // - Cancel all jobs and fail, if rejected and JS didn't handle it
-                do {
-                    val executed = executePendingJob(context, globals)
-                } while (executed)
+                executePendingJobs()
             }
         }
         jobsMutex.withLockSync { asyncJobs += job }
@@ -457,7 +761,13 @@ actual class QuickJs private constructor(
         val binding = objectBindings[handle] ?: throw QuickJsException(
             "JavaScript called getter of '$name' on an unknown binding"
         )
-        return binding.getter(name)
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "getter") },
+        ) {
+            binding.getter(name)
+        }
     }
 
     /**
@@ -472,7 +782,13 @@ actual class QuickJs private constructor(
         val binding = objectBindings[handle] ?: throw QuickJsException(
             "JavaScript called setter of '$name' on an unknown binding"
         )
-        binding.setter(name, value)
+        tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "setter") },
+        ) {
+            binding.setter(name, value)
+        }
     }
 
     /**
@@ -484,6 +800,20 @@ actual class QuickJs private constructor(
         args: Array<Any?>,
     ): Any? {
         ensureNotClosed()
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "function", "argCount" to args.size) },
+        ) {
+            callFunctionBinding(handle, name, args)
+        }
+    }
+
+    private fun callFunctionBinding(
+        handle: Long,
+        name: String,
+        args: Array<Any?>,
+    ): Any? {
         if (handle == JsObjectHandle.globalThis.nativeHandle) {
             val binding = globalFunctions[name] ?: throw QuickJsException(
                 "'$name()' does not found in global functions."
@@ -501,6 +831,71 @@ actual class QuickJs private constructor(
         }
     }
 
+    /**
+     * Called from JNI.
+     */
+    private fun onCallClassGetter(
+        classIndex: Int,
+        instance: Any,
+        name: String,
+    ): Any? {
+        ensureNotClosed()
+        val binding = classBinding(classIndex)
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "getter") },
+        ) {
+            binding.getter(instance, name)
+        }
+    }
+
+    /**
+     * Called from JNI.
+     */
+    private fun onCallClassSetter(
+        classIndex: Int,
+        instance: Any,
+        name: String,
+        value: Any?,
+    ) {
+        ensureNotClosed()
+        val binding = classBinding(classIndex)
+        tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "setter") },
+        ) {
+            binding.setter(instance, name, value)
+        }
+    }
+
+    /**
+     * Called from JNI.
+     */
+    private fun onCallClassFunction(
+        classIndex: Int,
+        instance: Any,
+        name: String,
+        args: Array<Any?>,
+    ): Any? {
+        ensureNotClosed()
+        val binding = classBinding(classIndex)
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "function", "argCount" to args.size) },
+        ) {
+            binding.invoke(instance, name, args)
+        }
+    }
+
+    private fun classBinding(classIndex: Int): ClassBinding<Any> {
+        return classBindings.getOrNull(classIndex) ?: throw QuickJsException(
+            "JavaScript called an unknown class binding: $classIndex"
+        )
+    }
+
     /**
      * Called from JNI.
      */
@@ -520,15 +915,49 @@ actual class QuickJs private constructor(
         jobsMutex.withLockSync { asyncJobs.forEach { it.cancel() } }
     }
 
+    /**
+     * Called from JNI when a binding object has been garbage-collected.
+     */
+    private fun onBindingFinalized(handle: Long) {
+        objectBindings.remove(handle)
+    }
+
+    private var thresholdGcToken: Any? = null
+
+    /**
+     * Called from JNI before and after a GC triggered by the allocation threshold.
+     *
+     * This runs inside an engine allocation, so tracer failures are dropped instead of
+     * being thrown through the engine.
+     */
+    private fun onThresholdGc(isEnd: Boolean) {
+        val tracer = this.tracer
+        if (tracer === QuickJsTracer.NoOp) return
+        try {
+            if (!isEnd) {
+                val attributes = mapOf("trigger" to "threshold")
+                thresholdGcToken = tracer.begin(TracePhase.Gc, "gc", attributes)
+            } else {
+                tracer.end(TracePhase.Gc, thresholdGcToken, null)
+            }
+        } catch (e: Throwable) {
+            // Ignored
+        }
+        if (isEnd) thresholdGcToken = null
+    }
+
     private fun ensureNotClosed() = check(runtime != 0L) { "Already closed." }
 
-    private external fun newRuntime(): Long
+    private external fun newRuntime(accounted: Boolean): Long
 
     @Throws(QuickJsException::class)
     private external fun newContext(runtime: Long): Long
 
     private external fun initGlobals(runtime: Long): Long
 
+    @Throws(QuickJsException::class)
+    private external fun internAtoms(context: Long, globals: Long, names: Array<String>)
+
     @Throws(QuickJsException::class)
     private external fun releaseGlobals(context: Long, globals: Long)
 
@@ -546,8 +975,29 @@ actual class QuickJs private constructor(
         name: String,
         properties: Array<JsProperty>,
         functions: Array<JsFunction>,
+        prototypeKey: String?,
     ): Long
 
+    @Throws(QuickJsException::class)
+    private external fun defineObjectTree(
+        globals: Long,
+        context: Long,
+        parent: Long,
+        tree: ByteArray,
+        values: Array<Any?>,
+        handles: LongArray,
+    )
+
+    @Throws(QuickJsException::class)
+    private external fun defineClass(
+        globals: Long,
+        context: Long,
+        cls: Class<*>,
+        name: String,
+        properties: Array<JsProperty>,
+        functions: Array<JsFunction>,
+    ): Int
+
     @Throws(QuickJsException::class)
     private external fun defineFunction(
         globals: Long,
@@ -559,6 +1009,47 @@ actual class QuickJs private constructor(
     @Throws(QuickJsException::class)
     private external fun gc(runtime: Long, globals: Long)
 
+    private external fun getGcStats(globals: Long): LongArray
+
+    private external fun getOpcodeNames(): Array<String>
+
+    private external fun getOpcodeCounts(runtime: Long, globals: Long): LongArray?
+
+    private external fun resetOpcodeCounts(runtime: Long, globals: Long)
+
+    @Throws(QuickJsException::class)
+    private external fun beginEvalAccounting(runtime: Long, globals: Long, limit: Long): Long
+
+    @Throws(QuickJsException::class)
+    private external fun endEvalAccounting(
+        runtime: Long,
+        globals: Long,
+        evalAccounting: Long,
+    ): LongArray?
+
+    private external fun setHandleTracking(globals: Long, enabled: Boolean)
+
+    private external fun getHandleCounts(globals: Long): LongArray
+
+    private external fun getTrackedHandles(globals: Long): Array<String>
+
+    private external fun setBindingStatsEnabled(globals: Long, enabled: Boolean)
+
+    private external fun getBindingStatsNames(globals: Long): Array<String>
+
+    private external fun getBindingStats(globals: Long, slotCount: Int): LongArray
+
+    private external fun setSlowEvalTracking(globals: Long, enabled: Boolean)
+
+    private external fun getEvalCompileNanos(globals: Long): Long
+
+    private external fun getEvalBindingCalls(globals: Long): LongArray
+
+    @Throws(QuickJsException::class)
+    private external fun startProfiling(context: Long, globals: Long, intervalMicros: Long)
+
+    private external fun stopProfiling(globals: Long): String
+
     @Throws(QuickJsException::class)
     private external fun nativeGetVersion(): String
 
@@ -611,8 +1102,12 @@ actual class QuickJs private constructor(
     private external fun getEvaluateResult(context: Long, globals: Long): Any?
 
     actual companion object {
+        private var libraryLoadNanos = 0L
+
         init {
+            val mark = TimeSource.Monotonic.markNow()
             loadNativeLibrary("quickjs")
+            libraryLoadNanos = mark.elapsedNow().inWholeNanoseconds
         }
 
         @Throws(QuickJsException::class)
@@ -621,5 +1116,17 @@ actual class QuickJs private constructor(
         ): QuickJs = QuickJs(
             jobDispatcher = jobDispatcher,
         )
+
+        @ExperimentalQuickJsApi
+        @Throws(QuickJsException::class)
+        actual fun create(
+            jobDispatcher: CoroutineDispatcher,
+            atomTemplate: AtomTemplate?,
+            enableMemoryAccounting: Boolean,
+        ): QuickJs = QuickJs(
+            jobDispatcher = jobDispatcher,
+            atomNames = atomTemplate?.names,
+            isMemoryAccountingEnabled = enableMemoryAccounting,
+        )
     }
 }
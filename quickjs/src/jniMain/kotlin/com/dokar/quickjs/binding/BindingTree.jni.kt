@@ -0,0 +1,77 @@
+package com.dokar.quickjs.binding
+
+import java.io.ByteArrayOutputStream
+
+// Flags of encoded binding trees, they match binding_bridge.c
+private const val TREE_PROPERTY_CONFIGURABLE = 1
+private const val TREE_PROPERTY_WRITABLE = 2
+private const val TREE_PROPERTY_ENUMERABLE = 4
+private const val TREE_PROPERTY_CONSTANT = 8
+private const val TREE_FUNCTION_ASYNC = 1
+
+/**
+ * A binding tree encoded for define_js_object_tree(), constant values are passed as objects.
+ */
+internal class EncodedBindingTree(
+    val bytes: ByteArray,
+    val values: Array<Any?>,
+)
+
+/**
+ * Encode the names and flags of the tree, see define_js_object_tree() for the layout.
+ */
+internal fun List<BindingTreeNode>.encode(): EncodedBindingTree {
+    val out = ByteArrayOutputStream(size * 256)
+    val values = mutableListOf<Any?>()
+
+    out.writeInt(size)
+    for (node in this) {
+        val binding = node.binding
+        out.writeInt(node.parentIndex)
+        out.writeString(node.name)
+        val prototypeKey = binding.prototypeKey
+        if (prototypeKey != null) {
+            out.write(1)
+            out.writeString(prototypeKey)
+        } else {
+            out.write(0)
+        }
+
+        out.writeInt(binding.properties.size)
+        for (prop in binding.properties) {
+            var flags = 0
+            if (prop.configurable) flags = flags or TREE_PROPERTY_CONFIGURABLE
+            if (prop.writable) flags = flags or TREE_PROPERTY_WRITABLE
+            if (prop.enumerable) flags = flags or TREE_PROPERTY_ENUMERABLE
+            if (prop.isConstant) flags = flags or TREE_PROPERTY_CONSTANT
+            out.writeString(prop.name)
+            out.write(flags)
+            if (prop.isConstant) {
+                out.writeInt(values.size)
+                values.add(prop.value)
+            }
+        }
+
+        out.writeInt(binding.functions.size)
+        for (func in binding.functions) {
+            out.writeString(func.name)
+            out.write(if (func.isAsync) TREE_FUNCTION_ASYNC else 0)
+        }
+    }
+
+    return EncodedBindingTree(bytes = out.toByteArray(), values = values.toTypedArray())
+}
+
+private fun ByteArrayOutputStream.writeInt(value: Int) {
+    write(value and 0xFF)
+    write((value ushr 8) and 0xFF)
+    write((value ushr 16) and 0xFF)
+    write((value ushr 24) and 0xFF)
+}
+
+private fun ByteArrayOutputStream.writeString(value: String) {
+    val bytes = value.encodeToByteArray()
+    writeInt(bytes.size)
+    write(bytes)
+    write(0)
+}
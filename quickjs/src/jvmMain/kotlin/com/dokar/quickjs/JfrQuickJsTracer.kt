@@ -0,0 +1,57 @@
+package com.dokar.quickjs
+
+import jdk.jfr.Category
+import jdk.jfr.Description
+import jdk.jfr.Event
+import jdk.jfr.Label
+import jdk.jfr.Name
+import jdk.jfr.StackTrace
+
+/**
+ * A tracer that records phases as JFR events, so slow requests can be broken down in
+ * flight recordings. Events are named 'com.dokar.quickjs.Phase'.
+ *
+ * Phases are only recorded when the event is enabled in a running recording.
+ */
+@ExperimentalQuickJsApi
+class JfrQuickJsTracer : QuickJsTracer {
+    override fun begin(phase: TracePhase, name: String, attributes: Map<String, Any?>): Any? {
+        val event = QuickJsPhaseEvent()
+        if (!event.isEnabled) {
+            return null
+        }
+        event.phase = phase.name
+        event.name = name
+        event.attributes = if (attributes.isEmpty()) null else attributes.toString()
+        event.begin()
+        return event
+    }
+
+    override fun end(phase: TracePhase, token: Any?, error: Throwable?) {
+        val event = token as? QuickJsPhaseEvent ?: return
+        event.end()
+        if (event.shouldCommit()) {
+            event.error = error?.toString()
+            event.commit()
+        }
+    }
+}
+
+@Name("com.dokar.quickjs.Phase")
+@Label("QuickJS Phase")
+@Category("QuickJS")
+@Description("A phase of QuickJS activity, e.g. evaluating or calling a binding")
+@StackTrace(false)
+internal class QuickJsPhaseEvent : Event() {
+    @field:Label("Phase")
+    var phase: String? = null
+
+    @field:Label("Name")
+    var name: String? = null
+
+    @field:Label("Attributes")
+    var attributes: String? = null
+
+    @field:Label("Error")
+    var error: String? = null
+}
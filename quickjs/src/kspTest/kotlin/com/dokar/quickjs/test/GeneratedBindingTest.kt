@@ -0,0 +1,158 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.binding.JsBinding
+import com.dokar.quickjs.binding.JsIgnore
+import com.dokar.quickjs.binding.JsObject
+import com.dokar.quickjs.converter.JsObjectConverter
+import com.dokar.quickjs.quickJs
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.test.runTest
+import kotlin.reflect.KType
+import kotlin.reflect.typeOf
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFails
+import kotlin.test.assertTrue
+
+class GeneratedBindingTest {
+    @Test
+    fun properties() = runTest {
+        quickJs {
+            val counter = Counter()
+            defineCounter("counter", counter)
+
+            assertEquals("counter", evaluate("counter.name"))
+            assertEquals(0L, evaluate("counter.count"))
+            evaluate<Any?>("counter.count = 10")
+            assertEquals(10, counter.count)
+            // Scripts are not strict, writing a read-only property is ignored
+            evaluate<Any?>("counter.name = 'other'")
+            assertEquals("counter", evaluate("counter.name"))
+            assertTrue(evaluate("counter.secret === undefined"))
+        }
+    }
+
+    @Test
+    fun functions() = runTest {
+        quickJs {
+            val counter = Counter()
+            defineCounter("counter", counter)
+
+            assertEquals(3L, evaluate("counter.add(1, 2)"))
+            assertEquals(3, counter.count)
+            assertEquals("Hello, Jack!", evaluate("counter.greet('Jack')"))
+            assertEquals(null, evaluate<String?>("counter.greet(null)"))
+            assertFails { evaluate<Any?>("counter.add(1)") }
+            assertFails { evaluate<Any?>("counter.reset()") }
+        }
+    }
+
+    @Test
+    fun castArguments() = runTest {
+        quickJs {
+            val counter = Counter()
+            defineCounter("counter", counter)
+
+            evaluate<Any?>("counter.count = 2")
+            assertEquals(3.0, evaluate("counter.scale(1.5)"))
+            assertEquals(4.0, evaluate("counter.scale(2)"))
+            assertFails { evaluate<Any?>("counter.add(2 ** 40, 1)") }
+            assertFails { evaluate<Any?>("counter.add(null, 1)") }
+            assertFails { evaluate<Any?>("counter.count = null") }
+            assertEquals(2, counter.count)
+        }
+    }
+
+    @Test
+    fun asyncFunctions() = runTest {
+        quickJs {
+            defineCounter("counter", Counter())
+
+            assertEquals(5L, evaluate("await counter.addLater(5)"))
+        }
+    }
+
+    @Test
+    fun convertedTypes() = runTest {
+        quickJs {
+            addTypeConverters(PointConverter)
+            defineCounter("counter", Counter())
+
+            assertEquals(3L, evaluate("counter.sum({ x: 1, y: 2 })"))
+            assertEquals(2L, evaluate("counter.origin().y"))
+        }
+    }
+
+    @Test
+    fun defineNested() = runTest {
+        quickJs {
+            val outer = defineCounter("outer", Counter())
+            defineCounter("inner", Counter(), parent = outer)
+
+            assertEquals("counter", evaluate("outer.inner.name"))
+        }
+    }
+
+    @Test
+    fun sharePrototype() = runTest {
+        quickJs {
+            val first = Counter()
+            defineCounter("first", first, sharedPrototype = true)
+            defineCounter("second", Counter(), sharedPrototype = true)
+
+            assertTrue(evaluate("Object.getPrototypeOf(first) === Object.getPrototypeOf(second)"))
+            assertEquals(3L, evaluate("first.add(1, 2)"))
+            assertEquals(3, first.count)
+            assertEquals(0L, evaluate("second.count"))
+        }
+    }
+
+    private object PointConverter : JsObjectConverter<Point> {
+        override val targetType: KType = typeOf<Point>()
+
+        override fun convertToTarget(value: JsObject): Point = Point(
+            x = (value["x"] as Long).toInt(),
+            y = (value["y"] as Long).toInt(),
+        )
+
+        override fun convertToSource(value: Point): JsObject = JsObject(
+            mapOf("x" to value.x, "y" to value.y)
+        )
+    }
+}
+
+internal data class Point(val x: Int, val y: Int)
+
+@JsBinding
+internal class Counter {
+    val name = "counter"
+
+    var count = 0
+
+    @JsIgnore
+    var secret = "secret"
+
+    fun add(a: Int, b: Int): Int {
+        count += a + b
+        return count
+    }
+
+    fun scale(factor: Double): Double = count * factor
+
+    fun greet(name: String?): String? = name?.let { "Hello, $it!" }
+
+    suspend fun addLater(value: Int): Int {
+        delay(10)
+        count += value
+        return count
+    }
+
+    fun sum(point: Point): Int = point.x + point.y
+
+    fun origin(): Point = Point(1, 2)
+
+    @JsIgnore
+    fun reset() {
+        count = 0
+    }
+}
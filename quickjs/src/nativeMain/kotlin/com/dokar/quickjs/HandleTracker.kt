@@ -0,0 +1,45 @@
+package com.dokar.quickjs
+
+/**
+ * Count the handles held by the bridge, and record their creation sites when enabled.
+ */
+@OptIn(ExperimentalQuickJsApi::class)
+internal class HandleTracker {
+    var isEnabled = false
+
+    private val kindCounts = LongArray(HandleKind.entries.size)
+
+    private val sites = mutableListOf<HandleSite>()
+
+    private val bindingSites = mutableMapOf<Long, HandleSite>()
+
+    /**
+     * Track handles that live until closing.
+     */
+    fun track(kind: HandleKind, callType: String, binding: String, count: Int = 1) {
+        kindCounts[kind.ordinal] += count.toLong()
+        if (isEnabled) {
+            repeat(count) { sites.add(HandleSite(kind, callType, binding)) }
+        }
+    }
+
+    fun trackBinding(handle: Long, callType: String, binding: String) {
+        kindCounts[HandleKind.BindingObject.ordinal]++
+        if (isEnabled) {
+            bindingSites[handle] = HandleSite(HandleKind.BindingObject, callType, binding)
+        }
+    }
+
+    fun untrackBinding(handle: Long) {
+        kindCounts[HandleKind.BindingObject.ordinal]--
+        bindingSites.remove(handle)
+    }
+
+    fun report(jsObjectCount: Long): HandleReport {
+        return HandleReport.create(
+            kindCounts = kindCounts,
+            trackedSites = sites + bindingSites.values,
+            jsObjectCount = jsObjectCount,
+        )
+    }
+}
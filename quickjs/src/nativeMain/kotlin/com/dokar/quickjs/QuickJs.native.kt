@@ -2,20 +2,36 @@ package com.dokar.quickjs
 
 import com.dokar.quickjs.binding.AsyncFunctionBinding
 import com.dokar.quickjs.binding.Binding
+import com.dokar.quickjs.binding.BindingTreeNode
+import com.dokar.quickjs.binding.ClassBinding
 import com.dokar.quickjs.binding.FunctionBinding
 import com.dokar.quickjs.binding.JsObjectHandle
 import com.dokar.quickjs.binding.ObjectBinding
+import com.dokar.quickjs.binding.ObjectBindings
 import com.dokar.quickjs.bridge.ExecuteJobResult
 import com.dokar.quickjs.bridge.JsPromise
 import com.dokar.quickjs.bridge.compile
+import com.dokar.quickjs.bridge.defineClass
 import com.dokar.quickjs.bridge.defineFunction
 import com.dokar.quickjs.bridge.defineObject
+import com.dokar.quickjs.bridge.defineSharedPrototype
+import com.dokar.quickjs.bridge.deleteGlobalObject
 import com.dokar.quickjs.bridge.evaluate
 import com.dokar.quickjs.bridge.executePendingJob
+import com.dokar.quickjs.bridge.internAtoms
 import com.dokar.quickjs.bridge.invokeJsFunction
+import com.dokar.quickjs.bridge.evalBindingCalls
+import com.dokar.quickjs.bridge.evalMemoryStats
 import com.dokar.quickjs.bridge.ktMemoryUsage
+import com.dokar.quickjs.bridge.newHostInstance
+import com.dokar.quickjs.bridge.newAccountedRuntime
 import com.dokar.quickjs.bridge.objectHandleToStableRef
+import com.dokar.quickjs.bridge.registerBindingClass
 import com.dokar.quickjs.bridge.setPromiseRejectionHandler
+import com.dokar.quickjs.bridge.setThresholdGcListener
+import com.dokar.quickjs.bridge.snapshot
+import com.dokar.quickjs.bridge.snapshotGcStats
+import com.dokar.quickjs.bridge.snapshotOpcodeStats
 import com.dokar.quickjs.converter.TypeConverter
 import com.dokar.quickjs.converter.TypeConverters
 import com.dokar.quickjs.converter.castValueOr
@@ -24,8 +40,13 @@ import com.dokar.quickjs.util.withLockSync
 import kotlinx.cinterop.CPointer
 import kotlinx.cinterop.CValue
 import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.LongVar
 import kotlinx.cinterop.StableRef
+import kotlinx.cinterop.alloc
+import kotlinx.cinterop.nativeHeap
+import kotlinx.cinterop.ptr
 import kotlinx.cinterop.toKStringFromUtf8
+import kotlinx.cinterop.value
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlinx.coroutines.CoroutineExceptionHandler
 import kotlinx.coroutines.CoroutineScope
@@ -34,32 +55,70 @@ import kotlinx.coroutines.joinAll
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.sync.Mutex
 import kotlinx.coroutines.sync.withLock
+import platform.posix.free
+import kotlin.reflect.KClass
+import quickjs.BindingStats
+import quickjs.EvalAccounting
+import quickjs.GcStats as NativeGcStats
+import quickjs.JSAtom
 import quickjs.JSContext
 import quickjs.JSRuntime
 import quickjs.JSValue
+import quickjs.JS_FreeAtom
 import quickjs.JS_FreeContext
 import quickjs.JS_FreeRuntime
 import quickjs.JS_FreeValue
 import quickjs.JS_GetRuntime
 import quickjs.JS_NewContext
-import quickjs.JS_NewRuntime
-import quickjs.JS_RunGC
 import quickjs.JS_SetMaxStackSize
 import quickjs.JS_SetMemoryLimit
 import quickjs.JS_UpdateStackTop
+import quickjs.RuntimeHooks
+import quickjs.SamplingProfiler
+import quickjs.accounting_begin_eval
+import quickjs.accounting_end_eval
+import quickjs.accounting_free
+import quickjs.binding_stats_begin_eval
+import quickjs.binding_stats_free
+import quickjs.binding_stats_is_enabled
+import quickjs.binding_stats_new
+import quickjs.binding_stats_set_enabled
+import quickjs.binding_stats_set_eval_tracking
+import quickjs.gc_stats_free
+import quickjs.gc_stats_new
+import quickjs.gc_stats_run
+import quickjs.opcode_stats_reset
+import quickjs.profiler_collapsed_stacks
+import quickjs.profiler_free
+import quickjs.profiler_new
+import quickjs.profiler_start
+import quickjs.profiler_stop
 import quickjs.quickjs_version
+import quickjs.runtime_hooks_install
+import quickjs.runtime_hooks_uninstall
 import kotlin.coroutines.cancellation.CancellationException
 import kotlin.reflect.typeOf
 
-@OptIn(ExperimentalForeignApi::class)
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
 actual class QuickJs private constructor(
-    private val jobDispatcher: CoroutineDispatcher
+    private val jobDispatcher: CoroutineDispatcher,
+    atomNames: Array<String>? = null,
+    isMemoryAccountingEnabled: Boolean = false,
 ) {
-    private val runtime: CPointer<JSRuntime> = JS_NewRuntime()
-        ?: qjsError("Failed to create js runtime.")
+    private val creationTimer = CreationTimer()
+
+    private val accountedRuntime = (newAccountedRuntime(accounted = isMemoryAccountingEnabled)
+        ?: qjsError("Failed to create js runtime.")).also { creationTimer.lap() }
+
+    private val runtime: CPointer<JSRuntime> = accountedRuntime.runtime
+
+    /**
+     * Null if memory accounting is not enabled.
+     */
+    private val memoryAccounting = accountedRuntime.accounting
 
-    private val context: CPointer<JSContext> = JS_NewContext(runtime)
-        ?: qjsError("Failed to create js context.")
+    private val context: CPointer<JSContext> = (JS_NewContext(runtime)
+        ?: qjsError("Failed to create js context.")).also { creationTimer.lap() }
 
     private val ref = StableRef.create(this)
 
@@ -72,11 +131,82 @@ actual class QuickJs private constructor(
     }
     private val coroutineScope = CoroutineScope(jobDispatcher + exceptionHandler)
 
-    private val objectBindings = mutableMapOf<Long, ObjectBinding>()
+    private val objectBindings = ObjectBindings()
     private val globalFunctions = mutableMapOf<String, Binding>()
 
+    /**
+     * Indexed by the class index, prototypes are freed when closing.
+     */
+    private val hostClasses = mutableListOf<HostClass>()
+    // Host class indexes of exact object classes, -1 if it's not a host class
+    private val hostClassIndexes = mutableMapOf<KClass<*>, Int>()
+
+    /**
+     * Indexed by the prototype index, prototypes are freed when closing.
+     */
+    private val sharedPrototypes = mutableListOf<SharedPrototype>()
+
     private val managedJsValues = mutableListOf<CValue<JSValue>>()
 
+    /**
+     * Atoms from the template, kept until closing.
+     */
+    private var templateAtoms: List<JSAtom> = emptyList()
+
+    private val handleTracker = HandleTracker()
+
+    internal val bindingStats: CPointer<BindingStats> = binding_stats_new()
+        ?: qjsError("Failed to create binding stats.")
+
+    private val profiler: CPointer<SamplingProfiler> = profiler_new()
+        ?: qjsError("Failed to create the profiler.")
+
+    private var cpuProfilingIntervalMicros = 0L
+
+    private val nativeGcStats: CPointer<NativeGcStats> =
+        gc_stats_new(runtime) ?: qjsError("Failed to create GC stats.")
+
+    private var thresholdGcToken: Any? = null
+
+    /**
+     * Hooks of the runtime interrupt handler, freed when closing.
+     */
+    private val runtimeHooks = nativeHeap.alloc<RuntimeHooks>().apply {
+        profiler = this@QuickJs.profiler
+    }
+
+    @ExperimentalQuickJsApi
+    actual var tracer: QuickJsTracer = QuickJsTracer.NoOp
+
+    @ExperimentalQuickJsApi
+    actual var slowEvalThresholdMillis: Long = -1
+        set(value) {
+            ensureNotClosed()
+            field = value
+            updateSlowEvalTracking()
+        }
+
+    @ExperimentalQuickJsApi
+    actual var isSlowEvalBreakdownEnabled: Boolean = false
+        set(value) {
+            ensureNotClosed()
+            field = value
+            updateSlowEvalTracking()
+        }
+
+    @ExperimentalQuickJsApi
+    actual var slowEvalSink: SlowEvalSink? = null
+        set(value) {
+            ensureNotClosed()
+            field = value
+            updateSlowEvalTracking()
+        }
+
+    /**
+     * The compile time of the current evaluation, freed when closing.
+     */
+    private val evalCompileNanos = nativeHeap.alloc<LongVar>()
+
     private val modules = mutableListOf<ByteArray>()
 
     private val jobsMutex = Mutex()
@@ -115,6 +245,10 @@ actual class QuickJs private constructor(
             JS_SetMaxStackSize(runtime, value.toULong())
         }
 
+    @ExperimentalQuickJsApi
+    actual var creationTimings: CreationTimings = CreationTimings(0, 0, 0, 0)
+        private set
+
     actual val memoryUsage: MemoryUsage
         get() {
             ensureNotClosed()
@@ -122,8 +256,105 @@ actual class QuickJs private constructor(
             return runtime.ktMemoryUsage()
         }
 
+    @ExperimentalQuickJsApi
+    actual val gcStats: GcStats
+        get() {
+            ensureNotClosed()
+            return nativeGcStats.snapshotGcStats()
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun opcodeStats(): OpcodeStats? {
+        ensureNotClosed()
+        return runtime.snapshotOpcodeStats()
+    }
+
+    @ExperimentalQuickJsApi
+    actual fun resetOpcodeStats() {
+        ensureNotClosed()
+        opcode_stats_reset(runtime)
+    }
+
+    @ExperimentalQuickJsApi
+    actual var evalMemoryLimit: Long = -1
+        set(value) {
+            ensureNotClosed()
+            check(value < 0 || memoryAccounting != null) {
+                "Memory accounting is not enabled for this instance."
+            }
+            field = value
+        }
+
+    @ExperimentalQuickJsApi
+    actual var isHandleTrackingEnabled: Boolean
+        get() = handleTracker.isEnabled
+        set(value) {
+            ensureNotClosed()
+            handleTracker.isEnabled = value
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun handleReport(): HandleReport {
+        ensureNotClosed()
+        return handleTracker.report(jsObjectCount = memoryUsage.objCount)
+    }
+
+    @ExperimentalQuickJsApi
+    actual var isBindingStatsEnabled: Boolean
+        get() = binding_stats_is_enabled(bindingStats) != 0
+        set(value) {
+            ensureNotClosed()
+            binding_stats_set_enabled(bindingStats, if (value) 1 else 0)
+        }
+
+    @ExperimentalQuickJsApi
+    actual fun bindingStats(): List<BindingCallStats> {
+        ensureNotClosed()
+        return bindingStats.snapshot()
+    }
+
+    @ExperimentalQuickJsApi
+    actual fun startCpuProfiling(samplingIntervalMicros: Long) {
+        ensureNotClosed()
+        require(samplingIntervalMicros > 0) { "Sampling interval must be positive." }
+        if (profiler_start(profiler, context, samplingIntervalMicros) != 0) {
+            qjsError("Failed to start the profiler thread.")
+        }
+        cpuProfilingIntervalMicros = samplingIntervalMicros
+    }
+
+    @ExperimentalQuickJsApi
+    actual fun stopCpuProfiling(): CpuProfile {
+        ensureNotClosed()
+        profiler_stop(profiler)
+        val stacks = profiler_collapsed_stacks(profiler)
+        val text = try {
+            stacks?.toKStringFromUtf8() ?: ""
+        } finally {
+            free(stacks)
+        }
+        return CpuProfile.fromCollapsedStacks(
+            text = text,
+            samplingIntervalMicros = cpuProfilingIntervalMicros,
+        )
+    }
+
     init {
+        handleTracker.track(HandleKind.GlobalRef, HandleSite.UNTRACKED, "")
         setPromiseRejectionHandler(ref, runtime)
+        registerBindingClass(ref, runtime, context)
+        nativeGcStats.setThresholdGcListener(ref)
+        runtime_hooks_install(runtime, runtimeHooks.ptr)
+        if (atomNames != null) {
+            try {
+                templateAtoms = context.internAtoms(atomNames)
+            } catch (e: QuickJsException) {
+                close()
+                throw e
+            }
+        }
+        // Statically linked, nothing to load
+        creationTimings = creationTimer.finish(libraryLoadNanos = 0)
     }
 
     actual fun addTypeConverters(vararg converters: TypeConverter<*, *>) {
@@ -136,16 +367,75 @@ actual class QuickJs private constructor(
         parent: JsObjectHandle
     ): JsObjectHandle {
         ensureNotClosed()
+        if (parent != JsObjectHandle.globalThis && parent.nativeHandle !in objectBindings) {
+            qjsError("Parent object has been garbage-collected.")
+        }
         val handle = context.defineObject(
             quickJsRef = ref,
+            bindingStats = bindingStats,
             parentHandle = parent.nativeHandle,
             name = name,
             binding = binding,
+            prototype = binding.prototypeKey?.let { sharedPrototype(it, binding) },
         )
         objectBindings[handle] = binding
+        handleTracker.trackBinding(handle, callType = "defineObject", binding = name)
         return JsObjectHandle(handle)
     }
 
+    internal actual fun defineBindingTree(nodes: List<BindingTreeNode>): List<JsObjectHandle> {
+        // There is no bridge cost to save, objects are defined one by one, and the defined
+        // ones are removed if a later one fails
+        val handles = ArrayList<JsObjectHandle>(nodes.size)
+        try {
+            for (node in nodes) {
+                val parent = if (node.parentIndex < 0) {
+                    JsObjectHandle.globalThis
+                } else {
+                    handles[node.parentIndex]
+                }
+                handles.add(
+                    defineBinding(name = node.name, binding = node.binding, parent = parent)
+                )
+            }
+        } catch (e: Throwable) {
+            handles.forEachIndexed { index, handle ->
+                objectBindings.remove(handle.nativeHandle)
+                val node = nodes[index]
+                if (node.parentIndex < 0) {
+                    context.deleteGlobalObject(node.name)
+                }
+            }
+            throw e
+        }
+        return handles
+    }
+
+    private fun sharedPrototype(key: String, binding: ObjectBinding): CValue<JSValue> {
+        val members = binding.prototypeMembers()
+        val shared = sharedPrototypes.firstOrNull { it.key == key }
+        if (shared != null) {
+            if (shared.members != members) {
+                qjsError("Bindings with different members can't share the prototype key '$key'.")
+            }
+            return shared.proto
+        }
+        val proto = context.defineSharedPrototype(
+            quickJsRef = ref,
+            bindingStats = bindingStats,
+            prototypeIndex = sharedPrototypes.size,
+            key = key,
+            binding = binding,
+        )
+        sharedPrototypes.add(SharedPrototype(key, members, proto))
+        return proto
+    }
+
+    internal fun isSharedBinding(handle: Long, prototypeIndex: Int): Boolean {
+        val key = objectBindings[handle]?.prototypeKey ?: return false
+        return sharedPrototypes.getOrNull(prototypeIndex)?.key == key
+    }
+
     actual fun <R> defineBinding(
         name: String,
         binding: FunctionBinding<R>
@@ -153,7 +443,9 @@ actual class QuickJs private constructor(
         ensureNotClosed()
         context.defineFunction(
             quickJsRef = ref,
+            bindingStats = bindingStats,
             parent = null,
+            parentName = null,
             parentHandle = JsObjectHandle.globalThis.nativeHandle,
             name = name,
             isAsync = false,
@@ -168,7 +460,9 @@ actual class QuickJs private constructor(
         ensureNotClosed()
         context.defineFunction(
             quickJsRef = ref,
+            bindingStats = bindingStats,
             parent = null,
+            parentName = null,
             parentHandle = JsObjectHandle.globalThis.nativeHandle,
             name = name,
             isAsync = true,
@@ -176,6 +470,33 @@ actual class QuickJs private constructor(
         globalFunctions[name] = binding
     }
 
+    @ExperimentalQuickJsApi
+    actual fun <T : Any> defineClass(
+        name: String,
+        type: KClass<T>,
+        binding: ClassBinding<T>,
+    ) {
+        ensureNotClosed()
+        if (binding.functions.any { it.isAsync }) {
+            qjsError("Async functions are not supported by the class binding '$name'.")
+        }
+        if (binding.properties.any { it.isConstant }) {
+            qjsError("Constant properties are not supported by the class binding '$name'.")
+        }
+        val proto = context.defineClass(
+            quickJsRef = ref,
+            bindingStats = bindingStats,
+            classIndex = hostClasses.size,
+            name = name,
+            binding = binding,
+        )
+        @Suppress("UNCHECKED_CAST")
+        hostClasses.add(HostClass(type, binding as ClassBinding<Any>, proto))
+        // Cached classes may be subclasses of the new class
+        hostClassIndexes.clear()
+        typeConverters.addHostClass(type)
+    }
+
     @Throws(QuickJsException::class)
     actual fun addModule(name: String, code: String) {
         ensureNotClosed()
@@ -194,8 +515,14 @@ actual class QuickJs private constructor(
         asModule: Boolean
     ): ByteArray {
         ensureNotClosed()
-        jsMutex.withLockSync {
-            return context.compile(code = code, filename = filename, asModule = asModule)
+        return tracer.trace(
+            phase = TracePhase.Compile,
+            name = filename,
+            attributes = { mapOf("asModule" to asModule, "codeLength" to code.length) },
+        ) {
+            jsMutex.withLockSync {
+                context.compile(code = code, filename = filename, asModule = asModule)
+            }
         }
     }
 
@@ -228,10 +555,45 @@ actual class QuickJs private constructor(
         }
     }
 
+    @ExperimentalQuickJsApi
+    @Throws(QuickJsException::class, CancellationException::class)
+    actual suspend inline fun <reified T> evaluateWithMemoryStats(
+        code: String,
+        filename: String,
+        asModule: Boolean
+    ): EvalMemoryResult<T> {
+        var memoryStats: EvalMemoryStats? = null
+        val value = evalInternal(
+            code = code,
+            filename = filename,
+            asModule = asModule,
+            onMemoryStats = { memoryStats = it },
+        )
+        return EvalMemoryResult(
+            value = castValueOr(value, typeOf<T>()) {
+                typeConverters.convert(
+                    source = it,
+                    sourceType = typeOfInstance(typeConverters, it),
+                    targetType = typeOf<T>()
+                )
+            },
+            memoryStats = memoryStats!!,
+        )
+    }
+
     @PublishedApi
     @Throws(QuickJsException::class, CancellationException::class)
-    internal suspend fun evalInternal(bytecode: ByteArray): Any? = evalAndAwait {
-        context.evaluate(bytecode = bytecode)
+    internal suspend fun evalInternal(bytecode: ByteArray): Any? = tracer.trace(
+        phase = TracePhase.Evaluate,
+        name = "bytecode",
+        attributes = { mapOf("bytecodeLength" to bytecode.size) },
+    ) {
+        evalAndAwait(
+            filename = "bytecode",
+            sourceHash = { SlowEvalTimer.hashSource(bytecode) },
+        ) {
+            context.evaluate(bytecode = bytecode)
+        }
     }
 
     @PublishedApi
@@ -239,16 +601,38 @@ actual class QuickJs private constructor(
     internal suspend fun evalInternal(
         code: String,
         filename: String,
-        asModule: Boolean
-    ): Any? = evalAndAwait {
-        context.evaluate(code = code, filename = filename, asModule = asModule)
+        asModule: Boolean,
+        onMemoryStats: ((EvalMemoryStats) -> Unit)? = null,
+    ): Any? = tracer.trace(
+        phase = TracePhase.Evaluate,
+        name = filename,
+        attributes = { mapOf("asModule" to asModule, "codeLength" to code.length) },
+    ) {
+        evalAndAwait(
+            filename = filename,
+            sourceHash = { SlowEvalTimer.hashSource(code) },
+            onMemoryStats = onMemoryStats,
+        ) { timeCompile ->
+            context.evaluate(
+                code = code,
+                filename = filename,
+                asModule = asModule,
+                compileNanos = if (timeCompile) evalCompileNanos.ptr else null,
+            )
+        }
     }
 
     actual fun gc() {
         ensureNotClosed()
-        jsMutex.withLockSync {
-            JS_UpdateStackTop(runtime)
-            JS_RunGC(runtime)
+        tracer.trace(
+            phase = TracePhase.Gc,
+            name = "gc",
+            attributes = { mapOf("trigger" to "explicit") },
+        ) {
+            jsMutex.withLockSync {
+                JS_UpdateStackTop(runtime)
+                gc_stats_run(nativeGcStats)
+            }
         }
     }
 
@@ -264,12 +648,29 @@ actual class QuickJs private constructor(
         modules.clear()
         managedJsValues.forEach { JS_FreeValue(context, it) }
         managedJsValues.clear()
-        // Dispose stable refs
-        objectBindings.keys.forEach { objectHandleToStableRef(it)?.dispose() }
-        objectBindings.clear()
+        templateAtoms.forEach { JS_FreeAtom(context, it) }
+        templateAtoms = emptyList()
+        // Remove the interrupt handler before freeing its hooks
+        runtime_hooks_uninstall(runtime)
+        nativeHeap.free(runtimeHooks)
+        nativeHeap.free(evalCompileNanos)
+        // Stop the timer thread
+        profiler_free(profiler)
         globalFunctions.clear()
+        hostClasses.forEach { JS_FreeValue(context, it.proto) }
+        hostClasses.clear()
+        sharedPrototypes.forEach { JS_FreeValue(context, it.proto) }
+        sharedPrototypes.clear()
+        // Finalizers of binding objects are called here
         JS_FreeContext(context)
+        // It removes the GC hook from the runtime, so it goes before the runtime
+        gc_stats_free(nativeGcStats)
         JS_FreeRuntime(runtime)
+        memoryAccounting?.let { accounting_free(it) }
+        binding_stats_free(bindingStats)
+        // Dispose stable refs that are not finalized
+        objectBindings.handles().forEach { objectHandleToStableRef(it)?.dispose() }
+        objectBindings.clear()
         ref.dispose()
     }
 
@@ -296,9 +697,11 @@ actual class QuickJs private constructor(
                 // The job is completed, see what we can do next:
                 // - Execute subsequent Promises
                 // - Cancel all jobs and fail, if rejected and JS didn't handle it
-                do {
-                    val result = executePendingJob(runtime)
-                } while (result == ExecuteJobResult.Success)
+                tracer.trace(phase = TracePhase.ExecutePendingJobs, name = "pendingJobs") {
+                    do {
+                        val result = executePendingJob(runtime)
+                    } while (result == ExecuteJobResult.Success)
+                }
             }
         }
         jobsMutex.withLockSync { asyncJobs += job }
@@ -307,36 +710,110 @@ actual class QuickJs private constructor(
         }
     }
 
+    /**
+     * @param onMemoryStats Receives the memory accounting of this evaluation.
+     * @param block Evaluate the code, the argument is whether to time the compilation.
+     */
     private suspend inline fun evalAndAwait(
-        crossinline block: () -> JsPromise
+        filename: String,
+        noinline sourceHash: () -> String,
+        noinline onMemoryStats: ((EvalMemoryStats) -> Unit)? = null,
+        crossinline block: (timeCompile: Boolean) -> JsPromise
     ): Any? {
         ensureNotClosed()
+        val accounting = memoryAccounting
+        check(onMemoryStats == null || accounting != null) {
+            "Memory accounting is not enabled for this instance."
+        }
         evalException = null
         loadModules()
+        val threshold = slowEvalThresholdMillis
+        val sink = slowEvalSink
+        val timer = if (threshold >= 0 && sink != null) {
+            SlowEvalTimer(threshold, isSlowEvalBreakdownEnabled)
+        } else {
+            null
+        }
         var resultPromise: JsPromise? = null
-        try {
-            resultPromise = jsMutex.withLock { block() }
-            awaitAsyncJobs()
-            checkException()
-            jsMutex.withLock {
-                JS_UpdateStackTop(JS_GetRuntime(context))
-                return resultPromise.result(context)
+        var slowEvaluation: SlowEvaluation? = null
+        // Owned by this evaluation, so overlapping evaluations don't share the stats
+        val evalAccounting = accounting?.let { nativeHeap.alloc<EvalAccounting>() }
+        var isAccounting = false
+        val result = try {
+            try {
+                resultPromise = jsMutex.withLock {
+                    if (evalAccounting != null) {
+                        accounting_begin_eval(accounting, evalAccounting.ptr, evalMemoryLimit)
+                        isAccounting = true
+                    }
+                    binding_stats_begin_eval(bindingStats)
+                    evalCompileNanos.value = 0
+                    block(timer?.isBreakdownEnabled == true)
+                }
+                timer?.evaluated()
+                awaitAsyncJobs()
+                timer?.awaited()
+                checkException()
+                jsMutex.withLock {
+                    JS_UpdateStackTop(JS_GetRuntime(context))
+                    resultPromise.result(context)
+                }
+            } finally {
+                jsMutex.withLock {
+                    resultPromise?.free(context)
+                    if (!isClosed) {
+                        if (evalAccounting != null && isAccounting) {
+                            accounting_end_eval(accounting, evalAccounting.ptr)
+                            isAccounting = false
+                            onMemoryStats?.invoke(evalAccounting.ptr.evalMemoryStats())
+                        }
+                        slowEvaluation = timer?.finish(
+                            filename = filename,
+                            sourceHash = sourceHash,
+                            compileNanos = { evalCompileNanos.value },
+                            bindingCalls = { bindingStats.evalBindingCalls() },
+                        )
+                    }
+                }
             }
+        } catch (e: Throwable) {
+            SlowEvalTimer.report(sink, slowEvaluation, e)
+            throw e
         } finally {
-            jsMutex.withLock { resultPromise?.free(context) }
+            if (evalAccounting != null) {
+                // Unlink it if the evaluation was cancelled before locking
+                if (isAccounting && !isClosed) {
+                    jsMutex.withLockSync { accounting_end_eval(accounting, evalAccounting.ptr) }
+                }
+                nativeHeap.free(evalAccounting)
+            }
         }
+        SlowEvalTimer.report(sink, slowEvaluation, null)
+        return result
+    }
+
+    /**
+     * Time binding calls of evaluations only when slow evaluations are reported with the
+     * breakdown.
+     */
+    private fun updateSlowEvalTracking() {
+        val isEnabled = slowEvalThresholdMillis >= 0 && slowEvalSink != null &&
+                isSlowEvalBreakdownEnabled
+        binding_stats_set_eval_tracking(bindingStats, if (isEnabled) 1 else 0)
     }
 
     private suspend fun awaitAsyncJobs() {
         jsMutex.withLock {
-            do {
-                // Execute JS Promises, putting this in while(true) is unnecessary
-                // since we have the same loop after every asyncFunction call
-                val execResult = executePendingJob(runtime)
-                if (execResult is ExecuteJobResult.Failure) {
-                    throw execResult.error
-                }
-            } while (execResult == ExecuteJobResult.Success)
+            tracer.trace(phase = TracePhase.ExecutePendingJobs, name = "pendingJobs") {
+                do {
+                    // Execute JS Promises, putting this in while(true) is unnecessary
+                    // since we have the same loop after every asyncFunction call
+                    val execResult = executePendingJob(runtime)
+                    if (execResult is ExecuteJobResult.Failure) {
+                        throw execResult.error
+                    }
+                } while (execResult == ExecuteJobResult.Success)
+            }
         }
         while (true) {
             val jobs = jobsMutex.withLock { asyncJobs.filter { it.isActive } }
@@ -349,8 +826,15 @@ actual class QuickJs private constructor(
     }
 
     private suspend fun loadModules() = jsMutex.withLock {
-        for (module in modules) {
-            context.evaluate(module).free(context)
+        if (modules.isEmpty()) return@withLock
+        tracer.trace(
+            phase = TracePhase.LoadModules,
+            name = "modules",
+            attributes = { mapOf("moduleCount" to modules.size) },
+        ) {
+            for (module in modules) {
+                context.evaluate(module).free(context)
+            }
         }
         modules.clear()
     }
@@ -366,8 +850,53 @@ actual class QuickJs private constructor(
         throw exception
     }
 
-    internal fun addManagedJsValues(vararg value: CValue<JSValue>) {
-        managedJsValues.addAll(value)
+    /**
+     * Keep the promise and its resolve/reject functions of an async call until closing.
+     */
+    internal fun addAsyncCallValues(
+        name: String,
+        promise: CValue<JSValue>,
+        resolveFunc: CValue<JSValue>,
+        rejectFunc: CValue<JSValue>,
+    ) {
+        managedJsValues.add(promise)
+        managedJsValues.add(resolveFunc)
+        managedJsValues.add(rejectFunc)
+        handleTracker.track(HandleKind.ManagedJsValue, callType = "asyncCall", binding = name)
+        handleTracker.track(
+            HandleKind.PromiseFunction,
+            callType = "asyncCall",
+            binding = name,
+            count = 2,
+        )
+    }
+
+    internal fun onBindingFinalized(handle: Long) {
+        objectBindings.remove(handle)
+        handleTracker.untrackBinding(handle)
+        objectHandleToStableRef(handle)?.dispose()
+    }
+
+    /**
+     * Called before and after a GC triggered by the allocation threshold.
+     *
+     * This runs inside an engine allocation, so tracer failures are dropped instead of
+     * being thrown through the engine.
+     */
+    internal fun onThresholdGc(isEnd: Boolean) {
+        val tracer = this.tracer
+        if (tracer === QuickJsTracer.NoOp) return
+        try {
+            if (!isEnd) {
+                val attributes = mapOf("trigger" to "threshold")
+                thresholdGcToken = tracer.begin(TracePhase.Gc, "gc", attributes)
+            } else {
+                tracer.end(TracePhase.Gc, thresholdGcToken, null)
+            }
+        } catch (e: Throwable) {
+            // Ignored
+        }
+        if (isEnd) thresholdGcToken = null
     }
 
     internal fun onCallBindingGetter(
@@ -375,7 +904,13 @@ actual class QuickJs private constructor(
         name: String,
     ): Any? {
         val binding = objectBindings[parentHandle] ?: qjsError("Parent not found.")
-        return binding.getter(name)
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "getter") },
+        ) {
+            binding.getter(name)
+        }
     }
 
     internal fun onCallBindingSetter(
@@ -384,15 +919,25 @@ actual class QuickJs private constructor(
         value: Any?
     ) {
         val binding = objectBindings[parentHandle] ?: qjsError("Parent not found.")
-        binding.setter(name, value)
+        tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "setter") },
+        ) {
+            binding.setter(name, value)
+        }
     }
 
     internal fun onCallBindingFunction(
         parentHandle: Long,
         name: String,
         args: Array<Any?>,
-    ): Any? {
-        return if (parentHandle == JsObjectHandle.globalThis.nativeHandle) {
+    ): Any? = tracer.trace(
+        phase = TracePhase.BindingCall,
+        name = name,
+        attributes = { mapOf("callType" to "function", "argCount" to args.size) },
+    ) {
+        if (parentHandle == JsObjectHandle.globalThis.nativeHandle) {
             val binding = globalFunctions[name] ?: qjsError("Global function '$name' not found.")
             when (binding) {
                 is AsyncFunctionBinding<*> -> invokeAsyncFunction(args) { binding.invoke(it) }
@@ -405,6 +950,74 @@ actual class QuickJs private constructor(
         }
     }
 
+    /**
+     * Create a host instance if the value is an object of defined classes, otherwise, null is
+     * returned.
+     */
+    internal fun newHostInstance(value: Any): CValue<JSValue>? {
+        if (hostClasses.isEmpty()) return null
+        val classIndex = hostClassIndexes.getOrPut(value::class) {
+            hostClasses.indexOfFirst { it.type.isInstance(value) }
+        }
+        if (classIndex < 0) return null
+        return context.newHostInstance(
+            proto = hostClasses[classIndex].proto,
+            classIndex = classIndex,
+            value = value,
+        )
+    }
+
+    internal fun onCallClassGetter(
+        classIndex: Int,
+        instance: Any,
+        name: String,
+    ): Any? {
+        val binding = classBinding(classIndex)
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "getter") },
+        ) {
+            binding.getter(instance, name)
+        }
+    }
+
+    internal fun onCallClassSetter(
+        classIndex: Int,
+        instance: Any,
+        name: String,
+        value: Any?,
+    ) {
+        val binding = classBinding(classIndex)
+        tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "setter") },
+        ) {
+            binding.setter(instance, name, value)
+        }
+    }
+
+    internal fun onCallClassFunction(
+        classIndex: Int,
+        instance: Any,
+        name: String,
+        args: Array<Any?>,
+    ): Any? {
+        val binding = classBinding(classIndex)
+        return tracer.trace(
+            phase = TracePhase.BindingCall,
+            name = name,
+            attributes = { mapOf("callType" to "function", "argCount" to args.size) },
+        ) {
+            binding.invoke(instance, name, args)
+        }
+    }
+
+    private fun classBinding(classIndex: Int): ClassBinding<Any> {
+        return hostClasses.getOrNull(classIndex)?.binding ?: qjsError("Class not found.")
+    }
+
     internal fun setUnhandledPromiseRejection(reason: Any?) {
         ensureNotClosed()
         if (evalException == null) {
@@ -418,5 +1031,51 @@ actual class QuickJs private constructor(
         actual fun create(jobDispatcher: CoroutineDispatcher): QuickJs {
             return QuickJs(jobDispatcher = jobDispatcher)
         }
+
+        @ExperimentalQuickJsApi
+        @Throws(QuickJsException::class)
+        actual fun create(
+            jobDispatcher: CoroutineDispatcher,
+            atomTemplate: AtomTemplate?,
+            enableMemoryAccounting: Boolean,
+        ): QuickJs {
+            return QuickJs(
+                jobDispatcher = jobDispatcher,
+                atomNames = atomTemplate?.names,
+                isMemoryAccountingEnabled = enableMemoryAccounting,
+            )
+        }
+    }
+}
+
+@OptIn(ExperimentalForeignApi::class)
+private class HostClass(
+    val type: KClass<*>,
+    val binding: ClassBinding<Any>,
+    val proto: CValue<JSValue>,
+)
+
+/**
+ * @param members Members of the first binding, later bindings with the key must match.
+ */
+@OptIn(ExperimentalForeignApi::class)
+private class SharedPrototype(
+    val key: String,
+    val members: Set<String>,
+    val proto: CValue<JSValue>,
+)
+
+/**
+ * Members defined on a shared prototype, constants are left out since they are defined on
+ * each object.
+ */
+private fun ObjectBinding.prototypeMembers(): Set<String> = buildSet {
+    for (prop in properties) {
+        if (!prop.isConstant) {
+            add("property ${prop.name} ${prop.configurable} ${prop.writable} ${prop.enumerable}")
+        }
+    }
+    for (func in functions) {
+        add("function ${func.name} ${func.isAsync}")
     }
-}
\ No newline at end of file
+}
@@ -11,15 +11,18 @@ import kotlinx.cinterop.ptr
 import kotlinx.cinterop.readValue
 import kotlinx.cinterop.toCPointer
 import kotlinx.cinterop.value
+import platform.posix.int32_tVar
 import platform.posix.int64_tVar
 import quickjs.JSContext
 import quickjs.JSValue
+import quickjs.JS_ToInt32
 import quickjs.JS_ToInt64
 
 internal data class BindingFunctionData(
     val name: String,
     val quickJs: QuickJs,
     val objectHandle: Long,
+    val statsSlot: Int,
 ) {
     companion object {
         @OptIn(ExperimentalForeignApi::class)
@@ -41,10 +44,15 @@ internal data class BindingFunctionData(
             val objectHandle = alloc<int64_tVar>()
             JS_ToInt64(ctx, objectHandle.ptr, data[2].readValue())
 
+            // Read the stats slot
+            val statsSlot = alloc<int32_tVar>()
+            JS_ToInt32(ctx, statsSlot.ptr, data[3].readValue())
+
             BindingFunctionData(
                 name = name,
                 quickJs = quickJs,
                 objectHandle = objectHandle.value,
+                statsSlot = statsSlot.value,
             )
         }
     }
@@ -0,0 +1,32 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.qjsError
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.ExperimentalForeignApi
+import quickjs.JSAtom
+import quickjs.JSContext
+import quickjs.JS_FreeAtom
+import quickjs.JS_GetRuntime
+import quickjs.JS_NewAtom
+import quickjs.JS_ReserveAtoms
+
+/**
+ * Intern names as atoms, the atom hash is sized for all names first so it doesn't grow while
+ * interning. The returned atoms must be freed before freeing the context.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<JSContext>.internAtoms(names: Array<String>): List<JSAtom> {
+    if (JS_ReserveAtoms(JS_GetRuntime(this), names.size) != 0) {
+        qjsError("Failed to reserve atoms.")
+    }
+    val atoms = ArrayList<JSAtom>(names.size)
+    for (name in names) {
+        val atom = JS_NewAtom(this, name)
+        if (atom == 0u) {
+            atoms.forEach { JS_FreeAtom(this, it) }
+            qjsError("Failed to intern atom '$name'.")
+        }
+        atoms.add(atom)
+    }
+    return atoms
+}
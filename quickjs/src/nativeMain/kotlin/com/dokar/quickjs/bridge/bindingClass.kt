@@ -0,0 +1,92 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.QuickJs
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.CValue
+import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.StableRef
+import kotlinx.cinterop.alloc
+import kotlinx.cinterop.asStableRef
+import kotlinx.cinterop.cstr
+import kotlinx.cinterop.memScoped
+import kotlinx.cinterop.ptr
+import kotlinx.cinterop.staticCFunction
+import kotlinx.cinterop.toLong
+import kotlinx.cinterop.value
+import quickjs.JSClassDef
+import quickjs.JSClassIDVar
+import quickjs.JSContext
+import quickjs.JSRuntime
+import quickjs.JSValue
+import quickjs.JS_GetOpaque
+import quickjs.JS_GetRuntimeOpaque
+import quickjs.JS_NewClass
+import quickjs.JS_NewClassID
+import quickjs.JS_NewObject
+import quickjs.JS_SetClassProto
+import quickjs.JS_SetRuntimeOpaque
+
+/**
+ * The class id of binding objects, class ids are shared by all runtimes.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal val bindingClassId: UInt = memScoped {
+    val id = alloc<JSClassIDVar>()
+    id.value = 0u
+    JS_NewClassID(id.ptr)
+}
+
+/**
+ * The class id of host instances, every class defined by 'defineClass()' has its own prototype
+ * but shares this class id.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal val hostInstanceClassId: UInt = memScoped {
+    val id = alloc<JSClassIDVar>()
+    id.value = 0u
+    JS_NewClassID(id.ptr)
+}
+
+/**
+ * Register the class of binding objects. The opaque of a binding object is its handle, the
+ * handle will be released when the object is garbage-collected.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun registerBindingClass(
+    quickJs: StableRef<QuickJs>,
+    runtime: CPointer<JSRuntime>,
+    context: CPointer<JSContext>,
+) = memScoped {
+    JS_SetRuntimeOpaque(runtime, quickJs.asCPointer())
+    val classDef = alloc<JSClassDef>()
+    classDef.class_name = "QuickJsBinding".cstr.ptr
+    classDef.finalizer = staticCFunction(::finalizeBindingObject)
+    classDef.gc_mark = null
+    classDef.call = null
+    classDef.exotic = null
+    JS_NewClass(runtime, bindingClassId, classDef.ptr)
+    // Keep Object.prototype for binding objects
+    JS_SetClassProto(context, bindingClassId, JS_NewObject(context))
+
+    // Host instances are created with the prototype of their classes
+    val hostClassDef = alloc<JSClassDef>()
+    hostClassDef.class_name = "QuickJsHostInstance".cstr.ptr
+    hostClassDef.finalizer = staticCFunction(::finalizeHostInstance)
+    hostClassDef.gc_mark = null
+    hostClassDef.call = null
+    hostClassDef.exotic = null
+    JS_NewClass(runtime, hostInstanceClassId, hostClassDef.ptr)
+}
+
+@OptIn(ExperimentalForeignApi::class)
+private fun finalizeBindingObject(runtime: CPointer<JSRuntime>?, value: CValue<JSValue>) {
+    val handle = JS_GetOpaque(value, bindingClassId)?.toLong() ?: return
+    val quickJs = JS_GetRuntimeOpaque(runtime)?.asStableRef<QuickJs>()?.get() ?: return
+    quickJs.onBindingFinalized(handle)
+}
+
+@OptIn(ExperimentalForeignApi::class)
+@Suppress("unused_parameter")
+private fun finalizeHostInstance(runtime: CPointer<JSRuntime>?, value: CValue<JSValue>) {
+    JS_GetOpaque(value, hostInstanceClassId)?.asStableRef<HostInstance>()?.dispose()
+}
@@ -0,0 +1,118 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.BindingCallStats
+import com.dokar.quickjs.BindingCallType
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.SlowEvalTimer
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.addressOf
+import kotlinx.cinterop.toKString
+import kotlinx.cinterop.usePinned
+import quickjs.BindingStats
+import quickjs.binding_stats_eval_snapshot
+import quickjs.binding_stats_is_timing
+import quickjs.binding_stats_record
+import quickjs.binding_stats_register
+import quickjs.binding_stats_slot_count
+import quickjs.binding_stats_slot_name
+import quickjs.binding_stats_snapshot
+import quickjs.qjs_now_ns
+
+/**
+ * Register a binding member, the slot is stored in the function data of the member.
+ *
+ * @param objectName The name of the parent object, null for global functions.
+ */
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+internal fun CPointer<BindingStats>.registerSlot(
+    objectName: String?,
+    name: String,
+    callType: BindingCallType,
+): Int {
+    val fullName = if (objectName != null) "$objectName.$name" else name
+    return binding_stats_register(this, fullName, callType.ordinal)
+}
+
+/**
+ * Start timing a call if stats or the evaluation tracking are enabled, otherwise return null.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<BindingStats>.startCallTiming(
+    slot: Int,
+    phase: Int = CallTiming.PHASE_ARGS,
+): CallTiming? {
+    if (binding_stats_is_timing(this) == 0) return null
+    return CallTiming(stats = this, slot = slot, phase = phase)
+}
+
+/**
+ * Measure phases of a binding call: argument conversion, host execution and result conversion.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal class CallTiming(
+    private val stats: CPointer<BindingStats>,
+    private val slot: Int,
+    private var phase: Int,
+) {
+    private val durations = LongArray(3)
+
+    private var start = qjs_now_ns()
+
+    /**
+     * End the current phase and start the next one.
+     */
+    fun next() {
+        val now = qjs_now_ns()
+        durations[phase] += now - start
+        start = now
+        if (phase < PHASE_RESULT) phase++
+    }
+
+    /**
+     * End the current phase and record the call.
+     */
+    fun finish(isError: Boolean) {
+        durations[phase] += qjs_now_ns() - start
+        binding_stats_record(
+            stats,
+            slot,
+            durations[PHASE_ARGS],
+            durations[PHASE_HOST],
+            durations[PHASE_RESULT],
+            if (isError) 1 else 0,
+        )
+    }
+
+    companion object {
+        const val PHASE_ARGS = 0
+        const val PHASE_HOST = 1
+        const val PHASE_RESULT = 2
+    }
+}
+
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+internal fun CPointer<BindingStats>.snapshot(): List<BindingCallStats> {
+    val count = binding_stats_slot_count(this)
+    val names = Array(count) { binding_stats_slot_name(this, it)?.toKString() ?: "" }
+    val data = LongArray(count * BindingCallStats.SLOT_SIZE)
+    if (data.isNotEmpty()) {
+        data.usePinned { binding_stats_snapshot(this, it.addressOf(0), count) }
+    }
+    return BindingCallStats.fromSnapshot(names = names, data = data)
+}
+
+/**
+ * Get the slot names and the bindings called in the current evaluation.
+ */
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+internal fun CPointer<BindingStats>.evalBindingCalls(): Pair<Array<String>, LongArray> {
+    val count = binding_stats_slot_count(this)
+    val names = Array(count) { binding_stats_slot_name(this, it)?.toKString() ?: "" }
+    val data = LongArray(count * SlowEvalTimer.BINDING_ENTRY_SIZE)
+    if (data.isEmpty()) {
+        return names to data
+    }
+    val copied = data.usePinned { binding_stats_eval_snapshot(this, it.addressOf(0), count) }
+    return names to data.copyOf(copied * SlowEvalTimer.BINDING_ENTRY_SIZE)
+}
@@ -0,0 +1,387 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.BindingCallType
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import com.dokar.quickjs.binding.ClassBinding
+import com.dokar.quickjs.binding.JsProperty
+import com.dokar.quickjs.util.allocArrayOf
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.CValue
+import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.StableRef
+import kotlinx.cinterop.asStableRef
+import kotlinx.cinterop.cstr
+import kotlinx.cinterop.get
+import kotlinx.cinterop.memScoped
+import kotlinx.cinterop.readValue
+import kotlinx.cinterop.staticCFunction
+import kotlinx.cinterop.toLong
+import quickjs.BindingStats
+import quickjs.JSCFunctionEnum
+import quickjs.JSContext
+import quickjs.JSValue
+import quickjs.JS_DefinePropertyGetSet
+import quickjs.JS_DefinePropertyValue
+import quickjs.JS_DefinePropertyValueStr
+import quickjs.JS_FreeAtom
+import quickjs.JS_FreeValue
+import quickjs.JS_GetGlobalObject
+import quickjs.JS_GetOpaque
+import quickjs.JS_NewAtom
+import quickjs.JS_NewCFunction2
+import quickjs.JS_NewCFunctionData
+import quickjs.JS_NewInt32
+import quickjs.JS_NewInt64
+import quickjs.JS_NewObject
+import quickjs.JS_NewObjectProtoClass
+import quickjs.JS_NewString
+import quickjs.JS_PROP_CONFIGURABLE
+import quickjs.JS_PROP_ENUMERABLE
+import quickjs.JS_PROP_WRITABLE
+import quickjs.JS_SetConstructor
+import quickjs.JS_SetOpaque
+import quickjs.JS_Throw
+import quickjs.JS_ThrowTypeError
+import quickjs.JsException
+import quickjs.JsUndefined
+
+/**
+ * The opaque of a host instance, disposed by the class finalizer.
+ */
+internal class HostInstance(
+    val classIndex: Int,
+    val instance: Any,
+)
+
+/**
+ * Define the class on 'globalThis' and return its prototype, which is owned by the caller.
+ *
+ * The function data of class members is [name, QuickJs ptr, class index, stats slot], the
+ * class index takes the place of the object handle.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<JSContext>.defineClass(
+    quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
+    classIndex: Int,
+    name: String,
+    binding: ClassBinding<*>,
+): CValue<JSValue> {
+    val proto = JS_NewObject(this)
+
+    for (prop in binding.properties) {
+        defineClassAccessor(
+            quickJsRef = quickJsRef,
+            bindingStats = bindingStats,
+            proto = proto,
+            classIndex = classIndex,
+            className = name,
+            property = prop,
+        )
+    }
+
+    for (func in binding.functions) {
+        defineClassFunction(
+            quickJsRef = quickJsRef,
+            bindingStats = bindingStats,
+            proto = proto,
+            classIndex = classIndex,
+            className = name,
+            name = func.name,
+        )
+    }
+
+    // The constructor can't be called, it's for 'instanceof' checks and the prototype
+    val constructor = JS_NewCFunction2(
+        ctx = this,
+        func = staticCFunction(::illegalConstructor),
+        name = name,
+        length = 0,
+        cproto = JSCFunctionEnum.JS_CFUNC_constructor,
+        magic = 0,
+    )
+    JS_SetConstructor(this, constructor, proto)
+    val globalThis = JS_GetGlobalObject(this)
+    JS_DefinePropertyValueStr(
+        this,
+        globalThis,
+        name,
+        constructor,
+        JS_PROP_CONFIGURABLE or JS_PROP_WRITABLE,
+    )
+    JS_FreeValue(this, globalThis)
+
+    return proto
+}
+
+/**
+ * Create a host instance of the class, the instance only holds a stable ref of the host object.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<JSContext>.newHostInstance(
+    proto: CValue<JSValue>,
+    classIndex: Int,
+    value: Any,
+): CValue<JSValue> {
+    val instance = JS_NewObjectProtoClass(this, proto, hostInstanceClassId)
+    val ref = StableRef.create(HostInstance(classIndex = classIndex, instance = value))
+    JS_SetOpaque(instance, ref.asCPointer())
+    return instance
+}
+
+/**
+ * Get the host object if the value is a host instance, otherwise, null is returned.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CValue<JSValue>.toHostInstance(): HostInstance? {
+    return JS_GetOpaque(this, hostInstanceClassId)?.asStableRef<HostInstance>()?.get()
+}
+
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+private fun CPointer<JSContext>.defineClassAccessor(
+    quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
+    proto: CValue<JSValue>,
+    classIndex: Int,
+    className: String,
+    property: JsProperty,
+) = memScoped {
+    val context = this@defineClassAccessor
+
+    val funcDataArray = arrayOf(
+        JS_NewString(context, property.name.cstr),
+        JS_NewInt64(context, quickJsRef.asCPointer().toLong()),
+        JS_NewInt64(context, classIndex.toLong()),
+        JS_NewInt32(
+            context,
+            bindingStats.registerSlot(className, property.name, BindingCallType.Getter),
+        ),
+    )
+
+    val getter = JS_NewCFunctionData(
+        ctx = context,
+        func = staticCFunction(::invokeClassGetter),
+        length = 0,
+        magic = 0,
+        data_len = funcDataArray.size,
+        data = allocArrayOf<JSValue>(*funcDataArray),
+    )
+
+    val setter = if (property.writable) {
+        funcDataArray[3] = JS_NewInt32(
+            context,
+            bindingStats.registerSlot(className, property.name, BindingCallType.Setter),
+        )
+        JS_NewCFunctionData(
+            ctx = context,
+            func = staticCFunction(::invokeClassSetter),
+            length = 0,
+            magic = 0,
+            data_len = funcDataArray.size,
+            data = allocArrayOf<JSValue>(*funcDataArray),
+        )
+    } else {
+        JsUndefined()
+    }
+
+    var flags = JS_PROP_CONFIGURABLE or JS_PROP_ENUMERABLE
+    if (!property.configurable) {
+        flags = flags and JS_PROP_CONFIGURABLE.inv()
+    }
+    if (!property.enumerable) {
+        flags = flags and JS_PROP_ENUMERABLE.inv()
+    }
+
+    val prop = JS_NewAtom(context, property.name)
+    JS_DefinePropertyGetSet(
+        ctx = context,
+        this_obj = proto,
+        prop = prop,
+        getter = getter,
+        setter = setter,
+        flags = flags,
+    )
+    JS_FreeAtom(context, prop)
+    // Function data are duplicated by the functions
+    JS_FreeValue(context, funcDataArray[0])
+}
+
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+private fun CPointer<JSContext>.defineClassFunction(
+    quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
+    proto: CValue<JSValue>,
+    classIndex: Int,
+    className: String,
+    name: String,
+) = memScoped {
+    val context = this@defineClassFunction
+
+    val funcDataArray = arrayOf(
+        JS_NewString(context, name.cstr),
+        JS_NewInt64(context, quickJsRef.asCPointer().toLong()),
+        JS_NewInt64(context, classIndex.toLong()),
+        JS_NewInt32(
+            context,
+            bindingStats.registerSlot(className, name, BindingCallType.Function),
+        ),
+    )
+
+    val function = JS_NewCFunctionData(
+        ctx = context,
+        func = staticCFunction(::invokeClassFunction),
+        length = 0,
+        magic = 0,
+        data_len = funcDataArray.size,
+        data = allocArrayOf<JSValue>(*funcDataArray),
+    )
+    // Function data are duplicated by the function
+    JS_FreeValue(context, funcDataArray[0])
+
+    val prop = JS_NewAtom(context, name)
+    JS_DefinePropertyValue(
+        ctx = context,
+        this_obj = proto,
+        prop = prop,
+        `val` = function,
+        flags = JS_PROP_CONFIGURABLE or JS_PROP_WRITABLE,
+    )
+    JS_FreeAtom(context, prop)
+}
+
+/**
+ * Get the host instance of 'this', null if the receiver is not an instance of the class.
+ */
+@OptIn(ExperimentalForeignApi::class)
+private fun CValue<JSValue>.hostInstanceOf(classIndex: Long): HostInstance? {
+    val host = toHostInstance() ?: return null
+    return if (host.classIndex.toLong() == classIndex) host else null
+}
+
+@OptIn(ExperimentalForeignApi::class)
+@Suppress("unused_parameter")
+private fun illegalConstructor(
+    ctx: CPointer<JSContext>?,
+    thisVal: CValue<JSValue>,
+    argc: Int,
+    argv: CPointer<JSValue>?,
+): CValue<JSValue> {
+    ctx ?: return JsException()
+    return JS_ThrowTypeError(ctx, "Illegal constructor")
+}
+
+@OptIn(ExperimentalForeignApi::class)
+@Suppress("unused_parameter")
+private fun invokeClassGetter(
+    ctx: CPointer<JSContext>?,
+    thisVal: CValue<JSValue>,
+    argc: Int,
+    argv: CPointer<JSValue>?,
+    magic: Int,
+    funcData: CPointer<JSValue>?,
+): CValue<JSValue> = memScoped {
+    ctx ?: return@memScoped JsException()
+    funcData ?: return@memScoped JsException()
+
+    val (propName, quickJs, classIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val host = thisVal.hostInstanceOf(classIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
+
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot, CallTiming.PHASE_HOST)
+    try {
+        val result = quickJs.onCallClassGetter(
+            classIndex = host.classIndex,
+            instance = host.instance,
+            name = propName,
+        )
+        timing?.next()
+        result.toJsValue(context = ctx).also { timing?.finish(isError = false) }
+    } catch (e: Throwable) {
+        timing?.finish(isError = true)
+        JS_Throw(ctx, ktErrorToJsError(ctx, e))
+        JsException()
+    }
+}
+
+@OptIn(ExperimentalForeignApi::class)
+@Suppress("unused_parameter")
+private fun invokeClassSetter(
+    ctx: CPointer<JSContext>?,
+    thisVal: CValue<JSValue>,
+    argc: Int,
+    argv: CPointer<JSValue>?,
+    magic: Int,
+    funcData: CPointer<JSValue>?,
+): CValue<JSValue> = memScoped {
+    ctx ?: return@memScoped JsException()
+    funcData ?: return@memScoped JsException()
+
+    if (argc <= 0) {
+        return@memScoped JsException()
+    }
+
+    val (propName, quickJs, classIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val host = thisVal.hostInstanceOf(classIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
+
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot)
+    try {
+        val value = argv!![0].readValue().toKtValue(ctx)
+        timing?.next()
+        quickJs.onCallClassSetter(
+            classIndex = host.classIndex,
+            instance = host.instance,
+            name = propName,
+            value = value,
+        )
+        timing?.finish(isError = false)
+        JsUndefined()
+    } catch (e: Throwable) {
+        timing?.finish(isError = true)
+        JS_Throw(ctx, ktErrorToJsError(ctx, e))
+        JsException()
+    }
+}
+
+@OptIn(ExperimentalForeignApi::class)
+@Suppress("unused_parameter")
+private fun invokeClassFunction(
+    ctx: CPointer<JSContext>?,
+    thisVal: CValue<JSValue>,
+    argc: Int,
+    argv: CPointer<JSValue>?,
+    magic: Int,
+    funcData: CPointer<JSValue>?,
+): CValue<JSValue> = memScoped {
+    ctx ?: return@memScoped JsException()
+    funcData ?: return@memScoped JsException()
+
+    val (funcName, quickJs, classIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val host = thisVal.hostInstanceOf(classIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
+
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot)
+    try {
+        val invokeArgs = Array(argc) { argv!![it].readValue().toKtValue(ctx) }
+        timing?.next()
+        val result = quickJs.onCallClassFunction(
+            classIndex = host.classIndex,
+            instance = host.instance,
+            name = funcName,
+            args = invokeArgs,
+        )
+        timing?.next()
+        result.toJsValue(context = ctx).also { timing?.finish(isError = false) }
+    } catch (e: Throwable) {
+        timing?.finish(isError = true)
+        JS_Throw(ctx, ktErrorToJsError(ctx, e))
+        JsException()
+    }
+}
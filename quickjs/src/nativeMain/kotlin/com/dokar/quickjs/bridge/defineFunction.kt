@@ -1,5 +1,7 @@
 package com.dokar.quickjs.bridge
 
+import com.dokar.quickjs.BindingCallType
+import com.dokar.quickjs.ExperimentalQuickJsApi
 import com.dokar.quickjs.QuickJs
 import com.dokar.quickjs.util.allocArrayOf
 import kotlinx.cinterop.CPointer
@@ -13,6 +15,7 @@ import kotlinx.cinterop.memScoped
 import kotlinx.cinterop.readValue
 import kotlinx.cinterop.staticCFunction
 import kotlinx.cinterop.toLong
+import quickjs.BindingStats
 import quickjs.JSContext
 import quickjs.JSValue
 import quickjs.JS_DefinePropertyValue
@@ -22,35 +25,42 @@ import quickjs.JS_FreeValue
 import quickjs.JS_GetGlobalObject
 import quickjs.JS_NewAtom
 import quickjs.JS_NewCFunctionData
+import quickjs.JS_NewInt32
 import quickjs.JS_NewInt64
 import quickjs.JS_NewPromiseCapability
 import quickjs.JS_NewString
 import quickjs.JS_PROP_CONFIGURABLE
 import quickjs.JS_Throw
+import quickjs.JS_ThrowTypeError
 import quickjs.JsException
 
-@OptIn(ExperimentalForeignApi::class)
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
 internal fun CPointer<JSContext>.defineFunction(
     quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
     parentHandle: Long,
     parent: CValue<JSValue>?,
+    parentName: String?,
     name: String,
     isAsync: Boolean,
+    magic: Int = 0,
 ): Unit = memScoped {
     val context = this@defineFunction
 
-    val quickJs = quickJsRef.get()
     val qjsVoidPtr = quickJsRef.asCPointer()
     val qjsPtrAddress = qjsVoidPtr.toLong()
 
-    val funcDataArray = arrayOf(
+    val callType = if (isAsync) BindingCallType.AsyncFunction else BindingCallType.Function
+    val statsSlot = bindingStats.registerSlot(parentName, name, callType)
+
+    val commonFuncData = arrayOf(
         JS_NewString(context, name.cstr),
         JS_NewInt64(context, qjsPtrAddress),
         JS_NewInt64(context, parentHandle),
+        JS_NewInt32(context, statsSlot),
     )
-
-    // Free function data when closing
-    quickJs.addManagedJsValues(*funcDataArray)
+    // Functions of binding objects keep their parents alive
+    val funcDataArray = if (parent != null) commonFuncData + parent else commonFuncData
 
     val cFunc = if (isAsync) {
         staticCFunction(::invokeAsyncFunction)
@@ -62,10 +72,12 @@ internal fun CPointer<JSContext>.defineFunction(
         ctx = context,
         func = cFunc,
         length = 0,
-        magic = 0,
-        data_len = 3,
+        magic = magic,
+        data_len = funcDataArray.size,
         data = allocArrayOf<JSValue>(*funcDataArray),
     )
+    // Function data are duplicated by the function
+    JS_FreeValue(context, funcDataArray[0])
 
     val prop = JS_NewAtom(context, name)
 
@@ -105,18 +117,25 @@ private fun invokeFunction(
     ctx ?: return@memScoped JsException()
     funcData ?: return@memScoped JsException()
 
-    val (funcName, quickJs, objectHandle) = BindingFunctionData.fromJsValues(ctx, funcData)
+    val (funcName, quickJs, handleOrIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val objectHandle = quickJs.bindingHandleOfCall(thisVal, magic, handleOrIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
 
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot)
     try {
         val invokeArgs = Array(argc) { argv!![it].readValue().toKtValue(ctx) }
-        quickJs
-            .onCallBindingFunction(
-                name = funcName,
-                parentHandle = objectHandle,
-                args = invokeArgs
-            )
-            .toJsValue(context = ctx)
+        timing?.next()
+        val result = quickJs.onCallBindingFunction(
+            name = funcName,
+            parentHandle = objectHandle,
+            args = invokeArgs
+        )
+        timing?.next()
+        result.toJsValue(context = ctx).also { timing?.finish(isError = false) }
     } catch (e: Throwable) {
+        timing?.finish(isError = true)
         JS_Throw(ctx, ktErrorToJsError(ctx, e))
         JsException()
     }
@@ -135,7 +154,11 @@ private fun invokeAsyncFunction(
     ctx ?: return@memScoped JsException()
     funcData ?: return@memScoped JsException()
 
-    val (funcName, quickJs, objectHandle) = BindingFunctionData.fromJsValues(ctx, funcData)
+    val (funcName, quickJs, handleOrIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val objectHandle = quickJs.bindingHandleOfCall(thisVal, magic, handleOrIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
 
     val functions = allocArray<JSValue>(2)
     val promise = JS_NewPromiseCapability(ctx, functions)
@@ -144,24 +167,28 @@ private fun invokeAsyncFunction(
     val rejectFunc = functions[1].readValue()
 
     // Free these functions when closing
-    quickJs.addManagedJsValues(resolveFunc, rejectFunc, promise)
+    quickJs.addAsyncCallValues(funcName, promise, resolveFunc, rejectFunc)
 
     val args: Array<Any?> = Array(2 + argc) { null }
     args[0] = resolveFunc
     args[1] = rejectFunc
 
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot)
     try {
         val invokeArgs = Array(argc) { argv!![it].readValue().toKtValue(ctx) }
         for (i in invokeArgs.indices) {
             args[i + 2] = invokeArgs[i]
         }
-        // Invoke binding
+        timing?.next()
+        // Invoke binding, the host launches the call and returns
         quickJs.onCallBindingFunction(
             name = funcName,
             parentHandle = objectHandle,
             args = args
         )
+        timing?.finish(isError = false)
     } catch (e: Throwable) {
+        timing?.finish(isError = true)
         JS_Throw(ctx, ktErrorToJsError(ctx, e))
         return@memScoped JsException()
     }
@@ -1,5 +1,7 @@
 package com.dokar.quickjs.bridge
 
+import com.dokar.quickjs.BindingCallType
+import com.dokar.quickjs.ExperimentalQuickJsApi
 import com.dokar.quickjs.QuickJs
 import com.dokar.quickjs.binding.JsProperty
 import com.dokar.quickjs.binding.ObjectBinding
@@ -17,44 +19,170 @@ import kotlinx.cinterop.staticCFunction
 import kotlinx.cinterop.toCPointer
 import kotlinx.cinterop.toLong
 import platform.posix.int64_tVar
+import quickjs.BindingStats
 import quickjs.JSContext
 import quickjs.JSValue
 import quickjs.JS_DefinePropertyGetSet
 import quickjs.JS_DefinePropertyValueStr
+import quickjs.JS_DeleteProperty
 import quickjs.JS_FreeAtom
 import quickjs.JS_FreeValue
 import quickjs.JS_GetGlobalObject
+import quickjs.JS_GetOpaque
 import quickjs.JS_NewAtom
 import quickjs.JS_NewCFunctionData
+import quickjs.JS_NewInt32
 import quickjs.JS_NewInt64
 import quickjs.JS_NewObject
+import quickjs.JS_NewObjectClass
+import quickjs.JS_NewObjectProtoClass
 import quickjs.JS_NewString
 import quickjs.JS_PROP_CONFIGURABLE
 import quickjs.JS_PROP_C_W_E
 import quickjs.JS_PROP_ENUMERABLE
 import quickjs.JS_PROP_WRITABLE
+import quickjs.JS_SetOpaque
 import quickjs.JS_Throw
+import quickjs.JS_ThrowTypeError
 import quickjs.JsException
 import quickjs.JsUndefined
 
+/**
+ * The magic of members defined on shared prototypes, they resolve the binding from 'this'.
+ */
+internal const val SHARED_MEMBER_MAGIC = 1
+
+/**
+ * Define a binding object, members are defined on the object if the shared [prototype] is
+ * null.
+ */
 @OptIn(ExperimentalForeignApi::class)
 internal fun CPointer<JSContext>.defineObject(
     quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
     parentHandle: Long?,
     name: String,
-    binding: ObjectBinding
+    binding: ObjectBinding,
+    prototype: CValue<JSValue>? = null,
 ): Long {
-    val instance = JS_NewObject(this)
+    val instance = if (prototype != null) {
+        JS_NewObjectProtoClass(this, prototype, bindingClassId)
+    } else {
+        JS_NewObjectClass(this, bindingClassId.toInt())
+    }
 
     val handle = jsValueToObjectHandle(instance)
+    // The handle will be disposed by the class finalizer
+    JS_SetOpaque(instance, handle.toCPointer<int64_tVar>())
+
+    if (prototype == null) {
+        defineMembers(
+            quickJsRef = quickJsRef,
+            bindingStats = bindingStats,
+            target = instance,
+            name = name,
+            handle = handle,
+            binding = binding,
+            magic = 0,
+        )
+    }
+    // Constants hold values of this object, they are never shared
+    try {
+        defineConstants(instance, binding.properties)
+    } catch (e: Throwable) {
+        JS_FreeValue(this, instance)
+        throw e
+    }
+
+    val parent = parentHandle?.let { objectHandleToStableRef(it) }?.get()
+    if (parent == null) {
+        val globalThis = JS_GetGlobalObject(this)
+        JS_DefinePropertyValueStr(this, globalThis, name, instance, JS_PROP_C_W_E)
+        JS_FreeValue(this, globalThis)
+    } else {
+        JS_DefinePropertyValueStr(this, parent, name, instance, JS_PROP_C_W_E)
+    }
+
+    return handle
+}
+
+/**
+ * Delete an object defined on 'globalThis', it's used to roll back a failed binding tree.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<JSContext>.deleteGlobalObject(name: String) {
+    val globalThis = JS_GetGlobalObject(this)
+    val prop = JS_NewAtom(this, name)
+    JS_DeleteProperty(this, globalThis, prop, 0)
+    JS_FreeAtom(this, prop)
+    JS_FreeValue(this, globalThis)
+}
+
+/**
+ * Define the prototype shared by bindings with the [key], the function data of the members
+ * holds the [prototypeIndex] instead of an object handle. The prototype is owned by the caller.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<JSContext>.defineSharedPrototype(
+    quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
+    prototypeIndex: Int,
+    key: String,
+    binding: ObjectBinding,
+): CValue<JSValue> {
+    val prototype = JS_NewObject(this)
+    defineMembers(
+        quickJsRef = quickJsRef,
+        bindingStats = bindingStats,
+        target = prototype,
+        name = key,
+        handle = prototypeIndex.toLong(),
+        binding = binding,
+        magic = SHARED_MEMBER_MAGIC,
+    )
+    return prototype
+}
 
+/**
+ * Get the object handle of a member call, members of shared prototypes resolve it from 'this'.
+ * Null is returned if 'this' is not a binding object of the prototype.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun QuickJs.bindingHandleOfCall(
+    thisVal: CValue<JSValue>,
+    magic: Int,
+    handleOrPrototypeIndex: Long,
+): Long? {
+    if (magic != SHARED_MEMBER_MAGIC) {
+        return handleOrPrototypeIndex
+    }
+    val handle = JS_GetOpaque(thisVal, bindingClassId)?.toLong() ?: return null
+    return if (isSharedBinding(handle, handleOrPrototypeIndex.toInt())) handle else null
+}
+
+@OptIn(ExperimentalForeignApi::class)
+private fun CPointer<JSContext>.defineMembers(
+    quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
+    target: CValue<JSValue>,
+    name: String,
+    handle: Long,
+    binding: ObjectBinding,
+    magic: Int,
+) {
     val properties = binding.properties
     for (prop in properties) {
+        if (prop.isConstant) {
+            continue
+        }
         defineProperty(
             quickJsRef = quickJsRef,
-            instance = instance,
+            bindingStats = bindingStats,
+            instance = target,
+            objectName = name,
             handle = handle,
             property = prop,
+            magic = magic,
         )
     }
 
@@ -62,63 +190,90 @@ internal fun CPointer<JSContext>.defineObject(
     for (func in functions) {
         defineFunction(
             quickJsRef = quickJsRef,
-            parent = instance,
+            bindingStats = bindingStats,
+            parent = target,
+            parentName = name,
             parentHandle = handle,
             name = func.name,
             isAsync = func.isAsync,
+            magic = magic,
         )
     }
+}
 
-    val parent = parentHandle?.let { objectHandleToStableRef(it) }?.get()
-    if (parent == null) {
-        val globalThis = JS_GetGlobalObject(this)
-        JS_DefinePropertyValueStr(this, globalThis, name, instance, JS_PROP_C_W_E)
-        JS_FreeValue(this, globalThis)
-    } else {
-        JS_DefinePropertyValueStr(this, parent, name, instance, JS_PROP_C_W_E)
+/**
+ * Define constant properties as plain data properties, their values are converted once so
+ * reads never call the binding.
+ */
+@OptIn(ExperimentalForeignApi::class)
+private fun CPointer<JSContext>.defineConstants(
+    instance: CValue<JSValue>,
+    properties: List<JsProperty>,
+) {
+    for (prop in properties) {
+        if (!prop.isConstant) {
+            continue
+        }
+        var flags = JS_PROP_C_W_E
+        if (!prop.configurable) {
+            flags = flags and JS_PROP_CONFIGURABLE.inv()
+        }
+        if (!prop.writable) {
+            flags = flags and JS_PROP_WRITABLE.inv()
+        }
+        if (!prop.enumerable) {
+            flags = flags and JS_PROP_ENUMERABLE.inv()
+        }
+        JS_DefinePropertyValueStr(this, instance, prop.name, prop.value.toJsValue(this), flags)
     }
-
-    return handle
 }
 
-@OptIn(ExperimentalForeignApi::class)
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
 internal fun CPointer<JSContext>.defineProperty(
     quickJsRef: StableRef<QuickJs>,
+    bindingStats: CPointer<BindingStats>,
     instance: CValue<JSValue>,
+    objectName: String,
     handle: Long,
     property: JsProperty,
+    magic: Int = 0,
 ) = memScoped {
     val context = this@defineProperty
 
-    val quickJs = quickJsRef.get()
     val qjsVoidPtr = quickJsRef.asCPointer()
     val qjsPtrAddress = qjsVoidPtr.toLong()
 
+    val getterSlot = bindingStats.registerSlot(objectName, property.name, BindingCallType.Getter)
+
+    // Accessors keep the instance alive
     val funcDataArray = arrayOf(
         JS_NewString(context, property.name.cstr),
         JS_NewInt64(context, qjsPtrAddress),
         JS_NewInt64(context, handle),
+        JS_NewInt32(context, getterSlot),
+        instance,
     )
 
-    // Free function data when closing
-    quickJs.addManagedJsValues(*funcDataArray)
-
     val getter = JS_NewCFunctionData(
         ctx = context,
         func = staticCFunction(::invokeGetter),
         length = 0,
-        magic = 0,
-        data_len = 3,
+        magic = magic,
+        data_len = funcDataArray.size,
         data = allocArrayOf<JSValue>(*funcDataArray),
     )
 
     val setter = if (property.writable) {
+        funcDataArray[3] = JS_NewInt32(
+            context,
+            bindingStats.registerSlot(objectName, property.name, BindingCallType.Setter),
+        )
         JS_NewCFunctionData(
             ctx = context,
             func = staticCFunction(::invokeSetter),
             length = 0,
-            magic = 0,
-            data_len = 3,
+            magic = magic,
+            data_len = funcDataArray.size,
             data = allocArrayOf<JSValue>(*funcDataArray),
         )
     } else {
@@ -146,6 +301,8 @@ internal fun CPointer<JSContext>.defineProperty(
         flags = flags,
     )
     JS_FreeAtom(context, prop)
+    // Function data are duplicated by the functions
+    JS_FreeValue(context, funcDataArray[0])
 }
 
 @OptIn(ExperimentalForeignApi::class)
@@ -161,13 +318,19 @@ private fun invokeGetter(
     ctx ?: return@memScoped JsException()
     funcData ?: return@memScoped JsException()
 
-    val (propName, quickJs, objectHandle) = BindingFunctionData.fromJsValues(ctx, funcData)
+    val (propName, quickJs, handleOrIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val objectHandle = quickJs.bindingHandleOfCall(thisVal, magic, handleOrIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
 
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot, CallTiming.PHASE_HOST)
     try {
-        quickJs
-            .onCallBindingGetter(parentHandle = objectHandle, name = propName)
-            .toJsValue(context = ctx)
+        val result = quickJs.onCallBindingGetter(parentHandle = objectHandle, name = propName)
+        timing?.next()
+        result.toJsValue(context = ctx).also { timing?.finish(isError = false) }
     } catch (e: Throwable) {
+        timing?.finish(isError = true)
         JS_Throw(ctx, ktErrorToJsError(ctx, e))
         JsException()
     }
@@ -190,18 +353,27 @@ private fun invokeSetter(
         return@memScoped JsException()
     }
 
-    val (propName, quickJs, objectHandle) = BindingFunctionData.fromJsValues(ctx, funcData)
+    val (propName, quickJs, handleOrIndex, statsSlot) =
+        BindingFunctionData.fromJsValues(ctx, funcData)
+
+    val objectHandle = quickJs.bindingHandleOfCall(thisVal, magic, handleOrIndex)
+        ?: return@memScoped JS_ThrowTypeError(ctx, "Illegal invocation")
+
+    val timing = quickJs.bindingStats.startCallTiming(statsSlot)
 
     val value = argv!![0].readValue().toKtValue(ctx)
 
     try {
+        timing?.next()
         quickJs.onCallBindingSetter(
             parentHandle = objectHandle,
             name = propName,
             value = value,
         )
+        timing?.finish(isError = false)
         JsUndefined()
     } catch (e: Throwable) {
+        timing?.finish(isError = true)
         JS_Throw(ctx, ktErrorToJsError(ctx, e))
         JsException()
     }
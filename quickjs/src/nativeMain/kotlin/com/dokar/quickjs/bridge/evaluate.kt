@@ -6,6 +6,7 @@ import kotlinx.cinterop.CPointer
 import kotlinx.cinterop.CValue
 import kotlinx.cinterop.CValues
 import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.LongVar
 import kotlinx.cinterop.UByteVar
 import kotlinx.cinterop.cstr
 import kotlinx.cinterop.memScoped
@@ -27,6 +28,7 @@ import quickjs.JS_TAG_FUNCTION_BYTECODE
 import quickjs.JS_TAG_MODULE
 import quickjs.JS_UpdateStackTop
 import quickjs.JsValueGetNormTag
+import quickjs.timed_eval
 
 @OptIn(ExperimentalForeignApi::class)
 @Throws(QuickJsException::class)
@@ -64,6 +66,7 @@ internal fun CPointer<JSContext>.evaluate(
     code: String,
     filename: String,
     asModule: Boolean,
+    compileNanos: CPointer<LongVar>? = null,
 ): JsPromise {
     val context = this@evaluate
     var evalFlags = JS_EVAL_FLAG_ASYNC
@@ -72,12 +75,13 @@ internal fun CPointer<JSContext>.evaluate(
     }
     val cStr = code.cstr
     JS_UpdateStackTop(JS_GetRuntime(context))
-    val result = JS_Eval(
-        ctx = this,
-        input = cStr,
-        input_len = (cStr.size - 1).toULong(),
+    val result = timed_eval(
+        context = this,
+        code = cStr,
+        len = (cStr.size - 1).toULong(),
         filename = filename.cstr,
         eval_flags = evalFlags,
+        compile_ns = compileNanos,
     )
     return handleEvalResult(context, result)
 }
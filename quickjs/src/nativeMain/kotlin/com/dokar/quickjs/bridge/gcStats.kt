@@ -0,0 +1,41 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.GcStats
+import com.dokar.quickjs.QuickJs
+import kotlinx.cinterop.COpaquePointer
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.StableRef
+import kotlinx.cinterop.addressOf
+import kotlinx.cinterop.asStableRef
+import kotlinx.cinterop.staticCFunction
+import kotlinx.cinterop.usePinned
+import quickjs.GcStats as NativeGcStats
+import quickjs.gc_stats_set_listener
+import quickjs.gc_stats_snapshot
+
+@OptIn(ExperimentalForeignApi::class)
+private fun thresholdGcListener(opaque: COpaquePointer?, isEnd: Int) {
+    val quickJs = opaque!!.asStableRef<QuickJs>()
+    quickJs.get().onThresholdGc(isEnd = isEnd != 0)
+}
+
+/**
+ * Report threshold GCs to the instance, so they can be traced.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun CPointer<NativeGcStats>.setThresholdGcListener(quickJs: StableRef<QuickJs>) {
+    gc_stats_set_listener(
+        this,
+        staticCFunction(::thresholdGcListener),
+        quickJs.asCPointer(),
+    )
+}
+
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+internal fun CPointer<NativeGcStats>.snapshotGcStats(): GcStats {
+    val data = LongArray(GcStats.SIZE)
+    data.usePinned { gc_stats_snapshot(this, it.addressOf(0)) }
+    return GcStats.fromSnapshot(data)
+}
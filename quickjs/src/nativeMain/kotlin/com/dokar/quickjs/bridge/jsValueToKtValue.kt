@@ -121,6 +121,10 @@ internal fun CValue<JSValue>.toKtValue(context: CPointer<JSContext>): Any? {
     } else if (JS_IsError(context, this) == 1) {
         return jsErrorToKtError(context, this)
     } else if (tag == JS_TAG_OBJECT) {
+        val host = toHostInstance()
+        if (host != null) {
+            return host.instance
+        }
         val globalThis = JS_GetGlobalObject(context)
         try {
             return when {
@@ -1,5 +1,6 @@
 package com.dokar.quickjs.bridge
 
+import com.dokar.quickjs.QuickJs
 import com.dokar.quickjs.binding.JsObject
 import com.dokar.quickjs.qjsError
 import com.dokar.quickjs.util.allocArrayOf
@@ -9,6 +10,7 @@ import kotlinx.cinterop.CValue
 import kotlinx.cinterop.CValues
 import kotlinx.cinterop.CValuesRef
 import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.asStableRef
 import kotlinx.cinterop.cstr
 import kotlinx.cinterop.memScoped
 import kotlinx.cinterop.reinterpret
@@ -25,6 +27,8 @@ import quickjs.JS_CallConstructor
 import quickjs.JS_FreeValue
 import quickjs.JS_GetGlobalObject
 import quickjs.JS_GetPropertyStr
+import quickjs.JS_GetRuntime
+import quickjs.JS_GetRuntimeOpaque
 import quickjs.JS_IsNull
 import quickjs.JS_IsUndefined
 import quickjs.JS_NewArray
@@ -67,10 +71,21 @@ internal fun <T : Any?> T.toJsValue(
         is Map<*, *> -> ktMapToJsMap(context, value, visited ?: mutableSetOf())
         is Iterable<*> -> ktIterableToJsArray(context, value, visited ?: mutableSetOf())
         is Throwable -> ktErrorToJsError(context, value)
-        else -> qjsError("Cannot convert kotlin type '${value::class.qualifiedName}' to a js value.")
+        else -> ktHostObjectToJsValue(context, value)
+            ?: qjsError("Cannot convert kotlin type '${value::class.qualifiedName}' to a js value.")
     }
 }
 
+@OptIn(ExperimentalForeignApi::class)
+private fun ktHostObjectToJsValue(
+    context: CPointer<JSContext>,
+    value: Any,
+): CValue<JSValue>? {
+    val runtime = JS_GetRuntime(context)
+    val quickJs = JS_GetRuntimeOpaque(runtime)?.asStableRef<QuickJs>()?.get() ?: return null
+    return quickJs.newHostInstance(value)
+}
+
 @OptIn(ExperimentalForeignApi::class, ExperimentalNativeApi::class)
 internal fun ktErrorToJsError(context: CPointer<JSContext>, error: Throwable): CValue<JSValue> {
     val jsError = JS_NewError(context)
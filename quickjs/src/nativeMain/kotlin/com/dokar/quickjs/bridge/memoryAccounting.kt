@@ -0,0 +1,49 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.EvalMemoryStats
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.CPointerVar
+import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.alloc
+import kotlinx.cinterop.memScoped
+import kotlinx.cinterop.pointed
+import kotlinx.cinterop.ptr
+import kotlinx.cinterop.value
+import quickjs.EvalAccounting
+import quickjs.JSRuntime
+import quickjs.JS_NewRuntime
+import quickjs.MemoryAccounting
+import quickjs.accounting_new_runtime
+
+@OptIn(ExperimentalForeignApi::class)
+internal class AccountedRuntime(
+    val runtime: CPointer<JSRuntime>,
+    val accounting: CPointer<MemoryAccounting>?,
+)
+
+/**
+ * Create a runtime, its allocations are recorded to a memory accounting if [accounted] is true.
+ * Accounted runtimes have a size header on each allocation.
+ */
+@OptIn(ExperimentalForeignApi::class)
+internal fun newAccountedRuntime(accounted: Boolean): AccountedRuntime? {
+    if (!accounted) {
+        val runtime = JS_NewRuntime() ?: return null
+        return AccountedRuntime(runtime = runtime, accounting = null)
+    }
+    return memScoped {
+        val accounting = alloc<CPointerVar<MemoryAccounting>>()
+        val runtime = accounting_new_runtime(accounting.ptr) ?: return null
+        AccountedRuntime(runtime = runtime, accounting = accounting.value!!)
+    }
+}
+
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+internal fun CPointer<EvalAccounting>.evalMemoryStats(): EvalMemoryStats {
+    val eval = pointed
+    return EvalMemoryStats(
+        allocatedBytes = eval.allocated_bytes.toLong(),
+        peakBytes = eval.peak_bytes.toLong(),
+    )
+}
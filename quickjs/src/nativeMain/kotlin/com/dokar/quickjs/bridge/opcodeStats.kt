@@ -0,0 +1,29 @@
+package com.dokar.quickjs.bridge
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.OpcodeStats
+import kotlinx.cinterop.CPointer
+import kotlinx.cinterop.ExperimentalForeignApi
+import kotlinx.cinterop.addressOf
+import kotlinx.cinterop.toKString
+import kotlinx.cinterop.usePinned
+import quickjs.JSRuntime
+import quickjs.opcode_stats_available
+import quickjs.opcode_stats_opcode_count
+import quickjs.opcode_stats_opcode_name
+import quickjs.opcode_stats_snapshot
+
+/**
+ * Snapshot the executed opcode counts, null if the engine is not instrumented.
+ */
+@OptIn(ExperimentalForeignApi::class, ExperimentalQuickJsApi::class)
+internal fun CPointer<JSRuntime>.snapshotOpcodeStats(): OpcodeStats? {
+    if (opcode_stats_available() == 0) {
+        return null
+    }
+    val count = opcode_stats_opcode_count()
+    val names = Array(count) { opcode_stats_opcode_name(it)?.toKString() ?: "" }
+    val data = LongArray(count)
+    data.usePinned { opcode_stats_snapshot(this, it.addressOf(0)) }
+    return OpcodeStats.fromSnapshot(names = names, data = data)
+}
@@ -0,0 +1,34 @@
+package com.dokar.quickjs.test
+
+import com.dokar.quickjs.ExperimentalQuickJsApi
+import com.dokar.quickjs.QuickJs
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+import kotlinx.coroutines.test.UnconfinedTestDispatcher
+import kotlinx.coroutines.test.runTest
+import kotlin.test.Test
+import kotlin.test.assertTrue
+
+@OptIn(ExperimentalCoroutinesApi::class, ExperimentalQuickJsApi::class)
+class CloseTest {
+    /**
+     * The GC hook is removed before the runtime is freed, run with 'QUICKJS_ASAN=true' to
+     * catch writes to freed runtimes.
+     */
+    @Test
+    fun closeWithGcStats() = runTest {
+        repeat(3) {
+            val quickJs = QuickJs.create(UnconfinedTestDispatcher())
+            quickJs.evaluate<Any?>(
+                """
+                    for (let i = 0; i < 100000; i++) {
+                        const a = {};
+                        a.self = a;
+                    }
+                """.trimIndent()
+            )
+            quickJs.gc()
+            assertTrue(quickJs.gcStats.count > 0)
+            quickJs.close()
+        }
+    }
+}
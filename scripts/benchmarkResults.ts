@@ -0,0 +1,77 @@
+import * as fs from "fs/promises";
+import * as os from "os";
+import * as path from "path";
+
+// Shared helpers of the benchmark scripts.
+
+export type BenchmarkResults = {
+  jvm: any[];
+  native: any[];
+};
+
+const resultDir = "./benchmark/build/reports/benchmarks/main";
+
+export function nativeTarget(): string {
+  const osName = os.platform();
+  if (osName === "linux") {
+    return "linuxX64";
+  } else if (osName === "win32") {
+    return "mingwX64";
+  }
+  throw new Error(`Unsupported OS: ${osName}`);
+}
+
+/**
+ * Find the latest JVM and native results in the benchmark reports.
+ */
+export async function findLatestResults(): Promise<BenchmarkResults> {
+  const dirs = (await fs.readdir(resultDir)).sort((a, b) => b.localeCompare(a));
+
+  const jvmResultFilename = "jvm.json";
+  let jvmResult: any[] | null = null;
+
+  const nativeResultFilename = `${nativeTarget()}.json`;
+  let nativeResult: any[] | null = null;
+
+  async function readResult(filePath: string): Promise<any[] | null> {
+    try {
+      return JSON.parse(await fs.readFile(filePath, "utf-8"));
+    } catch (e) {
+      return null;
+    }
+  }
+
+  for (const dir of dirs) {
+    const dirPath = path.join(resultDir, dir);
+    if (!(await fs.stat(dirPath)).isDirectory()) {
+      continue;
+    }
+
+    jvmResult ??= await readResult(path.join(dirPath, jvmResultFilename));
+    nativeResult ??= await readResult(path.join(dirPath, nativeResultFilename));
+
+    if (jvmResult != null && nativeResult != null) {
+      break;
+    }
+  }
+
+  if (jvmResult == null) {
+    throw new Error("No JVM benchmark result found.");
+  }
+  if (nativeResult == null) {
+    throw new Error("No native benchmark result found.");
+  }
+
+  return { jvm: jvmResult, native: nativeResult };
+}
+
+/**
+ * The short benchmark name, with parameters if any, e.g. 'toJsList (size=1000)'.
+ */
+export function benchmarkName(item: any): string {
+  const name = item.benchmark.split(".").pop();
+  const params = Object.entries(item.params ?? {})
+    .map(([key, value]) => `${key}=${value}`)
+    .join(", ");
+  return params.length > 0 ? `${name} (${params})` : name;
+}
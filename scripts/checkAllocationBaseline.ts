@@ -0,0 +1,106 @@
+import { $ } from "bun";
+import * as fs from "fs/promises";
+import * as os from "os";
+
+// Compare allocations per operation of AllocationBenchmark with the baseline.
+//
+// Usage: bun scripts/checkAllocationBaseline.ts [--update]
+//
+// Pass '--update' to write the current results to the baseline instead of comparing.
+// Benchmarks without a baseline fail the check, so new benchmarks must be added with '--update'.
+
+type Allocation = {
+  heapBytesPerOp: number;
+  mallocBytesPerOp: number;
+};
+
+type Baseline = Record<string, Record<string, Allocation>>;
+
+const baselinePath = "./benchmark/allocation-baseline.json";
+
+// Allowed growth before failing, results vary a little between runs
+const tolerance = 0.1;
+
+const update = process.argv.includes("--update");
+
+const osName = os.platform();
+if (osName !== "linux" && osName !== "win32") {
+  throw new Error(`Unsupported OS: ${osName}`);
+}
+
+const nativeTarget = osName === "linux" ? "linuxX64" : "mingwX64";
+
+async function runAllocationBenchmark(
+  target: string
+): Promise<Record<string, Allocation>> {
+  console.log(`Running allocation benchmarks on ${target}...`);
+  const output = await $`./gradlew :benchmark:${target}AllocationsBenchmark`;
+  const stdout = output.stdout.toString();
+  if (!stdout.includes("BUILD SUCCESSFUL")) {
+    throw new Error("Gradle task failed.");
+  }
+  const results: Record<string, Allocation> = {};
+  for (const match of stdout.matchAll(
+    /ALLOCATION benchmark=(\w+) heapBytesPerOp=(-?\d+) mallocBytesPerOp=(-?\d+)/g
+  )) {
+    // The last trial wins
+    results[match[1]] = {
+      heapBytesPerOp: Number(match[2]),
+      mallocBytesPerOp: Number(match[3]),
+    };
+  }
+  if (Object.keys(results).length === 0) {
+    throw new Error(`No allocation results on ${target}.`);
+  }
+  return results;
+}
+
+const current: Baseline = {
+  jvm: await runAllocationBenchmark("jvm"),
+  native: await runAllocationBenchmark(nativeTarget),
+};
+
+if (update) {
+  await fs.writeFile(baselinePath, JSON.stringify(current, null, 2) + "\n");
+  console.log(`Baseline updated: ${baselinePath}`);
+  process.exit(0);
+}
+
+const baseline: Baseline = JSON.parse(await fs.readFile(baselinePath, "utf-8"));
+
+const regressions: string[] = [];
+const missing: string[] = [];
+for (const [platform, results] of Object.entries(current)) {
+  for (const [name, allocation] of Object.entries(results)) {
+    const expected = baseline[platform]?.[name];
+    if (expected == null) {
+      missing.push(`${platform}.${name}`);
+      continue;
+    }
+    for (const key of ["heapBytesPerOp", "mallocBytesPerOp"] as const) {
+      const limit = expected[key] * (1 + tolerance);
+      if (expected[key] >= 0 && allocation[key] > limit) {
+        regressions.push(
+          `${platform}.${name}.${key}: ${allocation[key]} > ${expected[key]}`
+        );
+      }
+    }
+  }
+}
+
+if (missing.length > 0) {
+  console.error(
+    "Missing allocation baselines, run with '--update' to add them:\n" +
+      missing.join("\n")
+  );
+}
+
+if (regressions.length > 0) {
+  console.error("Allocation regressions:\n" + regressions.join("\n"));
+}
+
+if (missing.length > 0 || regressions.length > 0) {
+  process.exit(1);
+}
+
+console.log("No allocation regressions.");
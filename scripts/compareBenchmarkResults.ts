@@ -0,0 +1,151 @@
+import * as fs from "fs/promises";
+import * as path from "path";
+import {
+  BenchmarkResults,
+  benchmarkName,
+  findLatestResults,
+} from "./benchmarkResults";
+
+// Save benchmark results as baselines and compare the latest results with them.
+//
+// Usage:
+//   bun scripts/compareBenchmarkResults.ts save <baseline>
+//   bun scripts/compareBenchmarkResults.ts compare <baseline> [--threshold <percent>]
+//
+// Run the benchmarks first, e.g. './gradlew :benchmark:jvmBenchmark :benchmark:linuxX64Benchmark'.
+// A change is significant if the confidence intervals of the scores don't overlap, and it's a
+// regression if it's significant and worse than the threshold, which defaults to 5%.
+
+const baselineDir = "./benchmark/baselines";
+
+function usage(): never {
+  console.error(
+    "Usage: bun scripts/compareBenchmarkResults.ts " +
+      "(save <baseline> | compare <baseline> [--threshold <percent>])"
+  );
+  process.exit(2);
+}
+
+const [command, baselineName, ...options] = process.argv.slice(2);
+if (command == null || baselineName == null) {
+  usage();
+}
+
+const baselinePath = path.join(baselineDir, `${baselineName}.json`);
+
+let threshold = 5;
+const thresholdIndex = options.indexOf("--threshold");
+if (thresholdIndex >= 0) {
+  threshold = Number(options[thresholdIndex + 1]);
+  if (!Number.isFinite(threshold) || threshold < 0) {
+    usage();
+  }
+}
+
+type Score = {
+  score: number;
+  low: number;
+  high: number;
+  unit: string;
+  // Higher is better in the throughput mode, lower is better in the average time modes
+  higherIsBetter: boolean;
+};
+
+function scoreOf(item: any): Score {
+  const metric = item.primaryMetric;
+  const error = Number.isFinite(metric.scoreError) ? metric.scoreError : 0;
+  const [low, high] = metric.scoreConfidence ?? [
+    metric.score - error,
+    metric.score + error,
+  ];
+  return {
+    score: metric.score,
+    low,
+    high,
+    unit: metric.scoreUnit,
+    higherIsBetter: item.mode === "thrpt",
+  };
+}
+
+type Comparison = {
+  name: string;
+  delta: number;
+  significant: boolean;
+  regression: boolean;
+  line: string;
+};
+
+function compare(name: string, baseline: Score, current: Score): Comparison {
+  const delta = ((current.score - baseline.score) / baseline.score) * 100;
+  const improvement = baseline.higherIsBetter ? delta : -delta;
+  const significant = current.low > baseline.high || current.high < baseline.low;
+  const regression = significant && improvement < -threshold;
+  const verdict = !significant
+    ? "~"
+    : regression
+    ? "REGRESSION"
+    : improvement > threshold
+    ? "improved"
+    : "minor";
+  const sign = delta >= 0 ? "+" : "";
+  const line =
+    `${name}: ${baseline.score.toFixed(2)} -> ${current.score.toFixed(2)} ${current.unit} ` +
+    `(${sign}${delta.toFixed(1)}%, ` +
+    `baseline ±${((baseline.high - baseline.low) / 2).toFixed(2)}, ` +
+    `current ±${((current.high - current.low) / 2).toFixed(2)}) ${verdict}`;
+  return { name, delta, significant, regression, line };
+}
+
+function compareResults(baseline: any[], current: any[]): Comparison[] {
+  const baselineScores = new Map<string, Score>();
+  for (const item of baseline) {
+    baselineScores.set(benchmarkName(item), scoreOf(item));
+  }
+  const comparisons: Comparison[] = [];
+  for (const item of current) {
+    const name = benchmarkName(item);
+    const baselineScore = baselineScores.get(name);
+    if (baselineScore == null) {
+      console.log(`${name}: no baseline`);
+      continue;
+    }
+    comparisons.push(compare(name, baselineScore, scoreOf(item)));
+  }
+  return comparisons;
+}
+
+const latest = await findLatestResults();
+
+if (command === "save") {
+  await fs.mkdir(baselineDir, { recursive: true });
+  await fs.writeFile(baselinePath, JSON.stringify(latest, null, 2) + "\n");
+  console.log(`Baseline saved: ${baselinePath}`);
+  process.exit(0);
+}
+
+if (command !== "compare") {
+  usage();
+}
+
+const baseline: BenchmarkResults = JSON.parse(
+  await fs.readFile(baselinePath, "utf-8")
+);
+
+let regressionCount = 0;
+for (const platform of ["jvm", "native"] as const) {
+  console.log(`\n${platform === "jvm" ? "JVM" : "Kotlin/Native"}:`);
+  const comparisons = compareResults(baseline[platform], latest[platform]);
+  for (const comparison of comparisons) {
+    console.log(comparison.line);
+    if (comparison.regression) {
+      regressionCount++;
+    }
+  }
+}
+
+if (regressionCount > 0) {
+  console.error(`\n${regressionCount} regression(s) over ${threshold}%.`);
+  process.exit(1);
+}
+
+console.log(`\nNo regressions over ${threshold}%.`);
@@ -1,7 +1,7 @@
 import { $, ShellOutput } from "bun";
 import * as fs from "fs/promises";
 import * as os from "os";
-import * as path from "path";
+import { benchmarkName, findLatestResults } from "./benchmarkResults";
 
 type BenchmarkResult = {
   name: string;
@@ -47,45 +47,7 @@ if (osName === "linux") {
 
 console.log("Collecting results...");
 
-const resultDir = "./benchmark/build/reports/benchmarks/main";
-const dirs = (await fs.readdir(resultDir)).sort((a, b) => b.localeCompare(a));
-
-const jvmResultFilename = "jvm.json";
-let jvmResult: any | null = null;
-
-const nativeResultFilename =
-  osName === "linux" ? "linuxX64.json" : "mingwX64.json";
-let nativeResult: any | null = null;
-
-for (const dir of dirs) {
-  const dirPath = path.join(resultDir, dir);
-  if (!(await fs.stat(dirPath)).isDirectory()) {
-    continue;
-  }
-
-  const jvmResultPath = path.join(dirPath, jvmResultFilename);
-  try {
-    const jvmResultContent = await fs.readFile(jvmResultPath, "utf-8");
-    jvmResult = JSON.parse(jvmResultContent);
-  } catch (e) {}
-
-  const nativeResultPath = path.join(dirPath, nativeResultFilename);
-  try {
-    const nativeResultContent = await fs.readFile(nativeResultPath, "utf-8");
-    nativeResult = JSON.parse(nativeResultContent);
-  } catch (e) {}
-
-  if (jvmResult != null && nativeResult != null) {
-    break;
-  }
-}
-
-if (jvmResult == null) {
-  throw new Error("No JVM benchmark result found.");
-}
-if (nativeResult == null) {
-  throw new Error("No native benchmark result found.");
-}
+const { jvm: jvmResult, native: nativeResult } = await findLatestResults();
 
 // Write results to README.md
 
@@ -105,7 +67,7 @@ function benchmarkResultAsTableLines(result: any): string {
   const items: BenchmarkResult[] = [];
   for (const item of result) {
     items.push({
-      name: item.benchmark.split(".").pop(),
+      name: benchmarkName(item),
       iterations: item.measurementIterations,
       scoreUnit: item.primaryMetric.scoreUnit,
       score: item.primaryMetric.score.toFixed(2),
@@ -121,6 +83,31 @@ function benchmarkResultAsTableLines(result: any): string {
 const jvmTableLines = benchmarkResultAsTableLines(jvmResult);
 const nativeTableLines = benchmarkResultAsTableLines(nativeResult);
 
+// Scores of the same work per thread, the efficiency is relative to 1 thread
+function scalingAsTableLines(result: any): string {
+  const baselines = new Map<string, number>();
+  for (const item of result) {
+    if (item.params?.threads === "1") {
+      baselines.set(item.benchmark, item.primaryMetric.score);
+    }
+  }
+  return result
+    .filter((item: any) => item.params?.threads != null)
+    .map((item: any) => {
+      const name = item.benchmark.split(".").pop();
+      const baseline = baselines.get(item.benchmark);
+      const efficiency =
+        baseline != null && baseline > 0
+          ? `${((item.primaryMetric.score / baseline) * 100).toFixed(1)}%`
+          : "-";
+      return `| ${name} | ${item.params.threads} | ${efficiency} |`;
+    })
+    .join("\n");
+}
+
+const jvmScalingLines = scalingAsTableLines(jvmResult);
+const nativeScalingLines = scalingAsTableLines(nativeResult);
+
 const date = new Date().toLocaleString("en-US");
 
 const cpusMap = new Map<string, number>();
@@ -159,9 +146,23 @@ ${jvmTableLines}
 | --- | --- | --- | --- |
 ${nativeTableLines}
 
+### Scaling Efficiency
+
+JVM:
+
+| Name | Threads | Efficiency |
+| --- | --- | --- |
+${jvmScalingLines}
+
+Kotlin/Native:
+
+| Name | Threads | Efficiency |
+| --- | --- | --- |
+${nativeScalingLines}
+
 ### Notes
 
-The engine creation times are included in define[Xzy]Bindings benchmarks, so the actual results should be much faster, but the relative results should remain the same.
+The engine creation times are included in define[Xzy]Bindings benchmarks, so the actual results should be much faster, but the relative results should remain the same. See the output of StartupBenchmark for the time of each creation step.
 `;
 
 await fs.writeFile("./benchmark/README.md", README);
@@ -184,6 +184,26 @@ const JNI_REFS = [
         name: "setUnhandledPromiseRejection",
         sign: "(Ljava/lang/Object;)V",
       },
+      {
+        name: "onCallClassGetter",
+        sign: "(ILjava/lang/Object;Ljava/lang/String;)Ljava/lang/Object;",
+      },
+      {
+        name: "onCallClassSetter",
+        sign: "(ILjava/lang/Object;Ljava/lang/String;Ljava/lang/Object;)V",
+      },
+      {
+        name: "onCallClassFunction",
+        sign: "(ILjava/lang/Object;Ljava/lang/String;[Ljava/lang/Object;)Ljava/lang/Object;",
+      },
+      {
+        name: "onBindingFinalized",
+        sign: "(J)V",
+      },
+      {
+        name: "onThresholdGc",
+        sign: "(Z)V",
+      },
     ],
   },
   {
@@ -197,6 +217,8 @@ const JNI_REFS = [
       { name: "configurable", type: "Z" },
       { name: "writable", type: "Z" },
       { name: "enumerable", type: "Z" },
+      { name: "isConstant", type: "Z" },
+      { name: "value", type: "Ljava/lang/Object;" },
     ],
   },
   {
@@ -26,6 +26,7 @@ enableFeaturePreview("TYPESAFE_PROJECT_ACCESSORS")
 include(":quickjs")
 include(":quickjs-converter-ktxserialization")
 include(":quickjs-converter-moshi")
+include(":quickjs-binding-ksp")
 include(":samples:js-eval")
 include(":samples:repl")
 include(":samples:openai")